@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef AODV_DETECTION_LOG_H
+#define AODV_DETECTION_LOG_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/nstime.h"
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace aodv {
+
+/**
+ * \ingroup aodv
+ * \brief Kind of wormhole detection event stored in a DetectionRecord.
+ */
+enum DetectionEventType
+{
+  DETECTION_RREP_RECEIVED = 1,    //!< RREP addressed to this node (com_num.txt)
+  DETECTION_WH_ENDPOINT_RREP = 2, //!< RREP received by a wormhole end point (WH_count.txt)
+  DETECTION_CTRL_PAYLOAD = 3,     //!< Detection payload bytes of RREP/WHC/WHE (sample.txt)
+  DETECTION_MISDETECTION = 4,     //!< Wrong wormhole verdict (test.log)
+};
+
+/**
+ * \ingroup aodv
+ * \brief Where a DETECTION_MISDETECTION record was produced.
+ */
+enum DetectionMisdetectionReason
+{
+  MISDETECTION_NONE = 0,             //!< Not a misdetection record
+  MISDETECTION_WH_ENDPOINT = 1,      //!< Wormhole end point accepted its own RREP
+  MISDETECTION_RREP_NEIGHBOR = 2,    //!< Wormhole link accepted on RREP reception
+  MISDETECTION_WHE_NEIGHBOR = 3,     //!< Wormhole link accepted on WHE reception
+  MISDETECTION_TIMEOUT = 4,          //!< Normal link rejected after WHE timeout
+};
+
+/**
+ * \ingroup aodv
+ * \brief One fixed size detection trace record.
+ */
+struct DetectionRecord
+{
+  int64_t m_time;     //!< Simulation time in time steps
+  uint32_t m_node;    //!< Node ID
+  uint8_t m_type;     //!< DetectionEventType
+  uint8_t m_reason;   //!< DetectionMisdetectionReason
+  uint32_t m_value;   //!< Event value (payload bytes)
+  uint32_t m_address; //!< Related address (common neighbor), host order
+  uint64_t m_seq;     //!< Order of the record among all nodes (not written)
+};
+
+/**
+ * \ingroup aodv
+ *
+ * \brief Per-node buffer of wormhole detection events.
+ *
+ * Records are kept in memory and handed in large chunks to a single
+ * per-simulation writer, so that tracing no longer opens and closes a
+ * file for every control packet.  The buffer is flushed when it is full
+ * and when the owning routing protocol is disposed (Simulator::Destroy).
+ * A flush empties the buffers of all the nodes and writes their records
+ * in the order they were recorded, so the shared files keep the order of
+ * the former per-packet writes.
+ */
+class DetectionLog
+{
+public:
+  /// Output format of the detection trace
+  enum Format
+  {
+    NONE,   //!< Detection events are not recorded
+    LEGACY, //!< sample.txt, WH_count.txt, com_num.txt and test.log as before
+    CSV,    //!< One CSV row per record in <FileName>.csv
+    BINARY, //!< Packed little endian records in <FileName>.bin
+  };
+
+  DetectionLog ();
+  ~DetectionLog ();
+
+  /**
+   * Set the output format
+   * \param format the output format
+   */
+  void SetFormat (Format format);
+  /**
+   * \returns the output format
+   */
+  Format GetFormat () const
+  {
+    return m_format;
+  }
+  /**
+   * Set the file name prefix used by the CSV and binary formats
+   * \param name the file name prefix
+   */
+  void SetFileName (std::string name);
+  /**
+   * \returns the file name prefix
+   */
+  std::string GetFileName () const
+  {
+    return m_fileName;
+  }
+  /**
+   * Set the number of records buffered before a flush
+   * \param size the buffer capacity in records
+   */
+  void SetBufferSize (uint32_t size);
+  /**
+   * \returns the buffer capacity in records
+   */
+  uint32_t GetBufferSize () const
+  {
+    return m_bufferSize;
+  }
+  /**
+   * Set the node ID stamped on every record
+   * \param nodeId the node ID
+   */
+  void SetNodeId (uint32_t nodeId)
+  {
+    m_nodeId = nodeId;
+  }
+  /**
+   * \returns true if events are recorded
+   */
+  bool IsEnabled () const
+  {
+    return m_format != NONE;
+  }
+  /**
+   * Append one record stamped with the current simulation time
+   * \param type the event type
+   * \param value the event value
+   * \param address the related address
+   * \param reason the misdetection reason
+   */
+  void Record (DetectionEventType type, uint32_t value = 1,
+               Ipv4Address address = Ipv4Address::GetAny (),
+               DetectionMisdetectionReason reason = MISDETECTION_NONE);
+  /// Hand the buffered records of all the nodes to the writer
+  void Flush ();
+  /**
+   * \returns number of records currently buffered
+   */
+  uint32_t GetBufferedCount () const
+  {
+    return m_buffer.size ();
+  }
+
+private:
+  friend class DetectionLogWriter;
+
+  Format m_format;                       ///< output format
+  std::string m_fileName;                ///< file name prefix
+  uint32_t m_bufferSize;                 ///< buffer capacity
+  uint32_t m_nodeId;                     ///< node ID
+  std::vector<DetectionRecord> m_buffer; ///< buffered records
+};
+
+/**
+ * \ingroup aodv
+ *
+ * \brief Per-simulation writer shared by all DetectionLog instances.
+ *
+ * Files are opened once on first use, flushed after every chunk and
+ * closed when the program exits.  The writer also knows every
+ * DetectionLog, so that a flush writes the records of all the nodes in
+ * their recording order.
+ */
+class DetectionLogWriter
+{
+public:
+  /**
+   * \returns the writer instance, 0 once it was destroyed at program exit
+   */
+  static DetectionLogWriter * Get ();
+  /**
+   * Write a chunk of records
+   * \param format the output format
+   * \param fileName the file name prefix
+   * \param records the records
+   */
+  void Write (DetectionLog::Format format, const std::string &fileName,
+              const std::vector<DetectionRecord> &records);
+  /**
+   * Take the buffered records of all the logs and write them in
+   * recording order
+   */
+  void FlushAll ();
+  /**
+   * \param log a log created
+   */
+  void Register (DetectionLog *log);
+  /**
+   * \param log a log destroyed
+   */
+  void Unregister (DetectionLog *log);
+  /**
+   * \returns the order of the next record
+   */
+  uint64_t NextSequence ()
+  {
+    return m_seq++;
+  }
+  /// Flush and close all open files
+  void Close ();
+
+private:
+  DetectionLogWriter ();
+  ~DetectionLogWriter ();
+  /**
+   * Get an open stream, opening the file in append mode if needed
+   * \param name the file name
+   * \param binary open in binary mode
+   * \returns the stream
+   */
+  std::ofstream & GetStream (const std::string &name, bool binary);
+  /**
+   * Write a record in the legacy text files
+   * \param r the record
+   */
+  void WriteLegacy (const DetectionRecord &r);
+
+  std::map<std::string, std::ofstream *> m_files; ///< open files
+  std::set<DetectionLog *> m_logs;                ///< all the logs
+  uint64_t m_seq;                                 ///< order of the next record
+  static bool s_destroyed;                        ///< the writer was destroyed at exit
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_DETECTION_LOG_H */
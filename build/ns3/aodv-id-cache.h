@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 IITP RAS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Based on
+ *      NS-2 AODV model developed by the CMU/MONARCH group and optimized and
+ *      tuned by Samir Das and Mahesh Marina, University of Cincinnati;
+ *
+ *      AODV-UU implementation by Erik Nordström of Uppsala University
+ *      http://core.it.uu.se/core/index.php/AODV-UU
+ *
+ * Authors: Elena Buchatskaia <borovkovaes@iitp.ru>
+ *          Pavel Boyko <boyko@iitp.ru>
+ */
+
+#ifndef AODV_ID_CACHE_H
+#define AODV_ID_CACHE_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/simulator.h"
+#include <vector>
+#include <queue>
+#include <functional>
+#include <unordered_map>
+
+namespace ns3 {
+namespace aodv {
+/**
+ * \ingroup aodv
+ *
+ * \brief Unique packets identification cache used for simple duplicate detection.
+ *
+ * The (address, ID) pairs are hashed, and their expire times are kept in a
+ * min-heap so that Purge only visits the expired records.
+ */
+class IdCache
+{
+public:
+  /**
+   * constructor
+   * \param lifetime the lifetime for added entries
+   */
+  IdCache (Time lifetime) : m_lifetime (lifetime)
+  {
+  }
+  /**
+   * Check that entry (addr, id) exists in cache. Add entry, if it doesn't exist.
+   * \param addr the IP address
+   * \param id the cache entry ID
+   * \returns true if the pair exists
+   */ 
+  bool IsDuplicate (Ipv4Address addr, uint32_t id);
+  /// Remove all expired entries
+  void Purge ();
+  /**
+   * \returns number of entries in cache
+   */
+  uint32_t GetSize ();
+  /**
+   * Set lifetime for future added entries.
+   * \param lifetime the lifetime for entries
+   */
+  void SetLifetime (Time lifetime)
+  {
+    m_lifetime = lifetime;
+  }
+  /**
+   * Return lifetime for existing entries in cache
+   * \returns thhe lifetime
+   */
+  Time GetLifeTime () const
+  {
+    return m_lifetime;
+  }
+private:
+  /**
+   * \param addr the IP address
+   * \param id the ID
+   * \returns the key of the (addr, id) pair
+   */
+  static uint64_t GetKey (Ipv4Address addr, uint32_t id)
+  {
+    return (static_cast<uint64_t> (addr.Get ()) << 32) | id;
+  }
+  /// Already seen IDs and when they expire
+  std::unordered_map<uint64_t, Time> m_idCache;
+  /// (expire time, key) pair of the expiry heap
+  typedef std::pair<Time, uint64_t> ExpiryItem;
+  /// Min-heap of expire times, one item per record
+  std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiry;
+  /// Default lifetime for ID records
+  Time m_lifetime;
+};
+
+}  // namespace aodv
+}  // namespace ns3
+
+#endif /* AODV_ID_CACHE_H */
@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef AODV_NEIGHBOR_SET_H
+#define AODV_NEIGHBOR_SET_H
+
+#include "ns3/ipv4-address.h"
+#include <vector>
+
+namespace ns3 {
+namespace aodv {
+
+class NeighborBloomFilter;
+
+/**
+ * \ingroup aodv
+ *
+ * \brief Sorted set of neighbor addresses used by the wormhole common-neighbor check.
+ *
+ * Addresses are kept as a sorted, duplicate free array of host order
+ * integers, so that two sets are compared with a single branch free merge
+ * pass instead of a nested loop over both lists.
+ */
+class NeighborSet
+{
+public:
+  /// Empty set
+  NeighborSet ();
+  /**
+   * Build the set from a neighbor list in any order
+   * \param list the neighbor list
+   */
+  NeighborSet (const std::vector<Ipv4Address> &list);
+  /**
+   * Replace the content of the set
+   * \param list the neighbor list
+   */
+  void Assign (const std::vector<Ipv4Address> &list);
+  /**
+   * \returns the number of addresses in the set
+   */
+  uint32_t GetSize () const
+  {
+    return m_addr.size ();
+  }
+  /**
+   * \returns true if the set is empty
+   */
+  bool IsEmpty () const
+  {
+    return m_addr.empty ();
+  }
+  /**
+   * \param i index in ascending order
+   * \returns the i-th address
+   */
+  Ipv4Address Get (uint32_t i) const
+  {
+    return Ipv4Address (m_addr[i]);
+  }
+  /**
+   * \returns the addresses in ascending order
+   */
+  std::vector<Ipv4Address> GetList () const;
+  /**
+   * \param addr the address
+   * \returns true if addr is in the set
+   */
+  bool Contains (Ipv4Address addr) const;
+  /**
+   * \param other the other set
+   * \returns the number of addresses present in both sets
+   */
+  uint32_t CountCommon (const NeighborSet &other) const;
+  /**
+   * \param other the other set
+   * \returns |A ∩ B| / |A ∪ B|, 0 if both sets are empty
+   */
+  double Jaccard (const NeighborSet &other) const;
+  /**
+   * \param other the other set
+   * \returns the addresses of this set missing from other, in ascending order
+   */
+  std::vector<Ipv4Address> GetDifference (const NeighborSet &other) const;
+  /**
+   * Add and remove addresses
+   * \param added the addresses to add
+   * \param removed the addresses to remove
+   */
+  void Apply (const std::vector<Ipv4Address> &added, const std::vector<Ipv4Address> &removed);
+  /**
+   * \returns a non zero 32 bit hash of the addresses, used to refer to the
+   * set announced in a Hello instead of sending it again
+   */
+  uint32_t GetDigest () const;
+  /**
+   * Find the smallest address present in both sets
+   * \param other the other set
+   * \param match the common address, if any
+   * \returns true if a common address exists
+   */
+  bool FindFirstCommon (const NeighborSet &other, Ipv4Address &match) const
+  {
+    return FindFirstCommon (other, match, NoSkip ());
+  }
+  /**
+   * Find the smallest address present in both sets for which skip returns false
+   * \param other the other set
+   * \param match the common address, if any
+   * \param skip predicate called on each common address, true to ignore it
+   * \returns true if a common address was accepted
+   */
+  template <class Skip>
+  bool FindFirstCommon (const NeighborSet &other, Ipv4Address &match, Skip skip) const;
+  /**
+   * Find the smallest address of this set that the filter may contain and
+   * for which skip returns false
+   * \param filter Bloom filter of the other set
+   * \param match the common address, if any
+   * \param probes number of filter lookups done
+   * \param skip predicate, true to ignore an address
+   * \returns true if an address was accepted
+   */
+  template <class Skip>
+  bool FindFirstIn (const NeighborBloomFilter &filter, Ipv4Address &match, uint32_t &probes, Skip skip) const;
+
+private:
+  /// Predicate that never skips
+  struct NoSkip
+  {
+    /**
+     * \returns false
+     */
+    bool operator() (Ipv4Address) const
+    {
+      return false;
+    }
+  };
+  /// Sorted host order addresses
+  std::vector<uint32_t> m_addr;
+};
+
+/**
+ * \ingroup aodv
+ *
+ * \brief Fixed size Bloom filter of a neighbor set.
+ *
+ * Compact, approximate alternative to the full address list carried in
+ * WHE messages.  MayContain never misses a member but may report an
+ * address that was not added, with the probability given by
+ * GetFalsePositiveRate.
+ */
+class NeighborBloomFilter
+{
+public:
+  /// Default filter size in 32 bit words
+  static const uint8_t DEFAULT_WORDS = 16;
+  /// Number of hash functions
+  static const uint32_t HASHES = 4;
+
+  /**
+   * Empty filter
+   * \param words filter size in 32 bit words
+   */
+  NeighborBloomFilter (uint8_t words = DEFAULT_WORDS);
+  /**
+   * Add an address
+   * \param addr the address
+   */
+  void Add (Ipv4Address addr);
+  /**
+   * \param addr the address
+   * \returns false if addr was certainly not added
+   */
+  bool MayContain (Ipv4Address addr) const;
+  /**
+   * \param n number of added addresses
+   * \returns probability that MayContain is true for an address that was not added
+   */
+  double GetFalsePositiveRate (uint32_t n) const;
+  /**
+   * \returns the filter bits
+   */
+  const std::vector<uint32_t> & GetWords () const
+  {
+    return m_words;
+  }
+  /**
+   * \param words the filter bits
+   */
+  void SetWords (const std::vector<uint32_t> &words)
+  {
+    m_words = words;
+  }
+  /**
+   * \param o the other filter
+   * \returns true if both filters hold the same bits
+   */
+  bool operator== (NeighborBloomFilter const &o) const
+  {
+    return m_words == o.m_words;
+  }
+
+private:
+  /**
+   * \param addr the address
+   * \param k hash function index
+   * \returns bit index of addr for the k-th hash function
+   */
+  uint32_t GetBit (Ipv4Address addr, uint32_t k) const;
+  /// Filter bits
+  std::vector<uint32_t> m_words;
+};
+
+template <class Skip>
+bool
+NeighborSet::FindFirstCommon (const NeighborSet &other, Ipv4Address &match, Skip skip) const
+{
+  const uint32_t *a = m_addr.empty () ? 0 : &m_addr[0];
+  const uint32_t *b = other.m_addr.empty () ? 0 : &other.m_addr[0];
+  uint32_t na = m_addr.size ();
+  uint32_t nb = other.m_addr.size ();
+  uint32_t i = 0;
+  uint32_t j = 0;
+  while (i < na && j < nb)
+    {
+      uint32_t x = a[i];
+      uint32_t y = b[j];
+      if (x == y && !skip (Ipv4Address (x)))
+        {
+          match = Ipv4Address (x);
+          return true;
+        }
+      i += (x <= y);
+      j += (y <= x);
+    }
+  return false;
+}
+
+template <class Skip>
+bool
+NeighborSet::FindFirstIn (const NeighborBloomFilter &filter, Ipv4Address &match, uint32_t &probes, Skip skip) const
+{
+  probes = 0;
+  for (std::vector<uint32_t>::const_iterator i = m_addr.begin (); i != m_addr.end (); ++i)
+    {
+      Ipv4Address addr (*i);
+      if (skip (addr))
+        {
+          continue;
+        }
+      probes++;
+      if (filter.MayContain (addr))
+        {
+          match = addr;
+          return true;
+        }
+    }
+  return false;
+}
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_NEIGHBOR_SET_H */
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 IITP RAS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Based on
+ *      NS-2 AODV model developed by the CMU/MONARCH group and optimized and
+ *      tuned by Samir Das and Mahesh Marina, University of Cincinnati;
+ *
+ *      AODV-UU implementation by Erik Nordström of Uppsala University
+ *      http://core.it.uu.se/core/index.php/AODV-UU
+ *
+ * Authors: Elena Buchatskaia <borovkovaes@iitp.ru>
+ *          Pavel Boyko <boyko@iitp.ru>
+ */
+
+#ifndef AODVNEIGHBOR_H
+#define AODVNEIGHBOR_H
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include "ns3/simulator.h"
+#include "ns3/timer.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/callback.h"
+#include "ns3/arp-cache.h"
+#include <unordered_map>
+
+namespace ns3 {
+
+class WifiMacHeader;
+
+namespace aodv {
+
+class RoutingProtocol;
+
+/**
+ * \ingroup aodv
+ * \brief maintain list of active neighbors
+ */
+class Neighbors
+{
+public:
+  /**
+   * constructor
+   * \param delay the delay time for purging the list of neighbors
+   */
+  Neighbors (Time delay);
+  /// Neighbor description
+  struct Neighbor
+  {
+    /// Neighbor IPv4 address
+    Ipv4Address m_neighborAddress;
+    /// Neighbor MAC address
+    Mac48Address m_hardwareAddress;
+    /// Neighbor expire time
+    Time m_expireTime;
+    /// Neighbor close indicator
+    bool close;
+
+    // ★追加：Hello 由来であることを示す/Hello由来の期限
+    bool m_seenHello = false;
+    Time m_helloExpireTime = Seconds(0);
+
+    /**
+     * \brief Neighbor structure constructor
+     *
+     * \param ip Ipv4Address entry
+     * \param mac Mac48Address entry
+     * \param t Time expire time
+     */
+    Neighbor (Ipv4Address ip, Mac48Address mac, Time t)
+      : m_neighborAddress (ip),
+        m_hardwareAddress (mac),
+        m_expireTime (t),
+        close (false)
+    {
+    }
+  };
+  /**
+   * Return expire time for neighbor node with address addr, if exists, else return 0.
+   * \param addr the IP address of the neighbor node
+   * \returns the expire time for the neighbor node
+   */
+  Time GetExpireTime (Ipv4Address addr);
+  /**
+   * Check that node with address addr is neighbor
+   * \param addr the IP address to check
+   * \returns true if the node with IP address is a neighbor
+   */
+  bool IsNeighbor (Ipv4Address addr);
+
+  //隣接ノード情報を取得
+  std::vector<Ipv4Address> GetNeighborList ();
+
+  /**
+   * Hello 由来の隣接ノード一覧（アドレス昇順）。
+   * メンバーが変わった時だけ再構築されるキャッシュへの参照を返す。
+   * \returns the sorted list of neighbors heard through HELLO
+   */
+  const std::vector<Ipv4Address> & GetHelloNeighborList ();         // ★追加
+  /**
+   * \returns version of the HELLO neighbor list, incremented whenever its membership changes
+   */
+  uint32_t GetHelloNeighborVersion ();
+
+  std::vector<Ipv4Address> NeighborList ();
+
+  /**
+   * Update expire time for entry with address addr, if it exists, else add new entry
+   * \param addr the IP address to check
+   * \param expire the expire time for the address
+   */
+  void Update (Ipv4Address addr, Time expire);
+  void UpdateFromHello (Ipv4Address addr, Time helloExpire);
+  /// Remove all expired entries
+  void Purge ();
+  /// Schedule m_ntimer.
+  void ScheduleTimer ();
+  /// Remove all entries
+  void Clear ();
+
+  /**
+   * Add ARP cache to be used to allow layer 2 notifications processing
+   * \param a pointer to the ARP cache to add
+   */
+  void AddArpCache (Ptr<ArpCache> a);
+  /**
+   * Don't use given ARP cache any more (interface is down)
+   * \param a pointer to the ARP cache to delete
+   */
+  void DelArpCache (Ptr<ArpCache> a);
+  /**
+   * Get callback to ProcessTxError
+   * \returns the callback function
+   */
+  Callback<void, WifiMacHeader const &> GetTxErrorCallback () const
+  {
+    return m_txErrorCallback;
+  }
+
+  /**
+   * Set link failure callback
+   * \param cb the callback function
+   */
+  void SetCallback (Callback<void, Ipv4Address> cb)
+  {
+    m_handleLinkFailure = cb;
+  }
+  /**
+   * Get link failure callback
+   * \returns the link failure callback
+   */
+  Callback<void, Ipv4Address> GetCallback () const
+  {
+    return m_handleLinkFailure;
+  }
+
+private:
+  /// link failure callback
+  Callback<void, Ipv4Address> m_handleLinkFailure;
+  /// TX error callback
+  Callback<void, WifiMacHeader const &> m_txErrorCallback;
+  /// Timer for neighbor's list. Schedule Purge().
+  Timer m_ntimer;
+  /// vector of entries
+  std::vector<Neighbor> m_nb;
+  /// address -> position in m_nb
+  std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> m_index;
+  /// (expire time, address) pair of the expiry heap
+  typedef std::pair<Time, Ipv4Address> ExpiryItem;
+  /// Min-heap of expire times.  Extended entries leave stale items behind which are skipped on pop.
+  std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiry;
+  /// true if some entry was marked close by a TX error
+  bool m_closePending;
+  /// cached HELLO neighbor list
+  std::vector<Ipv4Address> m_helloList;
+  /// HELLO neighbor list version
+  uint32_t m_helloVersion;
+  /// false if m_helloList has to be rebuilt
+  bool m_helloListValid;
+  /// earliest HELLO expire time of the cached members
+  Time m_helloListExpire;
+
+  /**
+   * Find entry by address
+   * \param addr the IP address
+   * \returns pointer to the entry or 0
+   */
+  Neighbor * Find (Ipv4Address addr);
+  /**
+   * Add expire time of an entry to the expiry heap
+   * \param n the entry
+   */
+  void PushExpiry (const Neighbor &n);
+  /// Rebuild m_index after entries were removed
+  void RebuildIndex ();
+  /// Invalidate the cached HELLO neighbor list
+  void InvalidateHelloList ();
+  /// list of ARP cached to be used for layer 2 notifications processing
+  std::vector<Ptr<ArpCache> > m_arp;
+
+  /**
+   * Find MAC address by IP using list of ARP caches
+   * 
+   * \param addr the IP address to lookup
+   * \returns the MAC address for the IP address
+   */
+  Mac48Address LookupMacAddress (Ipv4Address addr);
+  /// Process layer 2 TX error notification
+  void ProcessTxError (WifiMacHeader const &);
+};
+
+}  // namespace aodv
+}  // namespace ns3
+
+#endif /* AODVNEIGHBOR_H */
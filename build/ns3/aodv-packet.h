@@ -0,0 +1,1118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 IITP RAS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Based on
+ *      NS-2 AODV model developed by the CMU/MONARCH group and optimized and
+ *      tuned by Samir Das and Mahesh Marina, University of Cincinnati;
+ *
+ *      AODV-UU implementation by Erik Nordström of Uppsala University
+ *      http://core.it.uu.se/core/index.php/AODV-UU
+ *
+ * Authors: Elena Buchatskaia <borovkovaes@iitp.ru>
+ *          Pavel Boyko <boyko@iitp.ru>
+ */
+#ifndef AODVPACKET_H
+#define AODVPACKET_H
+
+#include <iostream>
+#include "ns3/header.h"
+#include "ns3/enum.h"
+#include "ns3/ipv4-address.h"
+#include <map>
+#include "ns3/nstime.h"
+#include "ns3/aodv-neighbor.h"
+#include "aodv-neighbor-set.h"
+#include "ns3/string.h"
+
+namespace ns3 {
+namespace aodv {
+
+/**
+* \ingroup aodv
+* \brief MessageType enumeration
+*/
+enum MessageType {
+  AODVTYPE_RREQ = 1, //!< AODVTYPE_RREQ
+  AODVTYPE_RREP = 2, //!< AODVTYPE_RREP
+  AODVTYPE_RERR = 3, //!< AODVTYPE_RERR
+  AODVTYPE_RREP_ACK = 4, //!< AODVTYPE_RREP_ACK
+  AODVTYPE_WHC = 5, 
+  AODVTYPE_WHE = 6
+
+};
+
+/**
+* \ingroup aodv
+* \brief Wire encoding of the neighbor list carried in RREP and WHE
+*/
+enum NeighborListEncoding {
+  NEIGHBOR_LIST_RAW = 0,   //!< 4 bytes per address (original format)
+  NEIGHBOR_LIST_DELTA = 1, //!< Sorted list: first address, then varint coded differences
+  NEIGHBOR_LIST_BLOOM = 2, //!< Fixed size Bloom filter of the addresses (approximate)
+  NEIGHBOR_LIST_REF = 3,   //!< Digest of the list announced in the sender's Hellos (see NeighborDeltaHeader)
+};
+
+/**
+* \ingroup aodv
+* \brief AODV types
+*/
+class TypeHeader : public Header
+{
+public:
+  /**
+   * constructor
+   * \param t the AODV RREQ type
+   */
+  TypeHeader (MessageType t = AODVTYPE_RREQ);
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  /**
+   * \returns the type
+   */
+  MessageType
+  Get () const
+  {
+    return m_type;
+  }
+  /**
+   * Check that type if valid
+   * \returns true if the type is valid
+   */
+  bool
+  IsValid () const
+  {
+    return m_valid;
+  }
+  /**
+   * \brief Comparison operator
+   * \param o header to compare
+   * \return true if the headers are equal
+   */
+  bool operator== (TypeHeader const &o) const;
+
+private:
+  MessageType m_type; ///< type of the message
+  bool m_valid; ///< Indicates if the message is valid
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, TypeHeader const &h);
+
+/**
+* \ingroup aodv
+* \brief   Route Request (RREQ) Message Format
+  \verbatim
+  0                   1                   2                   3
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Type      |J|R|G|D|U|   Reserved          |   Hop Count   |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                            RREQ ID                            |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                    Destination IP Address                     |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                  Destination Sequence Number                  |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                    Originator IP Address                      |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                  Originator Sequence Number                   |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class RreqHeader : public Header
+{
+public:
+  /**
+   * constructor
+   *
+   * \param flags the message flags (0)
+   * \param reserved the reserved bits (0)
+   * \param hopCount the hop count
+   * \param requestID the request ID
+   * \param dst the destination IP address
+   * \param dstSeqNo the destination sequence number
+   * \param origin the origin IP address
+   * \param originSeqNo the origin sequence number
+   */
+  RreqHeader (uint8_t flags = 0, uint8_t reserved = 0, uint8_t hopCount = 0, uint32_t requestID = 0,
+              Ipv4Address dst = Ipv4Address (), uint32_t dstSeqNo = 0,
+              Ipv4Address origin = Ipv4Address (), uint32_t originSeqNo = 0);
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  // Fields
+  /**
+   * \brief Set the hop count
+   * \param count the hop count
+   */
+  void
+  SetHopCount (uint8_t count)
+  {
+    m_hopCount = count;
+  }
+  /**
+   * \brief Get the hop count
+   * \return the hop count
+   */
+  uint8_t
+  GetHopCount () const
+  {
+    return m_hopCount;
+  }
+  /**
+   * \brief Set the request ID
+   * \param id the request IDF
+   */
+  void
+  SetId (uint32_t id)
+  {
+    m_requestID = id;
+  }
+  /**
+   * \brief Get the request ID
+   * \return the request ID
+   */
+  uint32_t
+  GetId () const
+  {
+    return m_requestID;
+  }
+  /**
+   * \brief Set the destination address
+   * \param a the destination address
+   */
+  void
+  SetDst (Ipv4Address a)
+  {
+    m_dst = a;
+  }
+  /**
+   * \brief Get the destination address
+   * \return the destination address
+   */
+  Ipv4Address
+  GetDst () const
+  {
+    return m_dst;
+  }
+  /**
+   * \brief Set the destination sequence number
+   * \param s the destination sequence number
+   */
+  void
+  SetDstSeqno (uint32_t s)
+  {
+    m_dstSeqNo = s;
+  }
+  /**
+   * \brief Get the destination sequence number
+   * \return the destination sequence number
+   */
+  uint32_t
+  GetDstSeqno () const
+  {
+    return m_dstSeqNo;
+  }
+  /**
+   * \brief Set the origin address
+   * \param a the origin address
+   */
+  void
+  SetOrigin (Ipv4Address a)
+  {
+    m_origin = a;
+  }
+  /**
+   * \brief Get the origin address
+   * \return the origin address
+   */
+  Ipv4Address
+  GetOrigin () const
+  {
+    return m_origin;
+  }
+  /**
+   * \brief Set the origin sequence number
+   * \param s the origin sequence number
+   */
+  void
+  SetOriginSeqno (uint32_t s)
+  {
+    m_originSeqNo = s;
+  }
+  /**
+   * \brief Get the origin sequence number
+   * \return the origin sequence number
+   */
+  uint32_t
+  GetOriginSeqno () const
+  {
+    return m_originSeqNo;
+  }
+
+  void 
+  SetWHForwardFlag(uint8_t f) 
+  {
+    m_WHForwardFlag = f;
+  }
+
+  uint8_t
+  GetWHForwardFlag() const
+  {
+    return m_WHForwardFlag;
+  }
+
+  // Flags
+  /**
+   * \brief Set the gratuitous RREP flag
+   * \param f the gratuitous RREP flag
+   */
+  void SetGratuitousRrep (bool f);
+  /**
+   * \brief Get the gratuitous RREP flag
+   * \return the gratuitous RREP flag
+   */
+  bool GetGratuitousRrep () const;
+  /**
+   * \brief Set the Destination only flag
+   * \param f the Destination only flag
+   */
+  void SetDestinationOnly (bool f);
+  /**
+   * \brief Get the Destination only flag
+   * \return the Destination only flag
+   */
+  bool GetDestinationOnly () const;
+  /**
+   * \brief Set the unknown sequence number flag
+   * \param f the unknown sequence number flag
+   */
+  void SetUnknownSeqno (bool f);
+  /**
+   * \brief Get the unknown sequence number flag
+   * \return the unknown sequence number flag
+   */
+  bool GetUnknownSeqno () const;
+
+  /**
+   * \brief Comparison operator
+   * \param o RREQ header to compare
+   * \return true if the RREQ headers are equal
+   */
+  bool operator== (RreqHeader const &o) const;
+
+private:
+  uint8_t m_flags; ///< |J|R|G|D|U| bit flags, see RFC
+  uint8_t m_reserved; ///< Not used (must be 0)
+  uint8_t m_hopCount; ///< Hop Count
+  uint32_t m_requestID; ///< RREQ ID
+  Ipv4Address m_dst; ///< Destination IP Address
+  uint32_t m_dstSeqNo; ///< Destination Sequence Number
+  Ipv4Address m_origin; ///< Originator IP Address
+  uint32_t m_originSeqNo; ///< Source Sequence Number
+  uint8_t m_WHForwardFlag;
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, RreqHeader const &);
+
+/**
+* \ingroup aodv
+* \brief Route Reply (RREP) Message Format
+  \verbatim
+  0                   1                   2                   3
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Type      |R|A|    Reserved     |Prefix Sz|   Hop Count   |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                     Destination IP address                    |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                  Destination Sequence Number                  |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                    Originator IP address                      |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                           Lifetime                            |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                        Neighbor List                          |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class RrepHeader : public Header
+{
+public:
+  /**
+   * constructor
+   *
+   * \param prefixSize the prefix size (0)
+   * \param hopCount the hop count (0)
+   * \param dst the destination IP address
+   * \param dstSeqNo the destination sequence number
+   * \param origin the origin IP address
+   * \param lifetime the lifetime
+   * \param List 隣接ノードリスト
+   * \param size 隣接ノードリストのサイズ
+   */
+  RrepHeader (uint8_t prefixSize = 0, uint8_t hopCount = 0, Ipv4Address dst = Ipv4Address (),
+              uint32_t dstSeqNo = 0, Ipv4Address
+              origin = Ipv4Address (),
+              Time lifetime = MilliSeconds (0), 
+              std::vector<Ipv4Address> List = {}, uint16_t size = 0, uint32_t id = 0);
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  // Fields
+  /**
+   * \brief Set the hop count
+   * \param count the hop count
+   */
+  void
+  SetHopCount (uint8_t count)
+  {
+    m_hopCount = count;
+  }
+  /**
+   * \brief Get the hop count
+   * \return the hop count
+   */
+  uint8_t
+  GetHopCount () const
+  {
+    return m_hopCount;
+  }
+  /**
+   * \brief Set the destination address
+   * \param a the destination address
+   */
+  void
+  SetDst (Ipv4Address a)
+  {
+    m_dst = a;
+  }
+  /**
+   * \brief Get the destination address
+   * \return the destination address
+   */
+  Ipv4Address
+  GetDst () const
+  {
+    return m_dst;
+  }
+  /**
+   * \brief Set the destination sequence number
+   * \param s the destination sequence number
+   */
+  void
+  SetDstSeqno (uint32_t s)
+  {
+    m_dstSeqNo = s;
+  }
+  /**
+   * \brief Get the destination sequence number
+   * \return the destination sequence number
+   */
+  uint32_t
+  GetDstSeqno () const
+  {
+    return m_dstSeqNo;
+  }
+  /**
+   * \brief Set the origin address
+   * \param a the origin address
+   */
+  void
+  SetOrigin (Ipv4Address a)
+  {
+    m_origin = a;
+  }
+  /**
+   * \brief Get the origin address
+   * \return the origin address
+   */
+  Ipv4Address
+  GetOrigin () const
+  {
+    return m_origin;
+  }
+  /**
+   * \brief Set the lifetime
+   * \param t the lifetime
+   */
+  void SetLifeTime (Time t);
+  /**
+   * \brief Get the lifetime
+   * \return the lifetime
+   */
+  Time GetLifeTime () const;
+
+  std::vector<Ipv4Address>
+  GetNeighbors ();
+
+  void
+  SetNeighbors (std::vector<Ipv4Address> List)
+  {
+    m_list = List;
+  }
+
+  uint16_t Getsize()
+  {
+    return m_size;
+  }
+
+  void Setsize(uint16_t size)
+  {
+    m_size = size;
+  }
+
+  uint32_t Getid()
+  {
+    return m_id;
+  }
+
+  void Setid(uint32_t id)
+  {
+    m_id = id;
+  }
+
+  void SetNextnode(Ipv4Address n)
+  {
+    m_nextnode = n;
+  }
+
+  Ipv4Address GetNextnode() const
+  {
+    return m_nextnode;
+  }
+
+  void SetWHForwardFlag(uint8_t f)
+  {
+    m_WHForwardFlag =f;
+  }
+
+  uint8_t GetWHForwardFlag() const
+  {
+    return m_WHForwardFlag;
+  }
+
+  /**
+   * \brief Set the wire encoding of the neighbor list (reserved flag bits 0-1)
+   * \param e the encoding
+   */
+  void SetNeighborEncoding (NeighborListEncoding e);
+  /**
+   * \brief Get the wire encoding of the neighbor list
+   * \return the encoding
+   */
+  NeighborListEncoding GetNeighborEncoding () const;
+  /**
+   * \brief Set the digest sent in place of the list with NEIGHBOR_LIST_REF
+   * \param digest the NeighborSet::GetDigest of the list
+   */
+  void SetNeighborDigest (uint32_t digest)
+  {
+    m_digest = digest;
+  }
+  /**
+   * \brief Get the digest of a received NEIGHBOR_LIST_REF header
+   * \return the digest
+   */
+  uint32_t GetNeighborDigest () const
+  {
+    return m_digest;
+  }
+  /**
+   * \brief Get the Bloom filter of a received NEIGHBOR_LIST_BLOOM header
+   * \return the filter
+   */
+  const NeighborBloomFilter & GetNeighborFilter () const
+  {
+    return m_bloom;
+  }
+  /**
+   * \brief Get the number of bytes used by the neighbor list on the wire
+   * \return the encoded list size
+   */
+  uint32_t GetNeighborListSize () const;
+
+  // Flags
+  /**
+   * \brief Set the ack required flag
+   * \param f the ack required flag
+   */
+  void SetAckRequired (bool f);
+  /**
+   * \brief get the ack required flag
+   * \return the ack required flag
+   */
+  bool GetAckRequired () const;
+  /**
+   * \brief Set the prefix size
+   * \param sz the prefix size
+   */
+  void SetPrefixSize (uint8_t sz);
+  /**
+   * \brief Set the pefix size
+   * \return the prefix size
+   */
+  uint8_t GetPrefixSize () const;
+
+  /**
+   * Configure RREP to be a Hello message
+   *
+   * \param src the source IP address
+   * \param srcSeqNo the source sequence number
+   * \param lifetime the lifetime of the message
+   */
+  void SetHello (Ipv4Address src, uint32_t srcSeqNo, Time lifetime);
+
+  /**
+   * \brief Comparison operator
+   * \param o RREP header to compare
+   * \return true if the RREP headers are equal
+   */
+  bool operator== (RrepHeader const &o) const;
+
+
+
+private:
+  uint8_t m_flags; ///< A - acknowledgment required flag
+  uint8_t m_prefixSize; ///< Prefix Size
+  uint8_t m_hopCount; ///< Hop Count
+  Ipv4Address m_dst; ///< Destination IP Address
+  uint32_t m_dstSeqNo; ///< Destination Sequence Number
+  Ipv4Address m_origin; ///< Source IP Address
+  uint32_t m_lifeTime; ///< Lifetime (in milliseconds)
+  std::vector<Ipv4Address> m_list;
+  uint16_t m_size;
+  uint32_t m_id;
+  Ipv4Address m_nextnode;
+  uint8_t m_WHForwardFlag;
+  NeighborBloomFilter m_bloom; ///< Bloom filter of a received NEIGHBOR_LIST_BLOOM list
+  uint32_t m_digest; ///< Digest of the list for NEIGHBOR_LIST_REF
+
+  // uint8_t my_size;
+  // uint8_t get_size;
+
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, RrepHeader const &);
+
+/**
+* \ingroup aodv
+* \brief Route Reply Acknowledgment (RREP-ACK) Message Format
+  \verbatim
+  0                   1
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Type      |   Reserved    |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class RrepAckHeader : public Header
+{
+public:
+  /// constructor
+  RrepAckHeader ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  /**
+   * \brief Comparison operator
+   * \param o RREP header to compare
+   * \return true if the RREQ headers are equal
+   */
+  bool operator== (RrepAckHeader const &o) const;
+
+private:
+  uint8_t m_reserved; ///< Not used (must be 0)
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, RrepAckHeader const &);
+
+/**
+* \ingroup aodv
+* \brief Route Error (RERR) Message Format
+  \verbatim
+  0                   1                   2                   3
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Type      |N|          Reserved           |   DestCount   |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |            Unreachable Destination IP Address (1)             |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |         Unreachable Destination Sequence Number (1)           |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-|
+  |  Additional Unreachable Destination IP Addresses (if needed)  |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |Additional Unreachable Destination Sequence Numbers (if needed)|
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class RerrHeader : public Header
+{
+public:
+  /// constructor
+  RerrHeader ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator i) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  // No delete flag
+  /**
+   * \brief Set the no delete flag
+   * \param f the no delete flag
+   */
+  void SetNoDelete (bool f);
+  /**
+   * \brief Get the no delete flag
+   * \return the no delete flag
+   */
+  bool GetNoDelete () const;
+
+  /**
+   * \brief Add unreachable node address and its sequence number in RERR header
+   * \param dst unreachable IPv4 address
+   * \param seqNo unreachable sequence number
+   * \return false if we already added maximum possible number of unreachable destinations
+   */
+  bool AddUnDestination (Ipv4Address dst, uint32_t seqNo);
+  /**
+   * \brief Delete pair (address + sequence number) from REER header, if the number of unreachable destinations > 0
+   * \param un unreachable pair (address + sequence number)
+   * \return true on success
+   */
+  bool RemoveUnDestination (std::pair<Ipv4Address, uint32_t> &un);
+  /// Clear header
+  void Clear ();
+  /**
+   * \returns number of unreachable destinations in RERR message
+   */
+  uint8_t
+  GetDestCount () const
+  {
+    return (uint8_t) m_unreachableDstSeqNo.size ();
+  }
+
+  /**
+   * \brief Comparison operator
+   * \param o RERR header to compare
+   * \return true if the RERR headers are equal
+   */
+  bool operator== (RerrHeader const &o) const;
+
+private:
+  uint8_t m_flag; ///< No delete flag
+  uint8_t m_reserved; ///< Not used (must be 0)
+
+  /// List of Unreachable destination: IP addresses and sequence numbers
+  std::map<Ipv4Address, uint32_t> m_unreachableDstSeqNo;
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, RerrHeader const &);
+
+
+/**
+* \ingroup aodv
+* \brief Route Reply WHC Message Format
+  \verbatim
+  0                   1
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Type      |シーケンス番号 |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class WHCHeader : public Header
+{
+public:
+  /// constructor
+  WHCHeader (uint32_t id =0,
+             uint32_t seq = 0,
+             Ipv4Address origin = Ipv4Address()    
+  );
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  void Setid(uint32_t id)
+  {
+    m_id = id;
+  }
+
+  uint32_t Getid() const
+  {
+    return m_id;
+  }
+
+  void SetDstSeqno (uint32_t dst)
+  {
+    m_dstSeqNo = dst;
+  }
+
+  uint32_t
+  GetDstSeqno () const
+  {
+    return m_dstSeqNo;
+  }
+
+  void 
+  SetOrigin (Ipv4Address o)
+  {
+    m_origin = o;
+  }
+
+  Ipv4Address
+  GetOrinig() const
+  {
+    return m_origin;
+  }
+
+  /**
+   * \brief Comparison operatorSendTo
+   * \return true if the RREQ headers are equal
+   */
+  bool operator== (WHCHeader const &o) const;
+
+private:
+  uint32_t m_id;
+  uint32_t m_dstSeqNo; ///< Not used (must be 0)
+  Ipv4Address m_origin; //< RREQ送信元
+};
+
+
+/**
+* \ingroup aodv
+* \brief Route Reply WHE Message Format
+  \verbatim
+  0                   1
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Type      |      SeqNo     |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+                List
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class WHEHeader : public Header
+{
+public:
+  /// constructor
+  WHEHeader (uint32_t id = 0, Ipv4Address origin = Ipv4Address(), std::vector<Ipv4Address> List = {}, uint16_t size = 0);
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  void Setid (uint32_t id)
+  {
+    m_id = id;
+  }
+
+  uint32_t Getid ()
+  {
+    return m_id;
+  }
+
+  void SetOrigin(Ipv4Address o)
+  {
+    m_origin = o;
+  }
+
+  Ipv4Address GetOrigin() const
+  {
+    return m_origin;
+  }
+
+  std::vector<Ipv4Address>
+  GetNeighbors ()
+  {
+    return m_list;
+  }
+
+  void
+  SetNeighbors (std::vector<Ipv4Address> List)
+  {
+    m_list = List;
+  }
+
+  uint16_t GetSize ()
+  {
+    return m_size;
+  }
+
+  void SetSize (uint16_t size)
+  {
+    m_size = size;
+  }
+
+  Ipv4Address Gettarget() const 
+  {
+    return m_targetnode;
+  }
+
+  void Settarget(Ipv4Address target)
+  {
+    m_targetnode = target;
+  }
+
+  /**
+   * \brief Set the wire encoding of the neighbor list (top bits of the size field)
+   * \param e the encoding
+   */
+  void SetNeighborEncoding (NeighborListEncoding e)
+  {
+    m_encoding = e;
+  }
+  /**
+   * \brief Get the wire encoding of the neighbor list
+   * \return the encoding
+   */
+  NeighborListEncoding GetNeighborEncoding () const
+  {
+    return m_encoding;
+  }
+  /**
+   * \brief Set the digest sent in place of the list with NEIGHBOR_LIST_REF
+   * \param digest the NeighborSet::GetDigest of the list
+   */
+  void SetNeighborDigest (uint32_t digest)
+  {
+    m_digest = digest;
+  }
+  /**
+   * \brief Get the digest of a received NEIGHBOR_LIST_REF header
+   * \return the digest
+   */
+  uint32_t GetNeighborDigest () const
+  {
+    return m_digest;
+  }
+  /**
+   * \brief Get the Bloom filter of a received NEIGHBOR_LIST_BLOOM header
+   * \return the filter
+   */
+  const NeighborBloomFilter & GetNeighborFilter () const
+  {
+    return m_bloom;
+  }
+  /**
+   * \brief Get the number of bytes used by the neighbor list on the wire
+   * \return the encoded list size
+   */
+  uint32_t GetNeighborListSize () const;
+
+  /**
+   * \brief Comparison operatorSendTo
+   * \return true if the RREQ headers are equal
+   */
+  bool operator== (WHEHeader const &o) const;
+
+private:
+  uint32_t m_id; ///< Not used (must be 0)
+  Ipv4Address m_origin;
+  std::vector<Ipv4Address> m_list;
+  uint16_t m_size;
+  Ipv4Address m_targetnode;
+  NeighborListEncoding m_encoding; ///< neighbor list encoding
+  NeighborBloomFilter m_bloom; ///< Bloom filter of a received NEIGHBOR_LIST_BLOOM list
+  uint32_t m_digest; ///< Digest of the list for NEIGHBOR_LIST_REF
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, WHEHeader const &);
+
+/**
+* \ingroup aodv
+* \brief Neighbor list delta carried after the RREP header of a Hello
+*
+* Sent when the Hello header uses NEIGHBOR_LIST_REF: the header then holds
+* the digest of the sender's neighbor list, and this header the changes
+* since the list whose digest is Base.  A zero Base means that Added is the
+* whole list.  A Hello whose list did not change carries no delta.
+* Receivers keep the list of each neighbor, so that RREP and WHE only need
+* to carry the digest.
+  \verbatim
+  0                   1                   2                   3
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                          Base digest                          |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |          Added count          |         Removed count         |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Added addresses, then removed addresses (delta coded)     |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class NeighborDeltaHeader : public Header
+{
+public:
+  /**
+   * constructor
+   *
+   * \param base the digest of the list the delta applies to, 0 for a full list
+   * \param added the added addresses
+   * \param removed the removed addresses
+   */
+  NeighborDeltaHeader (uint32_t base = 0, std::vector<Ipv4Address> added = {},
+                       std::vector<Ipv4Address> removed = {});
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  /**
+   * \brief Get the digest of the list the delta applies to
+   * \return the digest, 0 for a full list
+   */
+  uint32_t GetBase () const
+  {
+    return m_base;
+  }
+  /**
+   * \brief Get the added addresses
+   * \return the addresses
+   */
+  const std::vector<Ipv4Address> & GetAdded () const
+  {
+    return m_added;
+  }
+  /**
+   * \brief Get the removed addresses
+   * \return the addresses
+   */
+  const std::vector<Ipv4Address> & GetRemoved () const
+  {
+    return m_removed;
+  }
+
+  /**
+   * \brief Comparison operator
+   * \param o header to compare
+   * \return true if the headers are equal
+   */
+  bool operator== (NeighborDeltaHeader const &o) const;
+
+private:
+  uint32_t m_base; ///< Digest of the list the delta applies to
+  std::vector<Ipv4Address> m_added; ///< Added addresses
+  std::vector<Ipv4Address> m_removed; ///< Removed addresses
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, NeighborDeltaHeader const &);
+
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODVPACKET_H */
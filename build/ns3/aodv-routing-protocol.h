@@ -0,0 +1,680 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 IITP RAS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Based on
+ *      NS-2 AODV model developed by the CMU/MONARCH group and optimized and
+ *      tuned by Samir Das and Mahesh Marina, University of Cincinnati;
+ *
+ *      AODV-UU implementation by Erik Nordström of Uppsala University
+ *      http://core.it.uu.se/core/index.php/AODV-UU
+ *
+ * Authors: Elena Buchatskaia <borovkovaes@iitp.ru>
+ *          Pavel Boyko <boyko@iitp.ru>
+ */
+#ifndef AODVROUTINGPROTOCOL_H
+#define AODVROUTINGPROTOCOL_H
+
+#include "aodv-rtable.h"
+#include "aodv-rqueue.h"
+#include "aodv-packet.h"
+#include "aodv-neighbor.h"
+#include "aodv-neighbor-set.h"
+#include "aodv-dpd.h"
+#include "aodv-detection-log.h"
+#include "ns3/node.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/stats-registry.h"
+#include "ns3/hdr-histogram.h"
+#include "ns3/traced-callback.h"
+#include <map>
+#include <unordered_map>
+
+namespace ns3 {
+namespace aodv {
+/**
+ * \ingroup aodv
+ *
+ * \brief AODV routing protocol
+ */
+class RoutingProtocol : public Ipv4RoutingProtocol
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  static const uint32_t AODV_PORT;
+
+  /// constructor
+  RoutingProtocol ();
+  virtual ~RoutingProtocol ();
+  virtual void DoDispose ();
+
+  // Inherited from Ipv4RoutingProtocol
+  Ptr<Ipv4Route> RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr);
+  bool RouteInput (Ptr<const Packet> p, const Ipv4Header &header, Ptr<const NetDevice> idev,
+                   UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                   LocalDeliverCallback lcb, ErrorCallback ecb);
+  virtual void NotifyInterfaceUp (uint32_t interface);
+  virtual void NotifyInterfaceDown (uint32_t interface);
+  virtual void NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void SetIpv4 (Ptr<Ipv4> ipv4);
+  virtual void PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
+
+  // Handle protocol parameters
+  /**
+   * Get maximum queue time
+   * \returns the maximum queue time
+   */
+  Time GetMaxQueueTime () const
+  {
+    return m_maxQueueTime;
+  }
+  /**
+   * Set the maximum queue time
+   * \param t the maximum queue time
+   */
+  void SetMaxQueueTime (Time t);
+  /**
+   * Get the maximum queue length
+   * \returns the maximum queue length
+   */
+  uint32_t GetMaxQueueLen () const
+  {
+    return m_maxQueueLen;
+  }
+  /**
+   * Set the maximum queue length
+   * \param len the maximum queue length
+   */
+  void SetMaxQueueLen (uint32_t len);
+  /**
+   * Get destination only flag
+   * \returns the destination only flag
+   */
+  bool GetDestinationOnlyFlag () const
+  {
+    return m_destinationOnly;
+  }
+  /**
+   * Set destination only flag
+   * \param f the destination only flag
+   */
+  void SetDestinationOnlyFlag (bool f)
+  {
+    m_destinationOnly = f;
+  }
+  /**
+   * Get gratuitous reply flag
+   * \returns the gratuitous reply flag
+   */
+  bool GetGratuitousReplyFlag () const
+  {
+    return m_gratuitousReply;
+  }
+  /**
+   * Set gratuitous reply flag
+   * \param f the gratuitous reply flag
+   */
+  void SetGratuitousReplyFlag (bool f)
+  {
+    m_gratuitousReply = f;
+  }
+  /**
+   * Set hello enable
+   * \param f the hello enable flag
+   */
+  void SetHelloEnable (bool f)
+  {
+    m_enableHello = f;
+  }
+  /**
+   * Get hello enable flag
+   * \returns the enable hello flag
+   */
+  bool GetHelloEnable () const
+  {
+    return m_enableHello;
+  }
+  /**
+   * Set broadcast enable flag
+   * \param f enable broadcast flag
+   */
+  void SetBroadcastEnable (bool f)
+  {
+    m_enableBroadcast = f;
+  }
+  /**
+   * Get broadcast enable flag
+   * \returns the broadcast enable flag
+   */
+  bool GetBroadcastEnable () const
+  {
+    return m_enableBroadcast;
+  }
+  /**
+   * Set detection trace format
+   * \param format the detection trace format
+   */
+  void SetDetectionTraceFormat (DetectionLog::Format format)
+  {
+    m_detectionLog.SetFormat (format);
+  }
+  /**
+   * Get detection trace format
+   * \returns the detection trace format
+   */
+  DetectionLog::Format GetDetectionTraceFormat () const
+  {
+    return m_detectionLog.GetFormat ();
+  }
+  /**
+   * Set detection trace file name prefix
+   * \param name the file name prefix
+   */
+  void SetDetectionTraceFile (std::string name)
+  {
+    m_detectionLog.SetFileName (name);
+  }
+  /**
+   * Get detection trace file name prefix
+   * \returns the file name prefix
+   */
+  std::string GetDetectionTraceFile () const
+  {
+    return m_detectionLog.GetFileName ();
+  }
+  /**
+   * Set detection trace buffer size
+   * \param size the number of records buffered per node
+   */
+  void SetDetectionTraceBufferSize (uint32_t size)
+  {
+    m_detectionLog.SetBufferSize (size);
+  }
+  /**
+   * Get detection trace buffer size
+   * \returns the number of records buffered per node
+   */
+  uint32_t GetDetectionTraceBufferSize () const
+  {
+    return m_detectionLog.GetBufferSize ();
+  }
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  struct RouteLatencyEntry
+    {
+        Time start;      // RREQ 送信時刻
+        Time established; // RREP 受信時刻
+        Time latency;     // 経路作成時間
+    };
+
+  struct WhDetectionStats
+    {
+        uint32_t detectedWh = 0;    //WH攻撃を正常に検知した回数 true positive
+        uint32_t undetectedWh = 0;  //WH攻撃を検知できなかった回数 false negative
+        uint32_t falsePositive = 0; //正常ノードをご検知した回数  false positive
+        uint32_t truenegative = 0; //正常ノードを正常ノードと判定した回数  ture negative
+
+        uint32_t notApplicable = 0;  // ★ 判定対象外（NA）
+
+        uint64_t totalAodvCtrlMessages = 0;
+        uint64_t totalAodvCtrlBytes = 0;
+
+        Time m_routetime = Seconds(0);
+
+        bool Getroute = false;
+
+        std::map<uint32_t, RouteLatencyEntry> m_latencyTable;
+
+        //転送されたhelloメッセージを受信した回数
+        uint32_t helloForwardedCount = 0;
+
+        uint32_t bloomChecks = 0; // Bloom filter 付き WHE で共通隣接を判定した回数
+        double bloomFalseMatchProbability = 0; // 各判定が誤一致である確率の合計（bloomChecks で割ると推定誤一致率）
+
+        uint64_t helloNeighborBytes = 0; // Hello に載せた隣接リストのダイジェストと差分のバイト数（totalAodvCtrlBytes の内数）
+        uint32_t neighborRefMisses = 0; // 参照された隣接リストがキャッシュになかった回数
+    };
+
+    WhDetectionStats m_whStats;
+
+    /**
+     * \returns the detection statistics of this node.  Totals over all
+     * nodes are available from StatsRegistry under the "aodv." names
+     * until Simulator::Destroy.
+     */
+    const WhDetectionStats & Getevaluation () const
+    {
+      return m_whStats;
+    }
+
+  /**
+   * TracedCallback signature for completed route discoveries.
+   *
+   * \param [in] dst the destination of the discovery
+   * \param [in] latency the time from the first RREQ to the RREP, including
+   *             the retries and the WHC/WHE verification
+   */
+  typedef void (* RouteLatencyTracedCallback)(Ipv4Address dst, Time latency);
+
+  /**
+   * \returns the route discovery latencies of this node, in microseconds
+   */
+  const HdrHistogram & GetRouteLatencyHistogram () const
+  {
+    return m_routeLatency;
+  }
+
+protected:
+  virtual void DoInitialize (void);
+private:
+  // Protocol parameters.
+  uint32_t m_rreqRetries;             ///< Maximum number of retransmissions of RREQ with TTL = NetDiameter to discover a route
+  uint16_t m_ttlStart;                ///< Initial TTL value for RREQ.
+  uint16_t m_ttlIncrement;            ///< TTL increment for each attempt using the expanding ring search for RREQ dissemination.
+  uint16_t m_ttlThreshold;            ///< Maximum TTL value for expanding ring search, TTL = NetDiameter is used beyond this value.
+  uint16_t m_timeoutBuffer;           ///< Provide a buffer for the timeout.
+  uint16_t m_rreqRateLimit;           ///< Maximum number of RREQ per second.
+  uint16_t m_rerrRateLimit;           ///< Maximum number of REER per second.
+  Time m_activeRouteTimeout;          ///< Period of time during which the route is considered to be valid.
+  uint32_t m_netDiameter;             ///< Net diameter measures the maximum possible number of hops between two nodes in the network
+  /**
+   *  NodeTraversalTime is a conservative estimate of the average one hop traversal time for packets
+   *  and should include queuing delays, interrupt processing times and transfer times.
+   */
+  Time m_nodeTraversalTime;
+  Time m_netTraversalTime;             ///< Estimate of the average net traversal time.
+  Time m_pathDiscoveryTime;            ///< Estimate of maximum time needed to find route in network.
+  Time m_myRouteTimeout;               ///< Value of lifetime field in RREP generating by this node.
+  /**
+   * Every HelloInterval the node checks whether it has sent a broadcast  within the last HelloInterval.
+   * If it has not, it MAY broadcast a  Hello message
+   */
+  Time m_helloInterval;
+  uint32_t m_allowedHelloLoss;         ///< Number of hello messages which may be loss for valid link
+  /**
+   * DeletePeriod is intended to provide an upper bound on the time for which an upstream node A
+   * can have a neighbor B as an active next hop for destination D, while B has invalidated the route to D.
+   */
+  Time m_deletePeriod;
+  Time m_nextHopWait;                  ///< Period of our waiting for the neighbour's RREP_ACK
+  Time m_blackListTimeout;             ///< Time for which the node is put into the blacklist
+  uint32_t m_maxQueueLen;              ///< The maximum number of packets that we allow a routing protocol to buffer.
+  Time m_maxQueueTime;                 ///< The maximum period of time that a routing protocol is allowed to buffer a packet for.
+  bool m_destinationOnly;              ///< Indicates only the destination may respond to this RREQ.
+  bool m_gratuitousReply;              ///< Indicates whether a gratuitous RREP should be unicast to the node originated route discovery.
+  bool m_enableHello;                  ///< Indicates whether a hello messages enable
+  bool m_enableBroadcast;              ///< Indicates whether a a broadcast data packets forwarding enable
+  //\}
+
+  /// IP protocol
+  Ptr<Ipv4> m_ipv4;
+  /// Raw unicast socket per each IP interface, map socket -> iface address (IP + mask)
+  std::map< Ptr<Socket>, Ipv4InterfaceAddress > m_socketAddresses;
+  /// Raw subnet directed broadcast socket per each IP interface, map socket -> iface address (IP + mask)
+  std::map< Ptr<Socket>, Ipv4InterfaceAddress > m_socketSubnetBroadcastAddresses;
+  /// Loopback device used to defer RREQ until packet will be fully formed
+  Ptr<NetDevice> m_lo;
+
+  /// Routing table
+  RoutingTable m_routingTable;
+  /// A "drop-front" queue used by the routing layer to buffer packets to which it does not have a route.
+  RequestQueue m_queue;
+  /// Broadcast ID
+  uint32_t m_requestId;
+  /// Request sequence number
+  uint32_t m_seqNo;
+  /// Handle duplicated RREQ
+  IdCache m_rreqIdCache;
+
+  IdCache m_WHEIdCache;
+  /// Handle duplicated broadcast/multicast packets
+  DuplicatePacketDetection m_dpd;
+  /// Handle neighbors
+  Neighbors m_nb;
+  /// Buffered wormhole detection trace
+  DetectionLog m_detectionLog;
+  /// Node slot used in StatsRegistry; it and the ids below are set in DoInitialize
+  uint32_t m_statNode;
+  uint32_t m_statTp;            ///< "aodv.wh.tp" counter id
+  uint32_t m_statFn;            ///< "aodv.wh.fn" counter id
+  uint32_t m_statFp;            ///< "aodv.wh.fp" counter id
+  uint32_t m_statTn;            ///< "aodv.wh.tn" counter id
+  uint32_t m_statCtrlMessages;  ///< "aodv.ctrl.messages" counter id
+  uint32_t m_statCtrlBytes;     ///< "aodv.ctrl.bytes" counter id
+  uint32_t m_statRouteTime;     ///< "aodv.route.time" histogram id
+  /// Start of the pending route discoveries, by destination
+  std::map<Ipv4Address, Time> m_discoveryStart;
+  /// Route discovery latencies, in microseconds
+  HdrHistogram m_routeLatency;
+  /// Fired when a route discovery completes
+  TracedCallback<Ipv4Address, Time> m_routeLatencyTrace;
+  /**
+   * Count a wormhole detection verdict in m_whStats and StatsRegistry
+   * \param field the m_whStats counter
+   * \param id the StatsRegistry counter id
+   */
+  void CountVerdict (uint32_t &field, uint32_t id);
+  /**
+   * Count a sent AODV control packet in m_whStats and StatsRegistry
+   * \param packet the packet
+   */
+  void CountControlPacket (Ptr<const Packet> packet);
+  /// Wire encoding of the neighbor lists we send
+  NeighborListEncoding m_neighborEncoding;
+  /**
+   * \returns the encoding used for RREP neighbor lists
+   */
+  NeighborListEncoding GetRrepNeighborEncoding () const
+  {
+    return m_neighborEncoding == NEIGHBOR_LIST_BLOOM ? NEIGHBOR_LIST_DELTA : GetWheNeighborEncoding ();
+  }
+  /**
+   * \returns the encoding used for WHE neighbor lists
+   */
+  NeighborListEncoding GetWheNeighborEncoding () const
+  {
+    // 参照は Hello で隣接リストを配っている場合だけ使える
+    return m_neighborEncoding == NEIGHBOR_LIST_REF && !m_enableHello ? NEIGHBOR_LIST_DELTA : m_neighborEncoding;
+  }
+  /// Send the whole neighbor list in every n-th Hello when it is referenced (NEIGHBOR_LIST_REF)
+  uint32_t m_helloFullListInterval;
+  /// Hellos sent since the last one with the whole neighbor list
+  uint32_t m_hellosSinceFullList;
+  /// Neighbor list announced in our last Hello, referenced by our RREP and WHE
+  NeighborSet m_announcedNeighbors;
+  /// Digest of m_announcedNeighbors
+  uint32_t m_announcedDigest;
+  /// Neighbor list of a neighbor, learnt from its Hellos
+  struct NeighborView
+  {
+    NeighborSet neighbors; ///< the list
+    uint32_t digest;       ///< its digest
+  };
+  /// Neighbor lists of the neighbors (2-hop neighborhood)
+  std::unordered_map<Ipv4Address, NeighborView, Ipv4AddressHash> m_neighborViews;
+  /**
+   * Make the current neighbor list the announced one
+   * \param delta the delta from the previously announced list, or the whole list
+   * \returns false if the list did not change and the whole list is not due,
+   * the Hello then carries no delta
+   */
+  bool MakeNeighborDelta (NeighborDeltaHeader &delta);
+  /**
+   * Update the list of a neighbor from its Hello
+   * \param neighbor the neighbor
+   * \param digest the digest of its new list
+   * \param delta the changes carried by the Hello
+   */
+  void ApplyNeighborDelta (Ipv4Address neighbor, uint32_t digest, NeighborDeltaHeader const &delta);
+  /**
+   * Resolve a neighbor list sent as a digest (NEIGHBOR_LIST_REF)
+   * \param neighbor the sender of the digest
+   * \param digest the digest
+   * \param neighbors the list, if known
+   * \returns true if the list is known
+   */
+  bool LookupNeighborView (Ipv4Address neighbor, uint32_t digest, NeighborSet &neighbors);
+  /// Number of RREQs used for RREQ rate control
+  uint16_t m_rreqCount;
+  /// Number of RERRs used for RERR rate control
+  uint16_t m_rerrCount;
+
+private:
+  /// Start protocol operation
+  void Start ();
+  /**
+   * Queue packet and send route request
+   *
+   * \param p the packet to route
+   * \param header the IP header
+   * \param ucb the UnicastForwardCallback function
+   * \param ecb the ErrorCallback function
+   */ 
+  void DeferredRouteOutput (Ptr<const Packet> p, const Ipv4Header & header, UnicastForwardCallback ucb, ErrorCallback ecb);
+  /**
+   * If route exists and is valid, forward packet.
+   *
+   * \param p the packet to route
+   * \param header the IP header
+   * \param ucb the UnicastForwardCallback function
+   * \param ecb the ErrorCallback function
+   * \returns true if forwarded
+   */ 
+  bool Forwarding (Ptr<const Packet> p, const Ipv4Header & header, UnicastForwardCallback ucb, ErrorCallback ecb);
+  /**
+   * Repeated attempts by a source node at route discovery for a single destination
+   * use the expanding ring search technique.
+   * \param dst the destination IP address
+   */
+  void ScheduleRreqRetry (Ipv4Address dst);
+  /**
+   * Set lifetime field in routing table entry to the maximum of existing lifetime and lt, if the entry exists
+   * \param addr - destination address
+   * \param lt - proposed time for lifetime field in routing table entry for destination with address addr.
+   * \return true if route to destination address addr exist
+   */
+  bool UpdateRouteLifeTime (Ipv4Address addr, Time lt);
+  /**
+   * Update neighbor record.
+   * \param receiver is supposed to be my interface
+   * \param sender is supposed to be IP address of my neighbor.
+   */
+  void UpdateRouteToNeighbor (Ipv4Address sender, Ipv4Address receiver);
+  /**
+   * Test whether the provided address is assigned to an interface on this node
+   * \param src the source IP address
+   * \returns true if the IP address is the node's IP address
+   */
+  bool IsMyOwnAddress (Ipv4Address src);
+  /**
+   * Find unicast socket with local interface address iface
+   *
+   * \param iface the interface
+   * \returns the socket associated with the interface
+   */
+  Ptr<Socket> FindSocketWithInterfaceAddress (Ipv4InterfaceAddress iface) const;
+  /**
+   * Find subnet directed broadcast socket with local interface address iface
+   *
+   * \param iface the interface
+   * \returns the socket associated with the interface
+   */
+  Ptr<Socket> FindSubnetBroadcastSocketWithInterfaceAddress (Ipv4InterfaceAddress iface) const;
+  /**
+   * Process hello message
+   * 
+   * \param rrepHeader RREP message header
+   * \param receiverIfaceAddr receiver interface IP address
+   */
+  void ProcessHello (RrepHeader const & rrepHeader, Ipv4Address receiverIfaceAddr);
+  /**
+   * Create loopback route for given header
+   *
+   * \param header the IP header
+   * \param oif the output interface net device
+   * \returns the route
+   */
+  Ptr<Ipv4Route> LoopbackRoute (const Ipv4Header & header, Ptr<NetDevice> oif) const;
+
+  ///\name Receive control packets
+  //\{
+  /// Receive and process control packet
+  void RecvAodv (Ptr<Socket> socket);
+  /// Receive RREQ
+  void RecvRequest (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address src);
+  /// Receive RREP
+  void RecvReply (Ptr<Packet> p, Ipv4Address my,Ipv4Address src);
+  /// Receive RREP_ACK
+  void RecvReplyAck (Ipv4Address neighbor);
+  /// Receive RERR from node with address src
+  void RecvError (Ptr<Packet> p, Ipv4Address src);
+
+  void RecvWHC(Ptr<Packet> p, Ipv4Address receiver, Ipv4Address src);
+
+  void RecvWHE(Ptr<Packet> p, Ipv4Address receiver, Ipv4Address src);
+  //\}
+
+  ///\name Send
+  //\{
+  /// Forward packet from route request queue
+  void SendPacketFromQueue (Ipv4Address dst, Ptr<Ipv4Route> route);
+  /// Send hello
+  void SendHello ();
+  /// Send RREQ
+  void SendRequest (Ipv4Address dst);
+  void SendAodvBroadcast (Ptr<Packet> packet);
+  /// Send RREP
+  void SendReply (RreqHeader const & rreqHeader, RoutingTableEntry const & toOrigin);
+  /** Send RREP by intermediate node
+   * \param toDst routing table entry to destination
+   * \param toOrigin routing table entry to originator
+   * \param gratRep indicates whether a gratuitous RREP should be unicast to destination
+   */
+  void SendReplyByIntermediateNode (RoutingTableEntry & toDst, RoutingTableEntry & toOrigin, bool gratRep, uint32_t rreqid);
+
+  void CheckResult(RrepHeader rrepHeader);
+
+  void SendWHC (RrepHeader rrepHeader);
+
+  void SendWHE (WHCHeader const & WHCHeader, RoutingTableEntry const & toNeighbor);
+
+  /// Send RREP_ACK
+  void SendReplyAck (Ipv4Address neighbor);
+  /// Initiate RERR
+  void SendRerrWhenBreaksLinkToNextHop (Ipv4Address nextHop);
+  /// Forward RERR
+  void SendRerrMessage (Ptr<Packet> packet,  std::vector<Ipv4Address> precursors);
+  /**
+   * Send RERR message when no route to forward input packet. Unicast if there is reverse route to originating node, broadcast otherwise.
+   * \param dst - destination node IP address
+   * \param dstSeqNo - destination node sequence number
+   * \param origin - originating node IP address
+   */
+  void SendRerrWhenNoRouteToForward (Ipv4Address dst, uint32_t dstSeqNo, Ipv4Address origin);
+  /// @}
+
+  /**
+   * Send packet to destination scoket
+   * \param socket - destination node socket
+   * \param packet - packet to send
+   * \param destination - destination node IP address
+   */
+  void SendTo (Ptr<Socket> socket, Ptr<Packet> packet, Ipv4Address destination);
+
+  /// Hello timer
+  Timer m_htimer;
+  /// Schedule next send of hello message
+  void HelloTimerExpire ();
+  /// RREQ rate limit timer
+  Timer m_rreqRateLimitTimer;
+  /// Reset RREQ count and schedule RREQ rate limit timer with delay 1 sec.
+  void RreqRateLimitTimerExpire ();
+  /// RERR rate limit timer
+  Timer m_rerrRateLimitTimer;
+  /// Reset RERR count and schedule RERR rate limit timer with delay 1 sec.
+  void RerrRateLimitTimerExpire ();
+  /// Map IP address + RREQ timer.
+  std::map<Ipv4Address, Timer> m_addressReqTimer;
+  /**
+   * Handle route discovery process
+   * \param dst the destination IP address
+   */
+  void RouteRequestTimerExpire (Ipv4Address dst);
+  /**
+   * Mark link to neighbor node as unidirectional for blacklistTimeout
+   *
+   * \param neighbor the IP address of the neightbor node
+   * \param blacklistTimeout the black list timeout time
+   */
+  void AckTimerExpire (Ipv4Address neighbor, Time blacklistTimeout);
+
+  /// Provides uniform random variables.
+  Ptr<UniformRandomVariable> m_uniformRandomVariable;
+  /// Provides the random wormhole decisions, on a stream separate from the jitter
+  Ptr<UniformRandomVariable> m_whDecisionVariable;
+  /// Keep track of the last bcast time
+  Time m_lastBcastTime;
+
+  struct recv_Rrep
+  {
+    RrepHeader rrepHeader;
+    Ipv4Address sender;
+    Time sendWHC;
+    uint8_t WHForwardFlag;
+    NeighborSet senderNeighbors; ///< RREP 送信者の隣接ノード（整列済み）
+    EventId timeout;             ///< 検証のタイムアウト（CheckResult）
+  };
+
+  /**
+   * \param origin the RREQ originator
+   * \param id the RREP ID
+   * \returns the key of the RREP in Rrep_List
+   */
+  static uint64_t GetRrepKey (Ipv4Address origin, uint32_t id)
+  {
+    return (static_cast<uint64_t> (origin.Get ()) << 32) | id;
+  }
+
+  /// WHC/WHE 検証中の RREP（(origin, id) がキー）。検証の完了かタイムアウトで削除する
+  std::unordered_map<uint64_t, recv_Rrep> Rrep_List;
+
+  std::vector<Ipv4Address> WH_List;
+
+  int WH_Flag;
+  
+  int get_rreptimes;
+
+  int WH1;
+
+  int WH2;
+
+  uint32_t rrepid;
+
+  uint8_t m_whMode; // 0=normal,1=internal,2=external
+
+  void SetWhMode(uint8_t mode)
+  {
+    m_whMode = mode;
+  }
+  uint8_t GetWhMode() const
+  {
+    return m_whMode;
+  }
+  
+};
+
+} //namespace aodv
+} //namespace ns3
+
+#endif /* AODVROUTINGPROTOCOL_H */
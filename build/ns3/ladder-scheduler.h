@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue of Tang, Goh and
+ * Thng, "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation", ACM TOMACS 15(3), 2005.
+ *
+ * Events are kept in three tiers:
+ *  - Top: an unsorted array of the events far in the future;
+ *  - Ladder: rungs of unsorted buckets.  When the bottom tier runs dry,
+ *    Top is spread over a new rung whose bucket width is derived from
+ *    the time span and number of the events it holds, and a bucket with
+ *    too many events is spread over a finer rung;
+ *  - Bottom: a short sorted list of the earliest events.
+ *
+ * Unlike CalendarScheduler there is no global resize: the bucket width
+ * of each rung adapts to the events it receives.  A bucket whose events
+ * all share one timestamp, as produced by a wireless channel delivering
+ * a broadcast to many receivers, cannot be split and is moved to Bottom
+ * as a whole with a single sort.  InsertBatch looks the tier up once
+ * for each run of events sharing a timestamp.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual void InsertBatch (const std::vector<Scheduler::Event> &events);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Unsorted bucket of events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    /** Create an unused rung, without buckets. */
+    Rung ()
+      : nBuckets (0),
+        start (0),
+        width (0),
+        current (0)
+    {
+    }
+
+    std::vector<Bucket> buckets; /**< The buckets; only the first nBuckets are in use. */
+    uint32_t nBuckets;           /**< Number of buckets in use. */
+    uint64_t start;              /**< Timestamp of the start of the first bucket. */
+    uint64_t width;              /**< Bucket width, in dimensionless time units. */
+    uint32_t current;            /**< First bucket not yet moved down. */
+  };
+
+  /**
+   * Find the unsorted bucket an event goes to, updating the Top bounds.
+   *
+   * \param [in] ts The timestamp of the event.
+   * \returns The bucket, or 0 if the event goes to Bottom.
+   */
+  Bucket * FindBucket (uint64_t ts);
+  /**
+   * Move the next events to Bottom, spawning rungs as needed.
+   * Bottom must be empty and the queue must not be.
+   */
+  void RefillBottom (void);
+  /**
+   * Spread events over a new rung.
+   *
+   * \param [in] events The events, emptied on return.
+   * \param [in] min The smallest timestamp of the events.
+   * \param [in] max The largest timestamp of the events.
+   * \param [in] nBuckets The number of buckets of the new rung.
+   */
+  void SpawnRung (Bucket &events, uint64_t min, uint64_t max, uint32_t nBuckets);
+  /**
+   * Sort events into the empty Bottom.
+   *
+   * \param [in] events The events, emptied on return.
+   */
+  void MoveToBottom (Bucket &events);
+  /**
+   * Insert an event in Bottom, keeping it sorted.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Remove an event from an unsorted bucket.
+   *
+   * \param [in] bucket The bucket.
+   * \param [in] ev The event.
+   * \returns \c true if the event was found.
+   */
+  static bool RemoveFromBucket (Bucket &bucket, const Scheduler::Event &ev);
+  /**
+   * \param [in] rung A rung.
+   * \returns The timestamp from which events go to the rung.
+   */
+  static uint64_t CurrentStart (const Rung &rung)
+  {
+    return rung.start + rung.current * rung.width;
+  }
+
+  /**
+   * Maximum number of events a bucket may hold and still be sorted
+   * straight into Bottom instead of being spread over a finer rung.
+   */
+  static const uint32_t THRESHOLD = 50;
+  /** Maximum number of rungs. */
+  static const uint32_t MAX_RUNGS = 8;
+
+  /** Top events, all with timestamps at or after m_topStart. */
+  Bucket m_top;
+  /** Smallest timestamp in Top. */
+  uint64_t m_topMin;
+  /** Largest timestamp in Top. */
+  uint64_t m_topMax;
+  /** Timestamp from which events are inserted in Top. */
+  uint64_t m_topStart;
+  /** The rungs; only the first m_nRungs are in use, the others keep their storage. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** Bottom events, sorted. */
+  std::deque<Scheduler::Event> m_bottom;
+  /** Number of events in the queue. */
+  uint32_t m_qSize;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 Telum (www.telum.ru)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Kirill Andreev <andreev@telum.ru>
+ */
+#ifndef PROPAGATION_CACHE_H_
+#define PROPAGATION_CACHE_H_
+
+#include "ns3/mobility-model.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ns3
+{
+/**
+ * \ingroup propagation
+ * \brief Constructs a cache of objects, where each object is responsible for a single propagation path loss calculations.
+ * A propagation path is identified by a couple of MobilityModels and a model UID,
+ * such as a spectrum model UID.  By default, propagation path a-->b and b-->a is
+ * the same thing; a cache built with symmetric set to false tells them apart.
+ *
+ * The paths of a mobility model can be dropped with RemovePathData, typically
+ * from its CourseChange trace, so that the cached objects can be memoized
+ * results which are only valid as long as the nodes do not move.
+ */
+template<class T>
+class PropagationCache
+{
+public:
+  /**
+   * \param symmetric whether a-->b and b-->a is the same path
+   */
+  PropagationCache (bool symmetric = true) : m_symmetric (symmetric) {};
+  ~PropagationCache () {};
+
+  /**
+   * Get the model associated with the path
+   * \param a 1st node mobility model
+   * \param b 2nd node mobility model
+   * \param modelUid model UID
+   * \return the model
+   */
+  Ptr<T> GetPathData (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
+  {
+    PropagationPathIdentifier key = PropagationPathIdentifier (a, b, modelUid, m_symmetric);
+    typename PathCache::iterator it = m_pathCache.find (key);
+    if (it == m_pathCache.end ())
+      {
+        return 0;
+      }
+    return it->second;
+  };
+
+  /**
+   * Add a model to the path
+   * \param data the model to associate to the path
+   * \param a 1st node mobility model
+   * \param b 2nd node mobility model
+   * \param modelUid model UID
+   */
+  void AddPathData (Ptr<T> data, Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
+  {
+    PropagationPathIdentifier key = PropagationPathIdentifier (a, b, modelUid, m_symmetric);
+    NS_ASSERT (m_pathCache.find (key) == m_pathCache.end ());
+    m_pathCache.insert (std::make_pair (key, data));
+    m_paths[PeekPointer (a)].insert (key);
+    m_paths[PeekPointer (b)].insert (key);
+  };
+
+  /**
+   * Remove the models of all the paths from or to a node
+   * \param a the node mobility model
+   */
+  void RemovePathData (Ptr<const MobilityModel> a)
+  {
+    typename PathIndex::iterator it = m_paths.find (PeekPointer (a));
+    if (it == m_paths.end ())
+      {
+        return;
+      }
+    for (typename PathSet::const_iterator path = it->second.begin (); path != it->second.end (); ++path)
+      {
+        m_pathCache.erase (*path);
+        const MobilityModel *other = PeekPointer (path->m_srcMobility) == PeekPointer (a)
+          ? PeekPointer (path->m_dstMobility) : PeekPointer (path->m_srcMobility);
+        if (other != PeekPointer (a))
+          {
+            m_paths[other].erase (*path);
+          }
+      }
+    m_paths.erase (it);
+  };
+
+  /**
+   * Remove the models of all the paths
+   */
+  void Clear (void)
+  {
+    m_pathCache.clear ();
+    m_paths.clear ();
+  };
+
+  /**
+   * \return the number of paths with a model
+   */
+  std::size_t GetNPaths (void) const
+  {
+    return m_pathCache.size ();
+  };
+
+private:
+  /// Each path is identified by
+  struct PropagationPathIdentifier
+  {
+    /**
+     * Constructor
+     * @param a 1st node mobility model
+     * @param b 2nd node mobility model
+     * @param modelUid model UID
+     * @param symmetric whether a-->b and b-->a is the same path
+     */
+    PropagationPathIdentifier (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid,
+                               bool symmetric) :
+      m_srcMobility (symmetric ? std::min (a, b) : a),
+      m_dstMobility (symmetric ? std::max (a, b) : b),
+      m_modelUid (modelUid)
+    {};
+    Ptr<const MobilityModel> m_srcMobility; //!< 1st node mobility model
+    Ptr<const MobilityModel> m_dstMobility; //!< 2nd node mobility model
+    uint32_t m_modelUid; //!< model UID
+
+    /**
+     * Equality operator.
+     *
+     * Links are already ordered by the constructor when they are symmetrical.
+     *
+     * \param other Right value of the operator.
+     * \returns True if both identify the same path.
+     */
+    bool operator == (const PropagationPathIdentifier & other) const
+    {
+      return m_modelUid == other.m_modelUid
+             && m_srcMobility == other.m_srcMobility
+             && m_dstMobility == other.m_dstMobility;
+    }
+  };
+
+  /// Hash of a PropagationPathIdentifier
+  struct PropagationPathHash
+  {
+    /**
+     * \param path the path
+     * \returns the hash of the path
+     */
+    std::size_t operator () (const PropagationPathIdentifier & path) const
+    {
+      std::size_t h = std::hash<const MobilityModel *> () (PeekPointer (path.m_srcMobility));
+      h ^= std::hash<const MobilityModel *> () (PeekPointer (path.m_dstMobility)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= path.m_modelUid + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  /// Typedef: PropagationPathIdentifier, Ptr<T>
+  typedef std::unordered_map<PropagationPathIdentifier, Ptr<T>, PropagationPathHash> PathCache;
+  /// Typedef: the paths of a node
+  typedef std::unordered_set<PropagationPathIdentifier, PropagationPathHash> PathSet;
+  /// Typedef: node mobility model, paths of the node
+  typedef std::unordered_map<const MobilityModel *, PathSet> PathIndex;
+private:
+  bool m_symmetric; //!< Whether a-->b and b-->a is the same path
+  PathCache m_pathCache; //!< Path cache
+  PathIndex m_paths; //!< Paths of each node, for RemovePathData
+};
+} // namespace ns3
+
+#endif // PROPAGATION_CACHE_H_
@@ -0,0 +1,321 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef STATS_REGISTRY_H
+#define STATS_REGISTRY_H
+
+#include <stdint.h>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ns3/singleton.h"
+#include "ns3/system-mutex.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Fixed bin histogram of a named statistic, kept per node.
+ *
+ * Values are counted in nBins bins of binWidth starting at 0; values
+ * below 0 go to the first bin and values beyond the last bin go to the
+ * last one.  The bins of all nodes are stored in a single array, node
+ * after node.
+ */
+class StatsHistogram
+{
+public:
+  /**
+   * \param name the statistic name
+   * \param binWidth the bin width
+   * \param nBins the number of bins
+   */
+  StatsHistogram (const std::string &name, double binWidth, uint32_t nBins);
+
+  /**
+   * Add one value
+   * \param node the node index
+   * \param value the value
+   */
+  void Record (uint32_t node, double value)
+  {
+    if (node >= m_count.size ())
+      {
+        Resize (node + 1);
+      }
+    uint32_t bin = value <= 0 ? 0 : static_cast<uint32_t> (value / m_binWidth);
+    if (bin >= m_nBins)
+      {
+        bin = m_nBins - 1;
+      }
+    m_bins[node * m_nBins + bin]++;
+    m_count[node]++;
+    m_sum[node] += value;
+  }
+
+  /// \return the statistic name
+  const std::string & GetName (void) const
+  {
+    return m_name;
+  }
+  /// \return the bin width
+  double GetBinWidth (void) const
+  {
+    return m_binWidth;
+  }
+  /// \return the number of bins
+  uint32_t GetNBins (void) const
+  {
+    return m_nBins;
+  }
+  /// \return the number of node slots
+  uint32_t GetNNodes (void) const
+  {
+    return m_count.size ();
+  }
+  /**
+   * \param node the node index
+   * \return the number of values recorded by the node
+   */
+  uint64_t GetCount (uint32_t node) const
+  {
+    return node < m_count.size () ? m_count[node] : 0;
+  }
+  /**
+   * \param node the node index
+   * \return the sum of the values recorded by the node
+   */
+  double GetSum (uint32_t node) const
+  {
+    return node < m_sum.size () ? m_sum[node] : 0;
+  }
+  /**
+   * \param node the node index
+   * \param bin the bin index
+   * \return the number of values of the node in the bin
+   */
+  uint64_t GetBin (uint32_t node, uint32_t bin) const
+  {
+    return node < m_count.size () ? m_bins[node * m_nBins + bin] : 0;
+  }
+  /// \return the number of values recorded by all nodes
+  uint64_t GetTotalCount (void) const;
+  /// \return the sum of the values recorded by all nodes
+  double GetTotalSum (void) const;
+  /// \return the bins summed over all nodes
+  std::vector<uint64_t> GetTotalBins (void) const;
+  /**
+   * \param q the quantile, in [0, 1]
+   * \return the upper edge of the bin holding the q quantile of all nodes
+   */
+  double GetTotalQuantile (double q) const;
+  /// Clear the recorded values, keep the layout
+  void Reset (void);
+
+private:
+  /**
+   * Grow the per-node arrays
+   * \param nNodes the new number of node slots
+   */
+  void Resize (uint32_t nNodes);
+
+  std::string m_name;           //!< statistic name
+  double m_binWidth;            //!< bin width
+  uint32_t m_nBins;             //!< number of bins
+  std::vector<uint64_t> m_bins; //!< bins, node after node
+  std::vector<uint64_t> m_count; //!< values per node
+  std::vector<double> m_sum;    //!< sum per node
+};
+
+/**
+ * \ingroup stats
+ *
+ * \brief Process wide registry of named per-node counters and histograms.
+ *
+ * A statistic is registered once by name and then updated through its
+ * integer id.  The values of every counter are kept in one contiguous
+ * array indexed by node id, so models update only their own slot and
+ * totals are computed by a single pass over the array, without visiting
+ * the model objects.  Registering an existing name returns the existing
+ * id, so every instance of a model can register its statistics.
+ *
+ * Values live until Reset or Simulator::Destroy, so read them before
+ * destroying the simulation; registrations and ids live for the whole
+ * process.  Registration, updates and the totals and exports take a
+ * lock, so simulations running in several threads may share the
+ * registry.  The references returned by GetCounterValues and
+ * GetHistogram are not protected and should only be read once the
+ * simulation is over.
+ */
+class StatsRegistry : public Singleton<StatsRegistry>
+{
+public:
+  StatsRegistry ();
+
+  /**
+   * Register a counter
+   * \param name the counter name
+   * \return the counter id
+   */
+  uint32_t RegisterCounter (const std::string &name);
+  /**
+   * Register a histogram.  An existing histogram keeps its layout.
+   * \param name the histogram name
+   * \param binWidth the bin width
+   * \param nBins the number of bins
+   * \return the histogram id
+   */
+  uint32_t RegisterHistogram (const std::string &name, double binWidth, uint32_t nBins);
+
+  /**
+   * Add to a counter
+   * \param id the counter id
+   * \param node the node index
+   * \param value the increment
+   */
+  void Add (uint32_t id, uint32_t node, uint64_t value = 1)
+  {
+    CriticalSection cs (m_mutex);
+    std::vector<uint64_t> &values = m_counters[id];
+    if (node >= values.size ())
+      {
+        values.resize (node + 1, 0);
+      }
+    values[node] += value;
+  }
+  /**
+   * Add a value to a histogram
+   * \param id the histogram id
+   * \param node the node index
+   * \param value the value
+   */
+  void Record (uint32_t id, uint32_t node, double value)
+  {
+    CriticalSection cs (m_mutex);
+    m_histograms[id].Record (node, value);
+  }
+
+  /**
+   * \param id the counter id
+   * \return the value of the counter for every node, indexed by node
+   */
+  const std::vector<uint64_t> & GetCounterValues (uint32_t id) const
+  {
+    return m_counters[id];
+  }
+  /**
+   * \param id the counter id
+   * \param node the node index
+   * \return the value of the counter for the node
+   */
+  uint64_t GetCounter (uint32_t id, uint32_t node) const
+  {
+    return node < m_counters[id].size () ? m_counters[id][node] : 0;
+  }
+  /**
+   * \param id the counter id
+   * \return the counter summed over all nodes
+   */
+  uint64_t GetCounterTotal (uint32_t id) const;
+  /**
+   * \param name the counter name
+   * \return the counter summed over all nodes, 0 if no such counter
+   */
+  uint64_t GetCounterTotal (const std::string &name) const;
+  /**
+   * \param id the histogram id
+   * \return the histogram
+   */
+  const StatsHistogram & GetHistogram (uint32_t id) const
+  {
+    return m_histograms[id];
+  }
+  /**
+   * \param name the histogram name
+   * \return the histogram, 0 if no such histogram
+   */
+  const StatsHistogram * FindHistogram (const std::string &name) const;
+
+  /// \return the number of registered counters
+  uint32_t GetNCounters (void) const
+  {
+    return m_counters.size ();
+  }
+  /// \return the number of registered histograms
+  uint32_t GetNHistograms (void) const
+  {
+    return m_histograms.size ();
+  }
+  /**
+   * \param id the counter id
+   * \return the counter name
+   */
+  const std::string & GetCounterName (uint32_t id) const
+  {
+    return m_counterNames[id];
+  }
+
+  /// Clear all values, keep the registrations and ids
+  void Reset (void);
+
+  /**
+   * Write all statistics as CSV.
+   *
+   * Counters produce "counter,<name>,<node>,<value>" rows and histograms
+   * "histogram,<name>,<node>,<count>,<sum>,<binWidth>,<bin0;bin1;...>"
+   * rows.  The node column is "all" for totals.
+   *
+   * \param os the output stream
+   * \param perNode write one row per node in addition to the totals
+   */
+  void WriteCsv (std::ostream &os, bool perNode = false) const;
+  /**
+   * Write all statistics as a JSON object with "counters" and
+   * "histograms" members.
+   * \param os the output stream
+   * \param perNode include the per-node arrays
+   */
+  void WriteJson (std::ostream &os, bool perNode = false) const;
+
+private:
+  /**
+   * Arrange for Reset to run at the next Simulator::Destroy.
+   * Must be called with m_mutex held.
+   */
+  void ScheduleResetOnDestroy (void);
+  /// Reset the values of the registry at Simulator::Destroy
+  static void ResetOnDestroy (void);
+  /**
+   * Sum a counter, with m_mutex held
+   * \param id the counter id
+   * \return the counter summed over all nodes
+   */
+  uint64_t DoGetCounterTotal (uint32_t id) const;
+
+  mutable SystemMutex m_mutex;                     //!< protects the values and registrations
+  bool m_resetScheduled;                           //!< a reset is scheduled at Simulator::Destroy
+  std::vector<std::string> m_counterNames;         //!< counter names, by id
+  std::vector<std::vector<uint64_t> > m_counters;  //!< counter values, by id then node
+  std::map<std::string, uint32_t> m_counterIds;    //!< counter ids, by name
+  std::vector<StatsHistogram> m_histograms;        //!< histograms, by id
+  std::map<std::string, uint32_t> m_histogramIds;  //!< histogram ids, by name
+};
+
+} // namespace ns3
+
+#endif /* STATS_REGISTRY_H */
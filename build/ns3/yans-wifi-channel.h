@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef YANS_WIFI_CHANNEL_H
+#define YANS_WIFI_CHANNEL_H
+
+#include <unordered_map>
+#include "ns3/channel.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/vector.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/propagation-cache.h"
+#include "ns3/position-snapshot.h"
+
+namespace ns3 {
+
+class NetDevice;
+class MobilityModel;
+class PropagationLossModel;
+class PropagationDelayModel;
+class YansWifiPhy;
+class Packet;
+class Time;
+
+/**
+ * \brief a channel to interconnect ns3::YansWifiPhy objects.
+ * \ingroup wifi
+ *
+ * This class is expected to be used in tandem with the ns3::YansWifiPhy
+ * class and supports an ns3::PropagationLossModel and an
+ * ns3::PropagationDelayModel.  By default, no propagation models are set;
+ * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default Send reaches every other PHY on the channel.  Two optional
+ * cutoffs avoid scheduling reception events that can never be processed:
+ * with the MaxRange attribute set, the PHYs are indexed in a uniform grid
+ * of MaxRange sized cells and only those within MaxRange of the sender are
+ * considered; with CullBelowSensitivity set, a receiver whose rx power is
+ * below its sensitivity is dropped at Send time instead of in Receive.
+ * Candidates are still visited in the order they were added, so the
+ * remaining events are scheduled exactly as with the exhaustive loop.
+ * The grid and the distance checks read the PHY positions from a
+ * PositionSnapshot, refreshed at most once per simulation time.
+ * MaxRange must be chosen large enough for the propagation loss model;
+ * ValidateCulling compares every Send against the exhaustive loop and
+ * aborts if a culled PHY would have received the frame.
+ *
+ * With the CachePropagation attribute set, and if both the loss and the
+ * delay models are deterministic, the rx power and the delay of each
+ * sender/receiver pair are memoized while both PHYs have a zero velocity.
+ * The entries of a PHY are dropped when its mobility model fires its
+ * CourseChange trace.
+ *
+ * The rx powers of all the receivers of a frame are computed with one
+ * PropagationLossModel::CalcRxPowerBatch call, from the positions of the
+ * PositionSnapshot.
+ */
+class YansWifiChannel : public Channel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  YansWifiChannel ();
+  virtual ~YansWifiChannel ();
+
+  //inherited from Channel.
+  virtual std::size_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
+
+  /**
+   * Adds the given YansWifiPhy to the PHY list
+   *
+   * \param phy the YansWifiPhy to be added to the PHY list
+   */
+  void Add (Ptr<YansWifiPhy> phy);
+
+  /**
+   * \param loss the new propagation loss model.
+   */
+  void SetPropagationLossModel (const Ptr<PropagationLossModel> loss);
+  /**
+   * \param delay the new propagation delay model.
+   */
+  void SetPropagationDelayModel (const Ptr<PropagationDelayModel> delay);
+  /**
+   * \returns the propagation loss model.
+   */
+  Ptr<PropagationLossModel> GetPropagationLossModel (void) const;
+  /**
+   * \returns the propagation delay model.
+   */
+  Ptr<PropagationDelayModel> GetPropagationDelayModel (void) const;
+
+  /**
+   * \param sender the phy object from which the packet is originating.
+   * \param packet the packet to send
+   * \param txPowerDbm the tx power associated to the packet, in dBm
+   * \param duration the transmission duration associated with the packet
+   *
+   * This method should not be invoked by normal users. It is
+   * currently invoked only from YansWifiPhy::StartTx.  The channel
+   * attempts to deliver the packet to all other YansWifiPhy objects
+   * on the channel (except for the sender).
+   */
+  void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration) const;
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   *
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * A vector of pointers to YansWifiPhy.
+   */
+  typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+
+  /**
+   * This method is scheduled by Send for each associated YansWifiPhy.
+   * The method then calls the corresponding YansWifiPhy that the first
+   * bit of the packet has arrived.
+   *
+   * \param receiver the device to which the packet is destined
+   * \param packet the packet being sent, shared by all the receivers
+   * \param txPowerDbm the tx power associated to the packet being sent (dBm)
+   * \param duration the transmission duration associated with the packet being sent
+   */
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<const Packet> packet, double txPowerDbm, Time duration);
+
+  /**
+   * Add the Receive event of one receiver to m_rxBatch.
+   *
+   * \param receiver the receiving PHY
+   * \param packet the packet being sent
+   * \param rxPowerDbm the rx power (dBm)
+   * \param delay the propagation delay
+   * \param duration the transmission duration associated with the packet being sent
+   */
+  void SendTo (Ptr<YansWifiPhy> receiver, Ptr<const Packet> packet,
+               double rxPowerDbm, Time delay, Time duration) const;
+  /**
+   * Compute the rx power and the delay from a sender to each PHY of
+   * m_receivers into m_rxPowerDbm and m_delays.  The pairs found in
+   * m_propagationCache are looked up, the rx powers of the others are
+   * computed with a single PropagationLossModel::CalcRxPowerBatch call.
+   *
+   * \param sender the index of the sender in m_phyList
+   * \param txPowerDbm the tx power (dBm)
+   */
+  void CalcPropagation (uint32_t sender, double txPowerDbm) const;
+  /**
+   * Connect to the CourseChange trace of the PHYs added since the last
+   * call and add them to m_positions.
+   */
+  void TrackMobility (void) const;
+  /**
+   * \param position a position
+   * \return the key of the grid cell containing the position
+   */
+  uint64_t GetCellKey (const Vector &position) const;
+  /**
+   * Record the position of every PHY in the grid.
+   */
+  void BuildGrid (void) const;
+  /**
+   * Collect the indices of the PHYs within MaxRange of the sender, in
+   * ascending order, into m_candidates.
+   *
+   * \param sender the index of the sender in m_phyList
+   */
+  void FindCandidates (uint32_t sender) const;
+  /**
+   * Move a PHY to the cell of its new position and drop its cached
+   * propagation results.
+   *
+   * \param channel the channel
+   * \param index the index of the PHY in m_phyList
+   * \param mobility the mobility model that changed course
+   */
+  static void NotifyCourseChange (const YansWifiChannel *channel, uint32_t index, Ptr<const MobilityModel> mobility);
+  /**
+   * Abort if a PHY missing from m_candidates would have received the frame.
+   *
+   * \param sender the sending PHY
+   * \param txPowerDbm the tx power (dBm)
+   */
+  void ValidateCandidates (Ptr<YansWifiPhy> sender, double txPowerDbm) const;
+
+  PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
+  std::unordered_map<const YansWifiPhy *, uint32_t> m_phyIndex; //!< Index of each PHY in m_phyList
+  Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
+  Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Receivers farther than this (m) are not reached, 0 to disable
+  bool m_cullBelowSensitivity;         //!< Drop receivers below their sensitivity at Send time
+  bool m_validateCulling;              //!< Check the MaxRange culling against the exhaustive loop
+  bool m_cachePropagation;             //!< Memoize the propagation results of static PHYs
+
+  typedef std::unordered_map<uint64_t, std::vector<uint32_t> > Grid; //!< PHY indices per grid cell
+  mutable Grid m_grid;                                  //!< Grid of PHY positions
+  mutable std::vector<uint64_t> m_gridCell;             //!< Current cell of each indexed PHY
+  mutable std::vector<Ptr<MobilityModel> > m_mobility; //!< Mobility models connected to NotifyCourseChange
+  mutable bool m_gridValid;                             //!< False when the grid must be rebuilt
+  mutable Time m_gridTime;                              //!< Time at which the grid was built
+  mutable double m_gridMaxSpeed;                        //!< Highest PHY speed seen since the grid was built (m/s)
+  mutable std::vector<uint32_t> m_candidates;           //!< Scratch list of candidate receivers
+  mutable std::vector<double> m_distances;              //!< Scratch distances to the candidate receivers
+  mutable PositionSnapshot m_positions;                 //!< Positions of the PHYs in m_mobility
+  mutable Simulator::ContextEventBatch m_rxBatch;       //!< Receive events of the frame being sent
+  mutable std::vector<uint32_t> m_receivers;            //!< Receivers of the frame being sent
+  mutable std::vector<double> m_rxDistances;            //!< Distance to each receiver (m)
+  mutable std::vector<double> m_rxPowerDbm;             //!< Rx power of each receiver (dBm)
+  mutable std::vector<Time> m_delays;                   //!< Propagation delay to each receiver
+  mutable std::vector<std::size_t> m_misses;            //!< Receivers not found in m_propagationCache
+  mutable std::vector<Ptr<MobilityModel> > m_batchMobility; //!< Mobility models of the batch
+  mutable std::vector<Vector> m_batchPositions;         //!< Positions of the batch
+  mutable std::vector<double> m_batchDistances;         //!< Distances of the batch (m)
+  mutable std::vector<double> m_batchRxPowerDbm;        //!< Rx powers of the batch (dBm)
+
+  /**
+   * The propagation results of a sender/receiver pair.
+   */
+  struct PathData : public SimpleRefCount<PathData>
+  {
+    double txPowerDbm; //!< the tx power (dBm)
+    double rxPowerDbm; //!< the rx power (dBm)
+    Time delay;        //!< the propagation delay
+  };
+  mutable PropagationCache<PathData> m_propagationCache; //!< Propagation results of static PHY pairs
+  mutable std::vector<Ptr<PathData> > m_missPaths;      //!< Cache entries to fill for the batch, or null
+};
+
+} //namespace ns3
+
+#endif /* YANS_WIFI_CHANNEL_H */
@@ -23,6 +23,8 @@
 #include <iostream>
 #include <cmath>
 #include "ns3/aodv-module.h"
+#include "ns3/stats-registry.h"
+#include "ns3/hdr-histogram.h"
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
@@ -357,13 +359,15 @@ AodvExample::Report (std::ostream &)
   std::vector<double> latencies;
   uint32_t latencyCount = 0;
   Time totalRouteTime = Seconds(0);
+  HdrHistogram routeLatency; // 全ノードの経路作成時間 [us]
 
   if (needHeader)
   {
       ofs << "seed,nodes,wh_mode,forwardmode,end_distance,"
           << "tp,fn,fp,tn,"
           << "wh_detection_rate,false_positive_rate,"
-          << "total_ctrl_bytes,avg_route_latency\n";
+          << "total_ctrl_bytes,avg_route_latency,"
+          << "route_latency_p50,route_latency_p95,route_latency_p99\n";
   }
 
   for (uint32_t i = 0; i < nodes.GetN(); i++)
@@ -373,21 +377,11 @@ AodvExample::Report (std::ostream &)
       Ptr<aodv::RoutingProtocol> aodv = DynamicCast<aodv::RoutingProtocol>(rp);
       if (!aodv) continue;
 
-      auto stats = aodv->Getevaluation();
+      const aodv::RoutingProtocol::WhDetectionStats &stats = aodv->Getevaluation();
 
-      totalTP += stats.detectedWh;
-      totalFN += stats.undetectedWh;
-      totalFP += stats.falsePositive;
-      totalTN += stats.truenegative;
       totalNA += stats.notApplicable;
-      totalBytes += stats.totalAodvCtrlBytes;
       totalforwardedHello += stats.helloForwardedCount;
-
-      if(stats.Getroute)
-      {
-        latencyCount++;
-        totalRouteTime += stats.m_routetime;
-      }
+      routeLatency.Merge (aodv->GetRouteLatencyHistogram ());
 
 
       // for (const auto &kv : stats.m_latencyTable)
@@ -398,6 +392,20 @@ AodvExample::Report (std::ostream &)
       // }
   }
 
+  // 判定数・制御バイト数・経路確立時刻は StatsRegistry に全ノード分まとまっている
+  StatsRegistry *registry = StatsRegistry::Get();
+  totalTP = registry->GetCounterTotal("aodv.wh.tp");
+  totalFN = registry->GetCounterTotal("aodv.wh.fn");
+  totalFP = registry->GetCounterTotal("aodv.wh.fp");
+  totalTN = registry->GetCounterTotal("aodv.wh.tn");
+  totalBytes = registry->GetCounterTotal("aodv.ctrl.bytes");
+  const StatsHistogram *routeTime = registry->FindHistogram("aodv.route.time");
+  if (routeTime)
+  {
+      latencyCount = routeTime->GetTotalCount();
+      totalRouteTime = Seconds(routeTime->GetTotalSum());
+  }
+
   double detectionRate = (totalTP + totalFN > 0)
                           ? (double)totalTP / (totalTP + totalFN)
                           : 0.0;
@@ -432,6 +440,9 @@ AodvExample::Report (std::ostream &)
       << falsePositiveRate << ","
       << totalBytes << ","
       << avgLatencySec << ","
+      << routeLatency.GetQuantile (0.50) / 1e6 << ","
+      << routeLatency.GetQuantile (0.95) / 1e6 << ","
+      << routeLatency.GetQuantile (0.99) / 1e6 << ","
       << totalforwardedHello << "\n";
 
   ofs.close();
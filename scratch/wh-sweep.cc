@@ -0,0 +1,467 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Parameter sweep driver for the random-* wormhole detection scenarios.
+ *
+ *   ./waf --run "wh-sweep --scenario=random-hybrid --WH_size=300,400,500,600
+ *                --end_distance=800 --size=600 --forwardmode=0 --seeds=1-20
+ *                --result_file=results/hybrid/WHsize{WH_size}.csv"
+ *
+ * Every (WH_size, end_distance, size, forwardmode, seed) combination is one
+ * replication.  Replications run as separate processes of the already built
+ * scenario binary (no waf start-up per run), at most --jobs at a time
+ * (default: number of online cores).  Each replication writes its Report
+ * row into a private part file; only this driver appends rows to the
+ * result file, one replication at a time, so concurrent runs never
+ * interleave partial lines.
+ *
+ * The scenarios also write fixed-name files (sample.txt, WH_count.txt,
+ * com_num.txt, test.log, pcaps) into their working directory, so every
+ * replication runs in its own directory <log_dir>/<tag>, where those
+ * files are kept after the run.
+ */
+
+#include "ns3/core-module.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WhSweep");
+
+// 1 回のシミュレーション実行
+struct SweepJob
+{
+  std::vector<std::pair<std::string, std::string> > params; // シナリオに渡す --name=value
+  uint32_t seed;
+  std::string resultFile; // マージ先
+  std::string partFile;   // この実行専用の CSV
+  std::string tag;        // ログファイル名
+  std::string workDir;    // この実行専用の作業ディレクトリ
+};
+
+// "300,400" や "1-20" を展開する（空文字列なら空）
+static std::vector<std::string>
+ParseList (const std::string &s)
+{
+  std::vector<std::string> out;
+  std::stringstream ss (s);
+  std::string item;
+  while (std::getline (ss, item, ','))
+    {
+      if (item.empty ())
+        {
+          continue;
+        }
+      std::string::size_type dash = item.find ('-', 1);
+      if (dash != std::string::npos)
+        {
+          int32_t first = std::atoi (item.substr (0, dash).c_str ());
+          int32_t last = std::atoi (item.substr (dash + 1).c_str ());
+          for (int32_t v = first; v <= last; v++)
+            {
+              std::ostringstream os;
+              os << v;
+              out.push_back (os.str ());
+            }
+        }
+      else
+        {
+          out.push_back (item);
+        }
+    }
+  return out;
+}
+
+// {name} を値で置き換える
+static std::string
+Expand (std::string s, const std::vector<std::pair<std::string, std::string> > &params)
+{
+  for (std::size_t i = 0; i < params.size (); i++)
+    {
+      std::string key = "{" + params[i].first + "}";
+      std::string::size_type pos;
+      while ((pos = s.find (key)) != std::string::npos)
+        {
+          s.replace (pos, key.size (), params[i].second);
+        }
+    }
+  return s;
+}
+
+// mkdir -p
+static void
+MakeDirectories (const std::string &dir)
+{
+  for (std::string::size_type pos = 1; pos <= dir.size (); pos++)
+    {
+      if (pos == dir.size () || dir[pos] == '/')
+        {
+          std::string sub = dir.substr (0, pos);
+          if (::mkdir (sub.c_str (), 0755) != 0 && errno != EEXIST)
+            {
+              NS_FATAL_ERROR ("Cannot create directory: " << sub << " (" << std::strerror (errno) << ")");
+            }
+        }
+    }
+}
+
+static std::string
+GetParentDir (const std::string &path)
+{
+  std::string::size_type pos = path.find_last_of ('/');
+  return pos == std::string::npos ? std::string () : path.substr (0, pos);
+}
+
+// カレントディレクトリ基準の絶対パスにする（子プロセスは chdir するため）
+static std::string
+AbsolutePath (const std::string &path)
+{
+  if (path.empty () || path[0] == '/')
+    {
+      return path;
+    }
+  char buf[4096];
+  if (::getcwd (buf, sizeof (buf)) == 0)
+    {
+      NS_FATAL_ERROR ("getcwd failed: " << std::strerror (errno));
+    }
+  return std::string (buf) + "/" + path;
+}
+
+// シナリオのバイナリ: 自分 (…/ns3-dev-wh-sweep-debug) と同じ命名規則
+static std::string
+FindScenarioProgram (const std::string &scenario)
+{
+  char buf[4096];
+  ssize_t n = ::readlink ("/proc/self/exe", buf, sizeof (buf) - 1);
+  if (n <= 0)
+    {
+      return scenario;
+    }
+  std::string self (buf, n);
+  std::string::size_type pos = self.rfind ("wh-sweep");
+  if (pos == std::string::npos)
+    {
+      return scenario;
+    }
+  return self.replace (pos, std::strlen ("wh-sweep"), scenario);
+}
+
+// 子プロセスでシナリオを起動する
+static pid_t
+StartJob (const SweepJob &job, const std::string &program,
+          const std::vector<std::string> &extraArgs, const std::string &logDir)
+{
+  std::vector<std::string> args;
+  args.push_back (program);
+  for (std::size_t i = 0; i < job.params.size (); i++)
+    {
+      args.push_back ("--" + job.params[i].first + "=" + job.params[i].second);
+    }
+  std::ostringstream seed;
+  seed << "--iteration=" << job.seed;
+  args.push_back (seed.str ());
+  args.push_back ("--result_file=" + job.partFile);
+  args.insert (args.end (), extraArgs.begin (), extraArgs.end ());
+
+  std::cout.flush ();
+  std::cerr.flush ();
+  pid_t pid = ::fork ();
+  if (pid != 0)
+    {
+      return pid;
+    }
+
+  // child: 固定名のファイルが他の実行と衝突しないよう専用ディレクトリで動かす
+  if (::chdir (job.workDir.c_str ()) != 0)
+    {
+      std::fprintf (stderr, "chdir %s: %s\n", job.workDir.c_str (), std::strerror (errno));
+      ::_exit (127);
+    }
+  std::string out = logDir + "/" + job.tag + ".out";
+  std::string err = logDir + "/" + job.tag + ".err";
+  int fdOut = ::open (out.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  int fdErr = ::open (err.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fdOut >= 0)
+    {
+      ::dup2 (fdOut, STDOUT_FILENO);
+      ::close (fdOut);
+    }
+  if (fdErr >= 0)
+    {
+      ::dup2 (fdErr, STDERR_FILENO);
+      ::close (fdErr);
+    }
+  std::vector<char *> argv;
+  for (std::size_t i = 0; i < args.size (); i++)
+    {
+      argv.push_back (const_cast<char *> (args[i].c_str ()));
+    }
+  argv.push_back (0);
+  ::execv (program.c_str (), &argv[0]);
+  std::fprintf (stderr, "execv %s: %s\n", program.c_str (), std::strerror (errno));
+  ::_exit (127);
+}
+
+// 実行結果の行を結果ファイルへ追記する（ヘッダは最初の 1 回だけ）
+static bool
+MergeJob (const SweepJob &job)
+{
+  std::ifstream part (job.partFile.c_str ());
+  if (!part.good ())
+    {
+      return false;
+    }
+  std::string header;
+  std::getline (part, header);
+  std::ostringstream rows;
+  std::string line;
+  while (std::getline (part, line))
+    {
+      if (!line.empty ())
+        {
+          rows << line << "\n";
+        }
+    }
+  part.close ();
+  std::remove (job.partFile.c_str ());
+
+  std::string parent = GetParentDir (job.resultFile);
+  if (!parent.empty ())
+    {
+      MakeDirectories (parent);
+    }
+  bool needHeader = true;
+  {
+    std::ifstream ifs (job.resultFile.c_str (), std::ios::in | std::ios::ate);
+    needHeader = !ifs.good () || ifs.tellg () == 0;
+  }
+  std::ofstream ofs (job.resultFile.c_str (), std::ios::out | std::ios::app);
+  if (!ofs.is_open ())
+    {
+      return false;
+    }
+  std::string chunk = (needHeader ? header + "\n" : std::string ()) + rows.str ();
+  ofs.write (chunk.data (), chunk.size ());
+  ofs.flush ();
+  return ofs.good ();
+}
+
+int
+main (int argc, char **argv)
+{
+  std::string scenario = "random-hybrid";
+  std::string program = "";
+  std::string whSizes = "";
+  std::string endDistances = "";
+  std::string sizes = "";
+  std::string forwardModes = "";
+  std::string seeds = "1-20";
+  std::string time = "";
+  std::string resultFile = "results/sweep/WHsize{WH_size}.csv";
+  std::string logDir = "";
+  std::string extra = "";
+  uint32_t jobs = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("scenario", "Scenario program in scratch/ (random-hybrid, random-inband, ...)", scenario);
+  cmd.AddValue ("program", "Path of the scenario binary (default: next to this program)", program);
+  cmd.AddValue ("WH_size", "WH sizes, e.g. 300,400,500,600", whSizes);
+  cmd.AddValue ("end_distance", "End distances", endDistances);
+  cmd.AddValue ("size", "Numbers of nodes", sizes);
+  cmd.AddValue ("forwardmode", "Forward modes", forwardModes);
+  cmd.AddValue ("seeds", "Seeds (--iteration), e.g. 1-20", seeds);
+  cmd.AddValue ("time", "Simulation time, s", time);
+  cmd.AddValue ("result_file", "Result CSV; {WH_size}, {end_distance}, {size}, {forwardmode} are replaced", resultFile);
+  cmd.AddValue ("log_dir", "Directory of per-run stdout/stderr and working directories (default: <result dir>/logs)", logDir);
+  cmd.AddValue ("args", "Extra arguments passed to every run, space separated", extra);
+  cmd.AddValue ("jobs", "Number of parallel runs (0: number of cores)", jobs);
+  cmd.Parse (argc, argv);
+
+  if (jobs == 0)
+    {
+      long n = ::sysconf (_SC_NPROCESSORS_ONLN);
+      jobs = n > 0 ? n : 1;
+    }
+  if (program.empty ())
+    {
+      program = FindScenarioProgram (scenario);
+    }
+  if (::access (program.c_str (), X_OK) != 0)
+    {
+      NS_FATAL_ERROR ("Scenario program not found: " << program << " (build it with ./waf first)");
+    }
+  program = AbsolutePath (program);
+
+  std::vector<std::string> extraArgs;
+  {
+    std::istringstream is (extra);
+    std::string a;
+    while (is >> a)
+      {
+        extraArgs.push_back (a);
+      }
+  }
+
+  // パラメータグリッドを展開する（未指定の項目はシナリオの既定値）
+  std::vector<std::pair<std::string, std::vector<std::string> > > grid;
+  grid.push_back (std::make_pair ("WH_size", ParseList (whSizes)));
+  grid.push_back (std::make_pair ("end_distance", ParseList (endDistances)));
+  grid.push_back (std::make_pair ("size", ParseList (sizes)));
+  grid.push_back (std::make_pair ("forwardmode", ParseList (forwardModes)));
+  std::vector<std::vector<std::pair<std::string, std::string> > > points (1);
+  for (std::size_t d = 0; d < grid.size (); d++)
+    {
+      if (grid[d].second.empty ())
+        {
+          continue;
+        }
+      std::vector<std::vector<std::pair<std::string, std::string> > > next;
+      for (std::size_t p = 0; p < points.size (); p++)
+        {
+          for (std::size_t v = 0; v < grid[d].second.size (); v++)
+            {
+              next.push_back (points[p]);
+              next.back ().push_back (std::make_pair (grid[d].first, grid[d].second[v]));
+            }
+        }
+      points.swap (next);
+    }
+  if (!time.empty ())
+    {
+      for (std::size_t p = 0; p < points.size (); p++)
+        {
+          points[p].push_back (std::make_pair ("time", time));
+        }
+    }
+
+  std::vector<std::string> seedList = ParseList (seeds);
+  std::vector<SweepJob> jobList;
+  for (std::size_t p = 0; p < points.size (); p++)
+    {
+      for (std::size_t s = 0; s < seedList.size (); s++)
+        {
+          SweepJob job;
+          job.params = points[p];
+          job.seed = std::atoi (seedList[s].c_str ());
+          job.resultFile = Expand (resultFile, job.params);
+          std::ostringstream tag;
+          for (std::size_t i = 0; i < job.params.size (); i++)
+            {
+              tag << job.params[i].first << job.params[i].second << "_";
+            }
+          tag << "seed_" << job.seed;
+          job.tag = tag.str ();
+          std::ostringstream part;
+          part << job.resultFile << ".part" << jobList.size ();
+          job.partFile = AbsolutePath (part.str ());
+          std::remove (job.partFile.c_str ());
+          jobList.push_back (job);
+        }
+    }
+
+  if (logDir.empty ())
+    {
+      std::string parent = GetParentDir (Expand (resultFile, points[0]));
+      logDir = (parent.empty () ? std::string (".") : parent) + "/logs";
+    }
+  logDir = AbsolutePath (logDir);
+  MakeDirectories (logDir);
+  for (std::size_t j = 0; j < jobList.size (); j++)
+    {
+      jobList[j].workDir = logDir + "/" + jobList[j].tag;
+      MakeDirectories (jobList[j].workDir);
+    }
+  std::string failedLog = logDir + "/failed.log";
+  std::ofstream failed (failedLog.c_str (), std::ios::out | std::ios::trunc);
+
+  std::cout << "[INFO] " << jobList.size () << " runs of " << program
+            << " on " << jobs << " workers" << std::endl;
+
+  std::map<pid_t, std::size_t> running;
+  std::size_t next = 0;
+  uint32_t nFailed = 0;
+  while (next < jobList.size () || !running.empty ())
+    {
+      while (running.size () < jobs && next < jobList.size ())
+        {
+          pid_t pid = StartJob (jobList[next], program, extraArgs, logDir);
+          if (pid < 0)
+            {
+              NS_FATAL_ERROR ("fork failed: " << std::strerror (errno));
+            }
+          running[pid] = next++;
+        }
+
+      int status = 0;
+      pid_t pid = ::waitpid (-1, &status, 0);
+      if (pid < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          NS_FATAL_ERROR ("waitpid failed: " << std::strerror (errno));
+        }
+      std::map<pid_t, std::size_t>::iterator it = running.find (pid);
+      if (it == running.end ())
+        {
+          continue;
+        }
+      const SweepJob &job = jobList[it->second];
+      running.erase (it);
+
+      bool ok = WIFEXITED (status) && WEXITSTATUS (status) == 0 && MergeJob (job);
+      if (ok)
+        {
+          std::cout << "[OK] " << job.tag << std::endl;
+        }
+      else
+        {
+          nFailed++;
+          std::remove (job.partFile.c_str ());
+          std::ostringstream why;
+          if (WIFEXITED (status))
+            {
+              why << "exit=" << WEXITSTATUS (status);
+            }
+          else
+            {
+              why << "signal=" << WTERMSIG (status);
+            }
+          std::cout << "[FAIL] " << job.tag << " (" << why.str () << ")" << std::endl;
+          failed << "[FAIL] " << job.tag << " (" << why.str () << ")\n";
+          failed.flush ();
+        }
+    }
+
+  std::cout << "[INFO] done, " << nFailed << " failed; logs under " << logDir << std::endl;
+  return nFailed == 0 ? 0 : 1;
+}
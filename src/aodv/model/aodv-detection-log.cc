@@ -0,0 +1,340 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "aodv-detection-log.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AodvDetectionLog");
+
+namespace aodv {
+
+DetectionLog::DetectionLog ()
+  : m_format (LEGACY),
+    m_fileName ("wh-detection"),
+    m_bufferSize (4096),
+    m_nodeId (0)
+{
+  DetectionLogWriter *writer = DetectionLogWriter::Get ();
+  if (writer != 0)
+    {
+      writer->Register (this);
+    }
+}
+
+DetectionLog::~DetectionLog ()
+{
+  // 終了時に書き出し側が先に破棄された場合は、そこで書き出し済み
+  DetectionLogWriter *writer = DetectionLogWriter::Get ();
+  if (writer != 0)
+    {
+      Flush ();
+      writer->Unregister (this);
+    }
+}
+
+void
+DetectionLog::SetFormat (Format format)
+{
+  Flush ();
+  m_format = format;
+}
+
+void
+DetectionLog::SetFileName (std::string name)
+{
+  Flush ();
+  m_fileName = name;
+}
+
+void
+DetectionLog::SetBufferSize (uint32_t size)
+{
+  m_bufferSize = std::max<uint32_t> (size, 1);
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Flush ();
+    }
+}
+
+void
+DetectionLog::Record (DetectionEventType type, uint32_t value,
+                      Ipv4Address address, DetectionMisdetectionReason reason)
+{
+  if (m_format == NONE)
+    {
+      return;
+    }
+  if (m_buffer.capacity () < m_bufferSize)
+    {
+      m_buffer.reserve (m_bufferSize);
+    }
+  DetectionRecord r;
+  r.m_time = Simulator::Now ().GetTimeStep ();
+  r.m_node = m_nodeId;
+  r.m_type = type;
+  r.m_reason = reason;
+  r.m_value = value;
+  r.m_address = address.Get ();
+  DetectionLogWriter *writer = DetectionLogWriter::Get ();
+  r.m_seq = writer != 0 ? writer->NextSequence () : 0;
+  m_buffer.push_back (r);
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Flush ();
+    }
+}
+
+void
+DetectionLog::Flush ()
+{
+  DetectionLogWriter *writer = DetectionLogWriter::Get ();
+  if (m_buffer.empty () || writer == 0)
+    {
+      return;
+    }
+  writer->FlushAll ();
+}
+
+/**
+ * \param a a record
+ * \param b another record
+ * \returns true if a was recorded before b
+ */
+static bool
+IsRecordedBefore (const DetectionRecord &a, const DetectionRecord &b)
+{
+  return a.m_seq < b.m_seq;
+}
+
+DetectionLogWriter::DetectionLogWriter ()
+  : m_seq (0)
+{
+}
+
+bool DetectionLogWriter::s_destroyed = false;
+
+DetectionLogWriter::~DetectionLogWriter ()
+{
+  FlushAll ();
+  Close ();
+  m_logs.clear ();
+  s_destroyed = true;
+}
+
+DetectionLogWriter *
+DetectionLogWriter::Get ()
+{
+  static DetectionLogWriter writer;
+  return s_destroyed ? 0 : &writer;
+}
+
+std::ofstream &
+DetectionLogWriter::GetStream (const std::string &name, bool binary)
+{
+  std::map<std::string, std::ofstream *>::iterator i = m_files.find (name);
+  if (i != m_files.end ())
+    {
+      return *i->second;
+    }
+  std::ios::openmode mode = std::ios::out | std::ios::app;
+  if (binary)
+    {
+      mode |= std::ios::binary;
+    }
+  std::ofstream *os = new std::ofstream (name.c_str (), mode);
+  if (!os->is_open ())
+    {
+      NS_LOG_WARN ("Could not open detection trace " << name);
+    }
+  m_files[name] = os;
+  return *os;
+}
+
+void
+DetectionLogWriter::Register (DetectionLog *log)
+{
+  m_logs.insert (log);
+}
+
+void
+DetectionLogWriter::Unregister (DetectionLog *log)
+{
+  m_logs.erase (log);
+}
+
+void
+DetectionLogWriter::FlushAll ()
+{
+  NS_LOG_FUNCTION (this);
+  // 同じファイルに書くノードの記録をまとめ、記録した順に並べてから書く
+  typedef std::map<std::pair<DetectionLog::Format, std::string>, std::vector<DetectionRecord> > Chunks;
+  Chunks chunks;
+  for (std::set<DetectionLog *>::iterator i = m_logs.begin (); i != m_logs.end (); ++i)
+    {
+      DetectionLog *log = *i;
+      if (log->m_buffer.empty ())
+        {
+          continue;
+        }
+      if (log->m_format != DetectionLog::NONE)
+        {
+          std::vector<DetectionRecord> &chunk = chunks[std::make_pair (log->m_format, log->m_fileName)];
+          chunk.insert (chunk.end (), log->m_buffer.begin (), log->m_buffer.end ());
+        }
+      log->m_buffer.clear ();
+    }
+  for (Chunks::iterator i = chunks.begin (); i != chunks.end (); ++i)
+    {
+      std::sort (i->second.begin (), i->second.end (), &IsRecordedBefore);
+      Write (i->first.first, i->first.second, i->second);
+    }
+}
+
+void
+DetectionLogWriter::Write (DetectionLog::Format format, const std::string &fileName,
+                           const std::vector<DetectionRecord> &records)
+{
+  NS_LOG_FUNCTION (this << format << fileName << records.size ());
+  switch (format)
+    {
+    case DetectionLog::NONE:
+      break;
+    case DetectionLog::LEGACY:
+      for (std::vector<DetectionRecord>::const_iterator i = records.begin (); i != records.end (); ++i)
+        {
+          WriteLegacy (*i);
+        }
+      break;
+    case DetectionLog::CSV:
+      {
+        std::string name = fileName + ".csv";
+        bool header = m_files.find (name) == m_files.end ()
+          && !std::ifstream (name.c_str ()).good ();
+        std::ofstream &os = GetStream (name, false);
+        if (header)
+          {
+            os << "time_ns,node,event,reason,value,address\n";
+          }
+        for (std::vector<DetectionRecord>::const_iterator i = records.begin (); i != records.end (); ++i)
+          {
+            os << i->m_time << ',' << i->m_node << ',' << uint32_t (i->m_type) << ','
+               << uint32_t (i->m_reason) << ',' << i->m_value << ','
+               << Ipv4Address (i->m_address) << '\n';
+          }
+        break;
+      }
+    case DetectionLog::BINARY:
+      {
+        std::ofstream &os = GetStream (fileName + ".bin", true);
+        std::vector<char> buf;
+        buf.reserve (records.size () * 22);
+        for (std::vector<DetectionRecord>::const_iterator i = records.begin (); i != records.end (); ++i)
+          {
+            uint64_t t = i->m_time;
+            for (uint32_t k = 0; k < 8; k++)
+              {
+                buf.push_back (static_cast<char> ((t >> (8 * k)) & 0xff));
+              }
+            uint32_t words[] = { i->m_node, i->m_value, i->m_address };
+            for (uint32_t w = 0; w < 3; w++)
+              {
+                if (w == 1)
+                  {
+                    buf.push_back (static_cast<char> (i->m_type));
+                    buf.push_back (static_cast<char> (i->m_reason));
+                  }
+                for (uint32_t k = 0; k < 4; k++)
+                  {
+                    buf.push_back (static_cast<char> ((words[w] >> (8 * k)) & 0xff));
+                  }
+              }
+          }
+        os.write (&buf[0], buf.size ());
+        break;
+      }
+    }
+  for (std::map<std::string, std::ofstream *>::iterator i = m_files.begin (); i != m_files.end (); ++i)
+    {
+      i->second->flush ();
+    }
+}
+
+void
+DetectionLogWriter::WriteLegacy (const DetectionRecord &r)
+{
+  switch (r.m_type)
+    {
+    case DETECTION_RREP_RECEIVED:
+      GetStream ("com_num.txt", false) << "1\n";
+      break;
+    case DETECTION_WH_ENDPOINT_RREP:
+      GetStream ("WH_count.txt", false) << "1\n";
+      break;
+    case DETECTION_CTRL_PAYLOAD:
+      GetStream ("sample.txt", false) << r.m_value << "\n";
+      break;
+    case DETECTION_MISDETECTION:
+      {
+        std::ofstream &os = GetStream ("test.log", false);
+        switch (r.m_reason)
+          {
+          case MISDETECTION_WH_ENDPOINT:
+            os << "WHノード自身がRREP受信したため，にWHリンクを正常リンクとご判定";
+            break;
+          case MISDETECTION_RREP_NEIGHBOR:
+            os << "RREP受信時にWHリンクを正常リンクとご判定";
+            break;
+          case MISDETECTION_WHE_NEIGHBOR:
+            os << "WHE受信時にWHリンクを正常リンクとご判定";
+            break;
+          case MISDETECTION_TIMEOUT:
+            os << "タイムアウトにより、正常ノードをご検知";
+            break;
+          default:
+            break;
+          }
+        os << "  ノードID：" << r.m_node
+           << "   シミュレーション時間：" << Time (r.m_time);
+        if (r.m_reason == MISDETECTION_RREP_NEIGHBOR || r.m_reason == MISDETECTION_WHE_NEIGHBOR)
+          {
+            os << "共通隣接ノード：" << Ipv4Address (r.m_address);
+          }
+        os << "\n";
+        break;
+      }
+    default:
+      break;
+    }
+}
+
+void
+DetectionLogWriter::Close ()
+{
+  NS_LOG_FUNCTION (this);
+  for (std::map<std::string, std::ofstream *>::iterator i = m_files.begin (); i != m_files.end (); ++i)
+    {
+      i->second->close ();
+      delete i->second;
+    }
+  m_files.clear ();
+}
+
+} // namespace aodv
+} // namespace ns3
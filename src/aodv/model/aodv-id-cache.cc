@@ -26,7 +26,6 @@
  *          Pavel Boyko <boyko@iitp.ru>
  */
 #include "aodv-id-cache.h"
-#include <algorithm>
 
 namespace ns3 {
 namespace aodv {
@@ -34,26 +33,24 @@ bool
 IdCache::IsDuplicate (Ipv4Address addr, uint32_t id)
 {
   Purge ();
-  for (std::vector<UniqueId>::const_iterator i = m_idCache.begin ();
-       i != m_idCache.end (); ++i)
+  uint64_t key = GetKey (addr, id);
+  Time expire = m_lifetime + Simulator::Now ();
+  if (!m_idCache.insert (std::make_pair (key, expire)).second)
     {
-      if (i->m_context == addr && i->m_id == id)
-        {
-          return true;
-        }
+      return true;
     }
-  struct UniqueId uniqueId =
-  {
-    addr, id, m_lifetime + Simulator::Now ()
-  };
-  m_idCache.push_back (uniqueId);
+  m_expiry.push (std::make_pair (expire, key));
   return false;
 }
 void
 IdCache::Purge ()
 {
-  m_idCache.erase (remove_if (m_idCache.begin (), m_idCache.end (),
-                              IsExpired ()), m_idCache.end ());
+  Time now = Simulator::Now ();
+  while (!m_expiry.empty () && m_expiry.top ().first < now)
+    {
+      m_idCache.erase (m_expiry.top ().second);
+      m_expiry.pop ();
+    }
 }
 
 uint32_t
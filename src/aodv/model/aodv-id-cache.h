@@ -32,6 +32,9 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
 #include <vector>
+#include <queue>
+#include <functional>
+#include <unordered_map>
 
 namespace ns3 {
 namespace aodv {
@@ -39,6 +42,9 @@ namespace aodv {
  * \ingroup aodv
  *
  * \brief Unique packets identification cache used for simple duplicate detection.
+ *
+ * The (address, ID) pairs are hashed, and their expire times are kept in a
+ * min-heap so that Purge only visits the expired records.
  */
 class IdCache
 {
@@ -80,34 +86,21 @@ public:
     return m_lifetime;
   }
 private:
-  /// Unique packet ID
-  struct UniqueId
-  {
-    /// ID is supposed to be unique in single address context (e.g. sender address)
-    Ipv4Address m_context;
-    /// The id
-    uint32_t m_id;
-    /// When record will expire
-    Time m_expire;
-  };
   /**
-   * \brief IsExpired structure
+   * \param addr the IP address
+   * \param id the ID
+   * \returns the key of the (addr, id) pair
    */
-  struct IsExpired
+  static uint64_t GetKey (Ipv4Address addr, uint32_t id)
   {
-    /**
-     * \brief Check if the entry is expired
-     *
-     * \param u UniqueId entry
-     * \return true if expired, false otherwise
-     */
-    bool operator() (const struct UniqueId & u) const
-    {
-      return (u.m_expire < Simulator::Now ());
-    }
-  };
-  /// Already seen IDs
-  std::vector<UniqueId> m_idCache;
+    return (static_cast<uint64_t> (addr.Get ()) << 32) | id;
+  }
+  /// Already seen IDs and when they expire
+  std::unordered_map<uint64_t, Time> m_idCache;
+  /// (expire time, key) pair of the expiry heap
+  typedef std::pair<Time, uint64_t> ExpiryItem;
+  /// Min-heap of expire times, one item per record
+  std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiry;
   /// Default lifetime for ID records
   Time m_lifetime;
 };
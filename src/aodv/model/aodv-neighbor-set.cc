@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "aodv-neighbor-set.h"
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+namespace ns3 {
+namespace aodv {
+
+NeighborSet::NeighborSet ()
+{
+}
+
+NeighborSet::NeighborSet (const std::vector<Ipv4Address> &list)
+{
+  Assign (list);
+}
+
+void
+NeighborSet::Assign (const std::vector<Ipv4Address> &list)
+{
+  m_addr.resize (list.size ());
+  for (uint32_t i = 0; i < list.size (); ++i)
+    {
+      m_addr[i] = list[i].Get ();
+    }
+  if (!std::is_sorted (m_addr.begin (), m_addr.end ()))
+    {
+      std::sort (m_addr.begin (), m_addr.end ());
+    }
+  m_addr.erase (std::unique (m_addr.begin (), m_addr.end ()), m_addr.end ());
+}
+
+std::vector<Ipv4Address>
+NeighborSet::GetList () const
+{
+  std::vector<Ipv4Address> list;
+  list.reserve (m_addr.size ());
+  for (std::vector<uint32_t>::const_iterator i = m_addr.begin (); i != m_addr.end (); ++i)
+    {
+      list.push_back (Ipv4Address (*i));
+    }
+  return list;
+}
+
+bool
+NeighborSet::Contains (Ipv4Address addr) const
+{
+  return std::binary_search (m_addr.begin (), m_addr.end (), addr.Get ());
+}
+
+uint32_t
+NeighborSet::CountCommon (const NeighborSet &other) const
+{
+  const uint32_t *a = m_addr.empty () ? 0 : &m_addr[0];
+  const uint32_t *b = other.m_addr.empty () ? 0 : &other.m_addr[0];
+  uint32_t na = m_addr.size ();
+  uint32_t nb = other.m_addr.size ();
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t n = 0;
+  // 分岐なしのマージ（比較結果だけで添字を進める）
+  while (i < na && j < nb)
+    {
+      uint32_t x = a[i];
+      uint32_t y = b[j];
+      n += (x == y);
+      i += (x <= y);
+      j += (y <= x);
+    }
+  return n;
+}
+
+double
+NeighborSet::Jaccard (const NeighborSet &other) const
+{
+  uint32_t common = CountCommon (other);
+  uint32_t all = GetSize () + other.GetSize () - common;
+  if (all == 0)
+    {
+      return 0.0;
+    }
+  return static_cast<double> (common) / all;
+}
+
+std::vector<Ipv4Address>
+NeighborSet::GetDifference (const NeighborSet &other) const
+{
+  std::vector<uint32_t> d;
+  std::set_difference (m_addr.begin (), m_addr.end (), other.m_addr.begin (), other.m_addr.end (),
+                       std::back_inserter (d));
+  std::vector<Ipv4Address> list;
+  list.reserve (d.size ());
+  for (std::vector<uint32_t>::const_iterator i = d.begin (); i != d.end (); ++i)
+    {
+      list.push_back (Ipv4Address (*i));
+    }
+  return list;
+}
+
+void
+NeighborSet::Apply (const std::vector<Ipv4Address> &added, const std::vector<Ipv4Address> &removed)
+{
+  NeighborSet gone (removed);
+  std::vector<uint32_t> kept;
+  kept.reserve (m_addr.size () + added.size ());
+  std::set_difference (m_addr.begin (), m_addr.end (), gone.m_addr.begin (), gone.m_addr.end (),
+                       std::back_inserter (kept));
+  for (std::vector<Ipv4Address>::const_iterator i = added.begin (); i != added.end (); ++i)
+    {
+      kept.push_back (i->Get ());
+    }
+  std::sort (kept.begin (), kept.end ());
+  kept.erase (std::unique (kept.begin (), kept.end ()), kept.end ());
+  m_addr.swap (kept);
+}
+
+uint32_t
+NeighborSet::GetDigest () const
+{
+  // FNV-1a（0 は「参照なし」に使うので避ける）
+  uint32_t h = 2166136261u;
+  for (std::vector<uint32_t>::const_iterator i = m_addr.begin (); i != m_addr.end (); ++i)
+    {
+      for (uint32_t shift = 0; shift < 32; shift += 8)
+        {
+          h ^= (*i >> shift) & 0xff;
+          h *= 16777619u;
+        }
+    }
+  return h == 0 ? 1 : h;
+}
+
+NeighborBloomFilter::NeighborBloomFilter (uint8_t words)
+  : m_words (std::max<uint8_t> (words, 1), 0)
+{
+}
+
+uint32_t
+NeighborBloomFilter::GetBit (Ipv4Address addr, uint32_t k) const
+{
+  // ダブルハッシュ h1 + k * h2（h2 は奇数）
+  uint32_t x = addr.Get ();
+  x ^= x >> 16;
+  x *= 0x7feb352d;
+  x ^= x >> 15;
+  x *= 0x846ca68b;
+  x ^= x >> 16;
+  uint32_t h1 = x;
+  uint32_t h2 = ((x >> 11) | (x << 21)) | 1;
+  return (h1 + k * h2) % (m_words.size () * 32);
+}
+
+void
+NeighborBloomFilter::Add (Ipv4Address addr)
+{
+  for (uint32_t k = 0; k < HASHES; k++)
+    {
+      uint32_t b = GetBit (addr, k);
+      m_words[b / 32] |= (1u << (b % 32));
+    }
+}
+
+bool
+NeighborBloomFilter::MayContain (Ipv4Address addr) const
+{
+  for (uint32_t k = 0; k < HASHES; k++)
+    {
+      uint32_t b = GetBit (addr, k);
+      if ((m_words[b / 32] & (1u << (b % 32))) == 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+double
+NeighborBloomFilter::GetFalsePositiveRate (uint32_t n) const
+{
+  double bits = m_words.size () * 32.0;
+  return std::pow (1.0 - std::exp (-(double (HASHES) * n) / bits), HASHES);
+}
+
+} // namespace aodv
+} // namespace ns3
@@ -39,26 +39,54 @@ NS_LOG_COMPONENT_DEFINE ("AodvNeighbors");
 
 namespace aodv {
 Neighbors::Neighbors (Time delay)
-  : m_ntimer (Timer::CANCEL_ON_DESTROY)
+  : m_ntimer (Timer::CANCEL_ON_DESTROY),
+    m_closePending (false),
+    m_helloVersion (0),
+    m_helloListValid (false)
 {
   m_ntimer.SetDelay (delay);
   m_ntimer.SetFunction (&Neighbors::Purge, this);
   m_txErrorCallback = MakeCallback (&Neighbors::ProcessTxError, this);
 }
 
+Neighbors::Neighbor *
+Neighbors::Find (Ipv4Address addr)
+{
+  std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>::const_iterator i = m_index.find (addr);
+  if (i == m_index.end ())
+    {
+      return 0;
+    }
+  return &m_nb[i->second];
+}
+
+void
+Neighbors::PushExpiry (const Neighbor &n)
+{
+  m_expiry.push (std::make_pair (n.m_expireTime, n.m_neighborAddress));
+}
+
+void
+Neighbors::RebuildIndex ()
+{
+  m_index.clear ();
+  for (uint32_t i = 0; i < m_nb.size (); ++i)
+    {
+      m_index[m_nb[i].m_neighborAddress] = i;
+    }
+}
+
+void
+Neighbors::InvalidateHelloList ()
+{
+  m_helloListValid = false;
+}
+
 bool
 Neighbors::IsNeighbor (Ipv4Address addr)
 {
   Purge ();
-  for (std::vector<Neighbor>::const_iterator i = m_nb.begin ();
-       i != m_nb.end (); ++i)
-    {
-      if (i->m_neighborAddress == addr)
-        {
-          return true;
-        }
-    }
-  return false;
+  return Find (addr) != 0;
 }
 
 //隣接ノード情報を取得
@@ -67,50 +95,58 @@ std::vector<Ipv4Address> Neighbors::GetNeighborList ()
   //printf("隣接リスト取得\n");
   Purge ();
 
-  
-
-  // for (std::vector<Neighbor>::const_iterator i = m_nb.begin ();
-  //      i != m_nb.end (); ++i)
-  //   {
-  //     printf("ループ回数：%d\n", j);
-  //     List[j] = i -> m_neighborAddress;
-  //     j++;
-  //   }
-
-  int size = m_nb.size();
-
   std::vector<Ipv4Address> IpList;
-
-  for(int i = 0; i < size;i++ )
-  {
-  auto neighbor = m_nb.at(i);
-  Ipv4Address neighborid = neighbor.m_neighborAddress;
-  IpList.push_back(neighborid);
-  }
-
-  //printf("取得終了\n");
-
-
+  IpList.reserve (m_nb.size ());
+  for (std::vector<Neighbor>::const_iterator i = m_nb.begin (); i != m_nb.end (); ++i)
+    {
+      IpList.push_back (i->m_neighborAddress);
+    }
   return IpList;
 }
 
-std::vector<Ipv4Address>
+const std::vector<Ipv4Address> &
 Neighbors::GetHelloNeighborList ()
 {
   Purge ();
 
-  std::vector<Ipv4Address> ipList;
   Time now = Simulator::Now ();
+  // Hello 由来の期限切れでメンバーが変わる時刻を過ぎたら作り直す
+  if (m_helloListValid && now >= m_helloListExpire)
+    {
+      InvalidateHelloList ();
+    }
+  if (m_helloListValid)
+    {
+      return m_helloList;
+    }
 
-  for (const auto &n : m_nb)
+  std::vector<Ipv4Address> ipList;
+  ipList.reserve (m_nb.size ());
+  m_helloListExpire = Time::Max ();
+  for (std::vector<Neighbor>::const_iterator i = m_nb.begin (); i != m_nb.end (); ++i)
     {
       // ★Helloを受信していて、Hello由来の期限が切れていないものだけ
-      if (n.m_seenHello && n.m_helloExpireTime > now)
+      if (i->m_seenHello && i->m_helloExpireTime > now)
         {
-          ipList.push_back (n.m_neighborAddress);
+          ipList.push_back (i->m_neighborAddress);
+          m_helloListExpire = std::min (m_helloListExpire, i->m_helloExpireTime);
         }
     }
-  return ipList;
+  std::sort (ipList.begin (), ipList.end ());
+  if (ipList != m_helloList)
+    {
+      m_helloList.swap (ipList);
+      m_helloVersion++;
+    }
+  m_helloListValid = true;
+  return m_helloList;
+}
+
+uint32_t
+Neighbors::GetHelloNeighborVersion ()
+{
+  GetHelloNeighborList ();
+  return m_helloVersion;
 }
 
   std::vector<Ipv4Address> Neighbors::NeighborList ()
@@ -124,13 +160,10 @@ Time
 Neighbors::GetExpireTime (Ipv4Address addr)
 {
   Purge ();
-  for (std::vector<Neighbor>::const_iterator i = m_nb.begin (); i
-       != m_nb.end (); ++i)
+  Neighbor *n = Find (addr);
+  if (n != 0)
     {
-      if (i->m_neighborAddress == addr)
-        {
-          return (i->m_expireTime - Simulator::Now ());
-        }
+      return (n->m_expireTime - Simulator::Now ());
     }
   return Seconds (0);
 }
@@ -138,23 +171,27 @@ Neighbors::GetExpireTime (Ipv4Address addr)
 void
 Neighbors::Update (Ipv4Address addr, Time expire)
 {
-  for (std::vector<Neighbor>::iterator i = m_nb.begin (); i != m_nb.end (); ++i)
+  Neighbor *i = Find (addr);
+  if (i != 0)
     {
-      if (i->m_neighborAddress == addr)
+      Time t = std::max (expire + Simulator::Now (), i->m_expireTime);
+      if (t != i->m_expireTime)
         {
-          i->m_expireTime
-            = std::max (expire + Simulator::Now (), i->m_expireTime);
-          if (i->m_hardwareAddress == Mac48Address ())
-            {
-              i->m_hardwareAddress = LookupMacAddress (i->m_neighborAddress);
-            }
-          return;
+          i->m_expireTime = t;
+          PushExpiry (*i);
+        }
+      if (i->m_hardwareAddress == Mac48Address ())
+        {
+          i->m_hardwareAddress = LookupMacAddress (i->m_neighborAddress);
         }
+      return;
     }
 
   NS_LOG_LOGIC ("Open link to " << addr);
   Neighbor neighbor (addr, LookupMacAddress (addr), expire + Simulator::Now ());
+  m_index[addr] = m_nb.size ();
   m_nb.push_back (neighbor);
+  PushExpiry (neighbor);
   Purge ();
 }
 
@@ -164,24 +201,32 @@ Neighbors::UpdateFromHello (Ipv4Address addr, Time helloExpire)
   // helloExpire は「相対時間（Seconds(...)）」で渡す想定にする
   Time absExpire = helloExpire + Simulator::Now ();
 
-  for (auto i = m_nb.begin (); i != m_nb.end (); ++i)
+  Neighbor *i = Find (addr);
+  if (i != 0)
     {
-      if (i->m_neighborAddress == addr)
+      // 近傍の一般期限も伸ばす（Updateと同様）
+      if (absExpire > i->m_expireTime)
+        {
+          i->m_expireTime = absExpire;
+          PushExpiry (*i);
+        }
+
+      // 新しく Hello 隣接になった場合だけキャッシュを無効化
+      if (!i->m_seenHello || i->m_helloExpireTime <= Simulator::Now ())
         {
-          // 近傍の一般期限も伸ばす（Updateと同様）
-          i->m_expireTime = std::max (absExpire, i->m_expireTime);
+          InvalidateHelloList ();
+        }
 
-          // ★Hello由来期限/フラグ（あなたが追加したもの）
-          i->m_seenHello = true;
-          i->m_helloExpireTime = std::max (absExpire, i->m_helloExpireTime);
+      // ★Hello由来期限/フラグ（あなたが追加したもの）
+      i->m_seenHello = true;
+      i->m_helloExpireTime = std::max (absExpire, i->m_helloExpireTime);
 
-          // ★MACは渡さない。未知なら従来と同じく補完。
-          if (i->m_hardwareAddress == Mac48Address ())
-            {
-              i->m_hardwareAddress = LookupMacAddress (i->m_neighborAddress);
-            }
-          return;
+      // ★MACは渡さない。未知なら従来と同じく補完。
+      if (i->m_hardwareAddress == Mac48Address ())
+        {
+          i->m_hardwareAddress = LookupMacAddress (i->m_neighborAddress);
         }
+      return;
     }
 
   NS_LOG_LOGIC ("Open link (hello) to " << addr);
@@ -190,7 +235,10 @@ Neighbors::UpdateFromHello (Ipv4Address addr, Time helloExpire)
   neighbor.m_seenHello = true;
   neighbor.m_helloExpireTime = absExpire;
 
+  m_index[addr] = m_nb.size ();
   m_nb.push_back (neighbor);
+  PushExpiry (neighbor);
+  InvalidateHelloList ();
   Purge ();
 }
 
@@ -220,6 +268,28 @@ Neighbors::Purge ()
       return;
     }
 
+  // 期限切れ候補をヒープから取り出す。延長済みの古い項目は読み捨てる
+  Time now = Simulator::Now ();
+  bool expired = m_closePending;
+  while (!m_expiry.empty () && m_expiry.top ().first < now)
+    {
+      Neighbor *n = Find (m_expiry.top ().second);
+      if (n != 0 && n->m_expireTime < now)
+        {
+          expired = true;
+        }
+      m_expiry.pop ();
+    }
+  if (!expired)
+    {
+      if (!m_ntimer.IsRunning ())
+        {
+          m_ntimer.Schedule ();
+        }
+      return;
+    }
+  m_closePending = false;
+
   CloseNeighbor pred;
   if (!m_handleLinkFailure.IsNull ())
     {
@@ -232,11 +302,30 @@ Neighbors::Purge ()
             }
         }
     }
+  for (std::vector<Neighbor>::const_iterator j = m_nb.begin (); j != m_nb.end (); ++j)
+    {
+      if (pred (*j) && j->m_seenHello && j->m_helloExpireTime > now)
+        {
+          InvalidateHelloList ();
+          break;
+        }
+    }
   m_nb.erase (std::remove_if (m_nb.begin (), m_nb.end (), pred), m_nb.end ());
+  RebuildIndex ();
   m_ntimer.Cancel ();
   m_ntimer.Schedule ();
 }
 
+void
+Neighbors::Clear ()
+{
+  m_nb.clear ();
+  m_index.clear ();
+  m_expiry = std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > ();
+  m_closePending = false;
+  InvalidateHelloList ();
+}
+
 void
 Neighbors::ScheduleTimer ()
 {
@@ -283,6 +372,7 @@ Neighbors::ProcessTxError (WifiMacHeader const & hdr)
       if (i->m_hardwareAddress == addr)
         {
           i->close = true;
+          m_closePending = true;
         }
     }
   Purge ();
@@ -30,11 +30,14 @@
 #define AODVNEIGHBOR_H
 
 #include <vector>
+#include <queue>
+#include <functional>
 #include "ns3/simulator.h"
 #include "ns3/timer.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/callback.h"
 #include "ns3/arp-cache.h"
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -103,7 +106,16 @@ public:
   //隣接ノード情報を取得
   std::vector<Ipv4Address> GetNeighborList ();
 
-  std::vector<Ipv4Address> GetHelloNeighborList ();         // ★追加
+  /**
+   * Hello 由来の隣接ノード一覧（アドレス昇順）。
+   * メンバーが変わった時だけ再構築されるキャッシュへの参照を返す。
+   * \returns the sorted list of neighbors heard through HELLO
+   */
+  const std::vector<Ipv4Address> & GetHelloNeighborList ();         // ★追加
+  /**
+   * \returns version of the HELLO neighbor list, incremented whenever its membership changes
+   */
+  uint32_t GetHelloNeighborVersion ();
 
   std::vector<Ipv4Address> NeighborList ();
 
@@ -119,10 +131,7 @@ public:
   /// Schedule m_ntimer.
   void ScheduleTimer ();
   /// Remove all entries
-  void Clear ()
-  {
-    m_nb.clear ();
-  }
+  void Clear ();
 
   /**
    * Add ARP cache to be used to allow layer 2 notifications processing
@@ -169,6 +178,38 @@ private:
   Timer m_ntimer;
   /// vector of entries
   std::vector<Neighbor> m_nb;
+  /// address -> position in m_nb
+  std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> m_index;
+  /// (expire time, address) pair of the expiry heap
+  typedef std::pair<Time, Ipv4Address> ExpiryItem;
+  /// Min-heap of expire times.  Extended entries leave stale items behind which are skipped on pop.
+  std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiry;
+  /// true if some entry was marked close by a TX error
+  bool m_closePending;
+  /// cached HELLO neighbor list
+  std::vector<Ipv4Address> m_helloList;
+  /// HELLO neighbor list version
+  uint32_t m_helloVersion;
+  /// false if m_helloList has to be rebuilt
+  bool m_helloListValid;
+  /// earliest HELLO expire time of the cached members
+  Time m_helloListExpire;
+
+  /**
+   * Find entry by address
+   * \param addr the IP address
+   * \returns pointer to the entry or 0
+   */
+  Neighbor * Find (Ipv4Address addr);
+  /**
+   * Add expire time of an entry to the expiry heap
+   * \param n the entry
+   */
+  void PushExpiry (const Neighbor &n);
+  /// Rebuild m_index after entries were removed
+  void RebuildIndex ();
+  /// Invalidate the cached HELLO neighbor list
+  void InvalidateHelloList ();
   /// list of ARP cached to be used for layer 2 notifications processing
   std::vector<Ptr<ArpCache> > m_arp;
 
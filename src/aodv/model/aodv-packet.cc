@@ -29,10 +29,219 @@
 #include "ns3/address-utils.h"
 #include "ns3/packet.h"
 #include "ns3/aodv-neighbor.h"
+#include <algorithm>
 
 namespace ns3 {
 namespace aodv {
 
+//-----------------------------------------------------------------------------
+// Neighbor list encoding shared by RREP and WHE
+//-----------------------------------------------------------------------------
+
+/**
+ * \param v the value
+ * \returns number of bytes of v in LEB128 varint coding
+ */
+static uint32_t
+GetVarintSize (uint32_t v)
+{
+  uint32_t n = 1;
+  while (v >= 0x80)
+    {
+      v >>= 7;
+      n++;
+    }
+  return n;
+}
+
+/**
+ * \param list the neighbor list
+ * \param n number of entries of list to use
+ * \returns the first n addresses in ascending host order
+ */
+static std::vector<uint32_t>
+GetSortedAddresses (const std::vector<Ipv4Address> &list, uint16_t n)
+{
+  std::vector<uint32_t> v (n);
+  for (uint16_t j = 0; j < n; j++)
+    {
+      v[j] = list.at (j).Get ();
+    }
+  std::sort (v.begin (), v.end ());
+  return v;
+}
+
+/**
+ * \param e the encoding
+ * \param list the neighbor list
+ * \param n number of entries
+ * \returns the encoded size in bytes
+ */
+static uint32_t
+GetNeighborListSerializedSize (NeighborListEncoding e, const std::vector<Ipv4Address> &list, uint16_t n,
+                               const NeighborBloomFilter &bloom)
+{
+  switch (e)
+    {
+    case NEIGHBOR_LIST_DELTA:
+      {
+        if (n == 0)
+          {
+            return 0;
+          }
+        std::vector<uint32_t> v = GetSortedAddresses (list, n);
+        uint32_t size = 4;
+        for (uint16_t j = 1; j < n; j++)
+          {
+            size += GetVarintSize (v[j] - v[j - 1]);
+          }
+        return size;
+      }
+    case NEIGHBOR_LIST_BLOOM:
+      return 1 + 4 * bloom.GetWords ().size ();
+    case NEIGHBOR_LIST_REF:
+      return 4;
+    default:
+      return 4 * n;
+    }
+}
+
+/**
+ * \param i the buffer iterator
+ * \param e the encoding
+ * \param list the neighbor list
+ * \param n number of entries
+ * \param bloom the filter written when list holds no addresses (re-serialized Bloom header)
+ * \param digest the digest written for NEIGHBOR_LIST_REF
+ */
+static void
+SerializeNeighborList (Buffer::Iterator &i, NeighborListEncoding e, const std::vector<Ipv4Address> &list,
+                       uint16_t n, const NeighborBloomFilter &bloom, uint32_t digest)
+{
+  switch (e)
+    {
+    case NEIGHBOR_LIST_DELTA:
+      {
+        if (n == 0)
+          {
+            return;
+          }
+        std::vector<uint32_t> v = GetSortedAddresses (list, n);
+        i.WriteHtonU32 (v[0]);
+        for (uint16_t j = 1; j < n; j++)
+          {
+            uint32_t d = v[j] - v[j - 1];
+            while (d >= 0x80)
+              {
+                i.WriteU8 (static_cast<uint8_t> (d | 0x80));
+                d >>= 7;
+              }
+            i.WriteU8 (static_cast<uint8_t> (d));
+          }
+        break;
+      }
+    case NEIGHBOR_LIST_BLOOM:
+      {
+        const std::vector<uint32_t> &words = bloom.GetWords ();
+        i.WriteU8 (static_cast<uint8_t> (words.size ()));
+        for (std::vector<uint32_t>::const_iterator w = words.begin (); w != words.end (); ++w)
+          {
+            i.WriteHtonU32 (*w);
+          }
+        break;
+      }
+    case NEIGHBOR_LIST_REF:
+      i.WriteHtonU32 (digest);
+      break;
+    default:
+      for (uint16_t j = 0; j < n; j++)
+        {
+          WriteTo (i, list.at (j));
+        }
+      break;
+    }
+}
+
+/**
+ * \param i the buffer iterator
+ * \param e the encoding
+ * \param n number of entries
+ * \param list the decoded list (empty for NEIGHBOR_LIST_BLOOM and NEIGHBOR_LIST_REF)
+ * \param bloom the decoded filter
+ * \param digest the decoded digest
+ */
+static void
+DeserializeNeighborList (Buffer::Iterator &i, NeighborListEncoding e, uint16_t n,
+                         std::vector<Ipv4Address> &list, NeighborBloomFilter &bloom, uint32_t &digest)
+{
+  list.clear ();
+  switch (e)
+    {
+    case NEIGHBOR_LIST_DELTA:
+      {
+        if (n == 0)
+          {
+            return;
+          }
+        uint32_t v = i.ReadNtohU32 ();
+        list.push_back (Ipv4Address (v));
+        for (uint16_t j = 1; j < n; j++)
+          {
+            uint32_t d = 0;
+            uint32_t shift = 0;
+            uint8_t b;
+            do
+              {
+                b = i.ReadU8 ();
+                d |= static_cast<uint32_t> (b & 0x7f) << shift;
+                shift += 7;
+              }
+            while (b & 0x80);
+            v += d;
+            list.push_back (Ipv4Address (v));
+          }
+        break;
+      }
+    case NEIGHBOR_LIST_BLOOM:
+      {
+        std::vector<uint32_t> words (i.ReadU8 ());
+        for (uint32_t w = 0; w < words.size (); w++)
+          {
+            words[w] = i.ReadNtohU32 ();
+          }
+        bloom.SetWords (words);
+        break;
+      }
+    case NEIGHBOR_LIST_REF:
+      digest = i.ReadNtohU32 ();
+      break;
+    default:
+      for (uint16_t j = 0; j < n; j++)
+        {
+          Ipv4Address neighbor;
+          ReadFrom (i, neighbor);
+          list.push_back (neighbor);
+        }
+      break;
+    }
+}
+
+/**
+ * \param list the neighbor list
+ * \param n number of entries
+ * \returns Bloom filter of the first n addresses
+ */
+static NeighborBloomFilter
+MakeNeighborFilter (const std::vector<Ipv4Address> &list, uint16_t n)
+{
+  NeighborBloomFilter bloom;
+  for (uint16_t j = 0; j < n && j < list.size (); j++)
+    {
+      bloom.Add (list[j]);
+    }
+  return bloom;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (TypeHeader);
 
 TypeHeader::TypeHeader (MessageType t)
@@ -161,7 +370,8 @@ RreqHeader::RreqHeader (uint8_t flags, uint8_t reserved, uint8_t hopCount, uint3
     m_dst (dst),
     m_dstSeqNo (dstSeqNo),
     m_origin (origin),
-    m_originSeqNo (originSeqNo)
+    m_originSeqNo (originSeqNo),
+    m_WHForwardFlag (0)
 {
 }
 
@@ -323,8 +533,9 @@ RrepHeader::RrepHeader (uint8_t prefixSize, uint8_t hopCount, Ipv4Address dst,
     m_origin (origin),
     m_list (List),
     m_size (size),
-    m_id(id)
-    
+    m_id(id),
+    m_WHForwardFlag (0),
+    m_digest (0)
 {
   m_lifeTime = uint32_t (lifeTime.GetMilliSeconds ());
 }
@@ -355,10 +566,33 @@ RrepHeader::GetSerializedSize () const
   return 25
          + 4 //nextnode 
          + 1 //WH転送フラグ
-         + 4 * m_size;
+         + GetNeighborListSize ();
   //return 19;
 }
 
+uint32_t
+RrepHeader::GetNeighborListSize () const
+{
+  NeighborListEncoding e = GetNeighborEncoding ();
+  if (e == NEIGHBOR_LIST_BLOOM && m_list.size () >= m_size && m_size > 0)
+    {
+      return GetNeighborListSerializedSize (e, m_list, m_size, MakeNeighborFilter (m_list, m_size));
+    }
+  return GetNeighborListSerializedSize (e, m_list, m_size, m_bloom);
+}
+
+void
+RrepHeader::SetNeighborEncoding (NeighborListEncoding e)
+{
+  m_flags = (m_flags & ~0x03) | (static_cast<uint8_t> (e) & 0x03);
+}
+
+NeighborListEncoding
+RrepHeader::GetNeighborEncoding () const
+{
+  return static_cast<NeighborListEncoding> (m_flags & 0x03);
+}
+
 void
 RrepHeader::Serialize (Buffer::Iterator i) const
 {
@@ -374,15 +608,16 @@ RrepHeader::Serialize (Buffer::Iterator i) const
   WriteTo (i, m_nextnode);
   i.WriteU8(m_WHForwardFlag);
 
-  //隣接リスト表示
-  for(int j = 0; j < m_size;j++ )
-  {
-    //printf("IPアドレス書き込み\n");
-    Ipv4Address neighbor = m_list.at(j);
-    //printf("書き込んだ値%u\n", neighbor.Get());
-   WriteTo (i, neighbor);
-  }
-
+  //隣接リスト書き込み（符号化方式は m_flags の下位2ビット）
+  NeighborListEncoding e = GetNeighborEncoding ();
+  if (e == NEIGHBOR_LIST_BLOOM && m_list.size () >= m_size && m_size > 0)
+    {
+      SerializeNeighborList (i, e, m_list, m_size, MakeNeighborFilter (m_list, m_size), m_digest);
+    }
+  else
+    {
+      SerializeNeighborList (i, e, m_list, m_size, m_bloom, m_digest);
+    }
 }
 
 uint32_t
@@ -403,21 +638,8 @@ RrepHeader::Deserialize (Buffer::Iterator start)
   m_id = i.ReadU32 ();
   ReadFrom (i, m_nextnode);
   m_WHForwardFlag = i.ReadU8();
-  
-  for(int j = 0; j < m_size;j++ )
-  {
-    //printf("j:%d\n",j);
-    Ipv4Address neighbor;
 
-    ReadFrom (i,neighbor);
-
-    //printf("Des時　IP：%u\n", neighbor.Get());
-
-    m_list.push_back(neighbor);
-
-    neighbor =m_list.at(j);
-    //printf("Des時代入後IP：%u\n", neighbor.Get());
-  }
+  DeserializeNeighborList (i, GetNeighborEncoding (), m_size, m_list, m_bloom, m_digest);
 
 
   uint32_t dist = i.GetDistanceFrom (start);
@@ -516,7 +738,7 @@ RrepHeader::SetHello (Ipv4Address origin, uint32_t srcSeqNo, Time lifetime)
   m_dstSeqNo = srcSeqNo;
   m_origin = origin;
   m_lifeTime = lifetime.GetMilliSeconds ();
-  m_list = {Ipv4Address()};
+  m_list.clear ();
   m_size = 0;
   m_id = 0;
 }
@@ -845,7 +1067,9 @@ WHEHeader::WHEHeader (uint32_t id, Ipv4Address origin, std::vector<Ipv4Address>
   :m_id (id),
   m_origin(origin),
   m_list (List),
-  m_size (size)
+  m_size (size),
+  m_encoding (NEIGHBOR_LIST_RAW),
+  m_digest (0)
 {
 }
 
@@ -874,7 +1098,17 @@ WHEHeader::GetSerializedSize () const
   return 6
          +4 //origin
          + 4 //targetnode 
-         + 4 * m_size;
+         + GetNeighborListSize ();
+}
+
+uint32_t
+WHEHeader::GetNeighborListSize () const
+{
+  if (m_encoding == NEIGHBOR_LIST_BLOOM && m_list.size () >= m_size && m_size > 0)
+    {
+      return GetNeighborListSerializedSize (m_encoding, m_list, m_size, MakeNeighborFilter (m_list, m_size));
+    }
+  return GetNeighborListSerializedSize (m_encoding, m_list, m_size, m_bloom);
 }
 
 void
@@ -882,16 +1116,19 @@ WHEHeader::Serialize (Buffer::Iterator i ) const
 {
   i.WriteHtonU32 (m_id);
   WriteTo(i,m_origin);
-  i.WriteHtonU16 (m_size);
+  // サイズの上位2ビットに隣接リストの符号化方式を入れる
+  NS_ASSERT (m_size < (1 << 14));
+  i.WriteHtonU16 (m_size | (static_cast<uint16_t> (m_encoding) << 14));
   WriteTo (i, m_targetnode);
 
-  //隣接リスト表示
-  for(int j = 0; j < m_size;j++ )
-  {
-    Ipv4Address neighbor = m_list.at(j);
-    
-    WriteTo (i, neighbor);
-  }
+  if (m_encoding == NEIGHBOR_LIST_BLOOM && m_list.size () >= m_size && m_size > 0)
+    {
+      SerializeNeighborList (i, m_encoding, m_list, m_size, MakeNeighborFilter (m_list, m_size), m_digest);
+    }
+  else
+    {
+      SerializeNeighborList (i, m_encoding, m_list, m_size, m_bloom, m_digest);
+    }
 }
 
 uint32_t
@@ -900,18 +1137,12 @@ WHEHeader::Deserialize (Buffer::Iterator start )
   Buffer::Iterator i = start;
   m_id = i.ReadNtohU32 ();
   ReadFrom(i, m_origin);
-  m_size = i.ReadNtohU16 ();
+  uint16_t size = i.ReadNtohU16 ();
+  m_size = size & 0x3fff;
+  m_encoding = static_cast<NeighborListEncoding> (size >> 14);
   ReadFrom(i, m_targetnode);
 
-  for(int j = 0; j < m_size;j++ )
-  {
-    Ipv4Address neighbor;
-
-    ReadFrom (i,neighbor);
-
-    m_list.push_back(neighbor);
-
-  }
+  DeserializeNeighborList (i, m_encoding, m_size, m_list, m_bloom, m_digest);
   uint32_t dist = i.GetDistanceFrom (start);
   NS_ASSERT (dist == GetSerializedSize ());
   return dist;
@@ -935,5 +1166,91 @@ operator<< (std::ostream & os, WHEHeader const & h )
   return os;
 }
 
+//-----------------------------------------------------------------------------
+// Neighbor list delta
+//-----------------------------------------------------------------------------
+
+NeighborDeltaHeader::NeighborDeltaHeader (uint32_t base, std::vector<Ipv4Address> added,
+                                          std::vector<Ipv4Address> removed)
+  : m_base (base),
+    m_added (added),
+    m_removed (removed)
+{
+}
+
+NS_OBJECT_ENSURE_REGISTERED (NeighborDeltaHeader);
+
+TypeId
+NeighborDeltaHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::aodv::NeighborDeltaHeader")
+    .SetParent<Header> ()
+    .SetGroupName ("Aodv")
+    .AddConstructor<NeighborDeltaHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+NeighborDeltaHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+NeighborDeltaHeader::GetSerializedSize () const
+{
+  NeighborBloomFilter none;
+  return 8
+         + GetNeighborListSerializedSize (NEIGHBOR_LIST_DELTA, m_added, m_added.size (), none)
+         + GetNeighborListSerializedSize (NEIGHBOR_LIST_DELTA, m_removed, m_removed.size (), none);
+}
+
+void
+NeighborDeltaHeader::Serialize (Buffer::Iterator i) const
+{
+  NeighborBloomFilter none;
+  i.WriteHtonU32 (m_base);
+  i.WriteHtonU16 (m_added.size ());
+  i.WriteHtonU16 (m_removed.size ());
+  SerializeNeighborList (i, NEIGHBOR_LIST_DELTA, m_added, m_added.size (), none, 0);
+  SerializeNeighborList (i, NEIGHBOR_LIST_DELTA, m_removed, m_removed.size (), none, 0);
+}
+
+uint32_t
+NeighborDeltaHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  NeighborBloomFilter none;
+  uint32_t digest;
+  m_base = i.ReadNtohU32 ();
+  uint16_t added = i.ReadNtohU16 ();
+  uint16_t removed = i.ReadNtohU16 ();
+  DeserializeNeighborList (i, NEIGHBOR_LIST_DELTA, added, m_added, none, digest);
+  DeserializeNeighborList (i, NEIGHBOR_LIST_DELTA, removed, m_removed, none, digest);
+  uint32_t dist = i.GetDistanceFrom (start);
+  NS_ASSERT (dist == GetSerializedSize ());
+  return dist;
+}
+
+void
+NeighborDeltaHeader::Print (std::ostream &os) const
+{
+  os << "base " << m_base << " added " << m_added.size () << " removed " << m_removed.size ();
+}
+
+bool
+NeighborDeltaHeader::operator== (NeighborDeltaHeader const & o) const
+{
+  return (m_base == o.m_base && m_added == o.m_added && m_removed == o.m_removed);
+}
+
+std::ostream &
+operator<< (std::ostream & os, NeighborDeltaHeader const & h)
+{
+  h.Print (os);
+  return os;
+}
+
 }
 }
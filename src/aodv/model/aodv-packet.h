@@ -35,6 +35,7 @@
 #include <map>
 #include "ns3/nstime.h"
 #include "ns3/aodv-neighbor.h"
+#include "aodv-neighbor-set.h"
 #include "ns3/string.h"
 
 namespace ns3 {
@@ -54,6 +55,17 @@ enum MessageType {
 
 };
 
+/**
+* \ingroup aodv
+* \brief Wire encoding of the neighbor list carried in RREP and WHE
+*/
+enum NeighborListEncoding {
+  NEIGHBOR_LIST_RAW = 0,   //!< 4 bytes per address (original format)
+  NEIGHBOR_LIST_DELTA = 1, //!< Sorted list: first address, then varint coded differences
+  NEIGHBOR_LIST_BLOOM = 2, //!< Fixed size Bloom filter of the addresses (approximate)
+  NEIGHBOR_LIST_REF = 3,   //!< Digest of the list announced in the sender's Hellos (see NeighborDeltaHeader)
+};
+
 /**
 * \ingroup aodv
 * \brief AODV types
@@ -530,6 +542,46 @@ public:
     return m_WHForwardFlag;
   }
 
+  /**
+   * \brief Set the wire encoding of the neighbor list (reserved flag bits 0-1)
+   * \param e the encoding
+   */
+  void SetNeighborEncoding (NeighborListEncoding e);
+  /**
+   * \brief Get the wire encoding of the neighbor list
+   * \return the encoding
+   */
+  NeighborListEncoding GetNeighborEncoding () const;
+  /**
+   * \brief Set the digest sent in place of the list with NEIGHBOR_LIST_REF
+   * \param digest the NeighborSet::GetDigest of the list
+   */
+  void SetNeighborDigest (uint32_t digest)
+  {
+    m_digest = digest;
+  }
+  /**
+   * \brief Get the digest of a received NEIGHBOR_LIST_REF header
+   * \return the digest
+   */
+  uint32_t GetNeighborDigest () const
+  {
+    return m_digest;
+  }
+  /**
+   * \brief Get the Bloom filter of a received NEIGHBOR_LIST_BLOOM header
+   * \return the filter
+   */
+  const NeighborBloomFilter & GetNeighborFilter () const
+  {
+    return m_bloom;
+  }
+  /**
+   * \brief Get the number of bytes used by the neighbor list on the wire
+   * \return the encoded list size
+   */
+  uint32_t GetNeighborListSize () const;
+
   // Flags
   /**
    * \brief Set the ack required flag
@@ -583,6 +635,8 @@ private:
   uint32_t m_id;
   Ipv4Address m_nextnode;
   uint8_t m_WHForwardFlag;
+  NeighborBloomFilter m_bloom; ///< Bloom filter of a received NEIGHBOR_LIST_BLOOM list
+  uint32_t m_digest; ///< Digest of the list for NEIGHBOR_LIST_REF
 
   // uint8_t my_size;
   // uint8_t get_size;
@@ -896,6 +950,52 @@ public:
     m_targetnode = target;
   }
 
+  /**
+   * \brief Set the wire encoding of the neighbor list (top bits of the size field)
+   * \param e the encoding
+   */
+  void SetNeighborEncoding (NeighborListEncoding e)
+  {
+    m_encoding = e;
+  }
+  /**
+   * \brief Get the wire encoding of the neighbor list
+   * \return the encoding
+   */
+  NeighborListEncoding GetNeighborEncoding () const
+  {
+    return m_encoding;
+  }
+  /**
+   * \brief Set the digest sent in place of the list with NEIGHBOR_LIST_REF
+   * \param digest the NeighborSet::GetDigest of the list
+   */
+  void SetNeighborDigest (uint32_t digest)
+  {
+    m_digest = digest;
+  }
+  /**
+   * \brief Get the digest of a received NEIGHBOR_LIST_REF header
+   * \return the digest
+   */
+  uint32_t GetNeighborDigest () const
+  {
+    return m_digest;
+  }
+  /**
+   * \brief Get the Bloom filter of a received NEIGHBOR_LIST_BLOOM header
+   * \return the filter
+   */
+  const NeighborBloomFilter & GetNeighborFilter () const
+  {
+    return m_bloom;
+  }
+  /**
+   * \brief Get the number of bytes used by the neighbor list on the wire
+   * \return the encoded list size
+   */
+  uint32_t GetNeighborListSize () const;
+
   /**
    * \brief Comparison operatorSendTo
    * \return true if the RREQ headers are equal
@@ -908,6 +1008,9 @@ private:
   std::vector<Ipv4Address> m_list;
   uint16_t m_size;
   Ipv4Address m_targetnode;
+  NeighborListEncoding m_encoding; ///< neighbor list encoding
+  NeighborBloomFilter m_bloom; ///< Bloom filter of a received NEIGHBOR_LIST_BLOOM list
+  uint32_t m_digest; ///< Digest of the list for NEIGHBOR_LIST_REF
 };
 
 /**
@@ -917,6 +1020,97 @@ private:
   */
 std::ostream &operator<< (std::ostream &os, WHEHeader const &);
 
+/**
+* \ingroup aodv
+* \brief Neighbor list delta carried after the RREP header of a Hello
+*
+* Sent when the Hello header uses NEIGHBOR_LIST_REF: the header then holds
+* the digest of the sender's neighbor list, and this header the changes
+* since the list whose digest is Base.  A zero Base means that Added is the
+* whole list.  A Hello whose list did not change carries no delta.
+* Receivers keep the list of each neighbor, so that RREP and WHE only need
+* to carry the digest.
+  \verbatim
+  0                   1                   2                   3
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |                          Base digest                          |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |          Added count          |         Removed count         |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  |     Added addresses, then removed addresses (delta coded)     |
+  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  \endverbatim
+*/
+class NeighborDeltaHeader : public Header
+{
+public:
+  /**
+   * constructor
+   *
+   * \param base the digest of the list the delta applies to, 0 for a full list
+   * \param added the added addresses
+   * \param removed the removed addresses
+   */
+  NeighborDeltaHeader (uint32_t base = 0, std::vector<Ipv4Address> added = {},
+                       std::vector<Ipv4Address> removed = {});
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  TypeId GetInstanceTypeId () const;
+  uint32_t GetSerializedSize () const;
+  void Serialize (Buffer::Iterator start) const;
+  uint32_t Deserialize (Buffer::Iterator start);
+  void Print (std::ostream &os) const;
+
+  /**
+   * \brief Get the digest of the list the delta applies to
+   * \return the digest, 0 for a full list
+   */
+  uint32_t GetBase () const
+  {
+    return m_base;
+  }
+  /**
+   * \brief Get the added addresses
+   * \return the addresses
+   */
+  const std::vector<Ipv4Address> & GetAdded () const
+  {
+    return m_added;
+  }
+  /**
+   * \brief Get the removed addresses
+   * \return the addresses
+   */
+  const std::vector<Ipv4Address> & GetRemoved () const
+  {
+    return m_removed;
+  }
+
+  /**
+   * \brief Comparison operator
+   * \param o header to compare
+   * \return true if the headers are equal
+   */
+  bool operator== (NeighborDeltaHeader const &o) const;
+
+private:
+  uint32_t m_base; ///< Digest of the list the delta applies to
+  std::vector<Ipv4Address> m_added; ///< Added addresses
+  std::vector<Ipv4Address> m_removed; ///< Removed addresses
+};
+
+/**
+  * \brief Stream output operator
+  * \param os output stream
+  * \return updated stream
+  */
+std::ostream &operator<< (std::ostream &os, NeighborDeltaHeader const &);
+
 
 } // namespace aodv
 } // namespace ns3
@@ -41,8 +41,11 @@
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
 #include <algorithm>
 #include <limits>
+#include <cmath>
 
 namespace ns3 {
 
@@ -169,6 +172,10 @@ RoutingProtocol::RoutingProtocol ()
     m_WHEIdCache (m_pathDiscoveryTime),
     m_dpd (m_pathDiscoveryTime),//ブロードキャスト/マルチキャストパケットの重複処理
     m_nb (m_helloInterval),//隣接ノードへの対応
+    m_neighborEncoding (NEIGHBOR_LIST_RAW),
+    m_helloFullListInterval (10),
+    m_hellosSinceFullList (0),
+    m_announcedDigest (NeighborSet ().GetDigest ()),
     m_rreqCount (0),//RREQレート制御に使用されるRREQ数
     m_rerrCount (0),//RRERレート制御に使用されるRREQ数
     m_htimer (Timer::CANCEL_ON_DESTROY),//helloタイマー
@@ -311,13 +318,60 @@ RoutingProtocol::GetTypeId (void)
                    StringValue ("ns3::UniformRandomVariable"),
                    MakePointerAccessor (&RoutingProtocol::m_uniformRandomVariable),
                    MakePointerChecker<UniformRandomVariable> ())
+    .AddAttribute ("WhDecisionRv",
+                   "Access to the UniformRandomVariable used by the wormhole decisions",
+                   StringValue ("ns3::UniformRandomVariable"),
+                   MakePointerAccessor (&RoutingProtocol::m_whDecisionVariable),
+                   MakePointerChecker<UniformRandomVariable> ())
     //シナリオファイルからWH攻撃のモードを取得
     .AddAttribute("WhMode",
                   "Wormhole mode: 0=normal, 1=internal WH, 2=external WH",
                   UintegerValue(2),
                   MakeUintegerAccessor(&RoutingProtocol::SetWhMode,
                                         &RoutingProtocol::GetWhMode),
-                  MakeUintegerChecker<uint8_t>(0, 2));
+                  MakeUintegerChecker<uint8_t>(0, 2))
+    .AddAttribute ("DetectionTraceFormat",
+                   "Format of the buffered wormhole detection trace.",
+                   EnumValue (DetectionLog::LEGACY),
+                   MakeEnumAccessor (&RoutingProtocol::SetDetectionTraceFormat,
+                                     &RoutingProtocol::GetDetectionTraceFormat),
+                   MakeEnumChecker (DetectionLog::NONE, "None",
+                                    DetectionLog::LEGACY, "Legacy",
+                                    DetectionLog::CSV, "Csv",
+                                    DetectionLog::BINARY, "Binary"))
+    .AddAttribute ("DetectionTraceFile",
+                   "File name prefix of the Csv and Binary detection traces.",
+                   StringValue ("wh-detection"),
+                   MakeStringAccessor (&RoutingProtocol::SetDetectionTraceFile,
+                                       &RoutingProtocol::GetDetectionTraceFile),
+                   MakeStringChecker ())
+    .AddAttribute ("DetectionTraceBufferSize",
+                   "Number of detection records buffered per node before they are written.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&RoutingProtocol::SetDetectionTraceBufferSize,
+                                         &RoutingProtocol::GetDetectionTraceBufferSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("NeighborListEncoding",
+                   "Wire encoding of the neighbor lists in RREP and WHE. Bloom applies to WHE only; "
+                   "RREP then uses Delta so that the verifier keeps one exact list. Ref sends the list "
+                   "as deltas in the Hellos and only its digest in RREP and WHE; it falls back to Delta "
+                   "when Hellos are disabled.",
+                   EnumValue (NEIGHBOR_LIST_RAW),
+                   MakeEnumAccessor (&RoutingProtocol::m_neighborEncoding),
+                   MakeEnumChecker (NEIGHBOR_LIST_RAW, "Raw",
+                                    NEIGHBOR_LIST_DELTA, "Delta",
+                                    NEIGHBOR_LIST_BLOOM, "Bloom",
+                                    NEIGHBOR_LIST_REF, "Ref"))
+    .AddAttribute ("HelloFullListInterval",
+                   "With the Ref neighbor list encoding, send the whole neighbor list instead of a delta "
+                   "in every n-th Hello, so that neighbors which missed a Hello catch up.",
+                   UintegerValue (10),
+                   MakeUintegerAccessor (&RoutingProtocol::m_helloFullListInterval),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddTraceSource ("RouteDiscoveryLatency",
+                     "A route discovery started by this node completed.",
+                     MakeTraceSourceAccessor (&RoutingProtocol::m_routeLatencyTrace),
+                     "ns3::aodv::RoutingProtocol::RouteLatencyTracedCallback");
   return tid;
 }
 
@@ -355,6 +409,14 @@ RoutingProtocol::DoDispose () //クラス・オブジェクトの破棄
       iter->first->Close ();
     }
   m_socketSubnetBroadcastAddresses.clear ();
+  for (std::unordered_map<uint64_t, recv_Rrep>::iterator i = Rrep_List.begin (); i != Rrep_List.end (); ++i)
+    {
+      i->second.timeout.Cancel ();
+    }
+  Rrep_List.clear ();
+  m_neighborViews.clear ();
+  m_discoveryStart.clear ();
+  m_detectionLog.Flush ();
   Ipv4RoutingProtocol::DoDispose ();
 }
 
@@ -378,7 +440,8 @@ RoutingProtocol::AssignStreams (int64_t stream)
 {
   NS_LOG_FUNCTION (this << stream);
   m_uniformRandomVariable->SetStream (stream);
-  return 1;
+  m_whDecisionVariable->SetStream (stream + 1);
+  return 2;
 }
 
 
@@ -1077,7 +1140,7 @@ RoutingProtocol::SendRequest (Ipv4Address dst) //RREQを送信する
 
   m_seqNo++;
   rreqHeader.SetOriginSeqno (m_seqNo);
-  uint32_t req_id = m_requestId++;
+  m_requestId++;
   rreqHeader.SetId (m_requestId);
   rreqHeader.SetWHForwardFlag(0);
 
@@ -1113,15 +1176,18 @@ RoutingProtocol::SendRequest (Ipv4Address dst) //RREQを送信する
       Simulator::Schedule (Time (MilliSeconds (m_uniformRandomVariable->GetInteger (0, 10))), &RoutingProtocol::SendTo, this, socket, packet, destination);
     }
 
-  NS_LOG_DEBUG("RREQを送信しました。 メッセージID：" << req_id);
+  NS_LOG_DEBUG("RREQを送信しました。 メッセージID：" << rreqHeader.GetId ());
 
-  //経路作成時間保存用
+  //経路作成時間保存用．再送した RREQ でも最初の RREQ の送信時刻から計る
+  std::map<Ipv4Address, Time>::const_iterator start =
+    m_discoveryStart.insert (std::make_pair (dst, Simulator::Now ())).first;
   RouteLatencyEntry entry;
-  entry.start = Simulator::Now();
+  entry.start = start->second;
   entry.established = Seconds(0);
   entry.latency = Seconds(0);
 
-  m_whStats.m_latencyTable[req_id] = entry;
+  // RREP は RREQ ヘッダの ID を返すので，同じ ID で登録する
+  m_whStats.m_latencyTable[rreqHeader.GetId ()] = entry;
 
   ScheduleRreqRetry (dst);
 }
@@ -1132,10 +1198,27 @@ RoutingProtocol::SendTo (Ptr<Socket> socket, Ptr<Packet> packet, Ipv4Address des
   socket->SendTo (packet, 0, InetSocketAddress (destination, AODV_PORT));
 
   //総メッセージ取得
+  CountControlPacket (packet);
+
+}
+
+void
+RoutingProtocol::CountControlPacket (Ptr<const Packet> packet)
+{
   m_whStats.totalAodvCtrlMessages++;
-  m_whStats.totalAodvCtrlBytes += packet->GetSize();
+  m_whStats.totalAodvCtrlBytes += packet->GetSize ();
+  StatsRegistry *stats = StatsRegistry::Get ();
+  stats->Add (m_statCtrlMessages, m_statNode);
+  stats->Add (m_statCtrlBytes, m_statNode, packet->GetSize ());
+}
 
+void
+RoutingProtocol::CountVerdict (uint32_t &field, uint32_t id)
+{
+  field++;
+  StatsRegistry::Get ()->Add (id, m_statNode);
 }
+
 void
 RoutingProtocol::ScheduleRreqRetry (Ipv4Address dst)//RREQの再送信
 {
@@ -1532,8 +1615,7 @@ RoutingProtocol::SendAodvBroadcast (Ptr<Packet> packet)
       int ret = socket->SendTo (p, 0, dst);
 
       //総メッセージ取得
-      m_whStats.totalAodvCtrlMessages++;
-      m_whStats.totalAodvCtrlBytes += packet->GetSize();
+      CountControlPacket (packet);
 
       if (ret < 0)
         {
@@ -1566,7 +1648,7 @@ RoutingProtocol::SendReply (RreqHeader const & rreqHeader, RoutingTableEntry con
 
   //隣接ノードリスト取得
   // std::vector<Ipv4Address> List = m_nb.GetNeighborList();  //全隣接ノード取得
-  std::vector<Ipv4Address> List = m_nb.GetHelloNeighborList();
+  const std::vector<Ipv4Address> &List = m_nb.GetHelloNeighborList ();
 
   //printf("隣接リスト表示\n");
 
@@ -1595,6 +1677,8 @@ RoutingProtocol::SendReply (RreqHeader const & rreqHeader, RoutingTableEntry con
                           /*隣接ノードリスト*/List, size, /*id=*/rreqHeader.GetId());
 
   rrepHeader.SetNextnode(toOrigin.GetNextHop());
+  rrepHeader.SetNeighborEncoding (GetRrepNeighborEncoding ());
+  rrepHeader.SetNeighborDigest (m_announcedDigest);
 
   //printf("RREPを送信　　ID：%d\n", rrepHeader.Getid());
 
@@ -1669,7 +1753,7 @@ RoutingProtocol::SendReplyByIntermediateNode (RoutingTableEntry & toDst, Routing
 
   //隣接ノードリスト取得
   // std::vector<Ipv4Address> List = m_nb.GetNeighborList();  //全隣接ノード取得
-  std::vector<Ipv4Address> List = m_nb.GetHelloNeighborList();
+  const std::vector<Ipv4Address> &List = m_nb.GetHelloNeighborList ();
 
   uint16_t size = List.size();
 
@@ -1682,6 +1766,8 @@ RoutingProtocol::SendReplyByIntermediateNode (RoutingTableEntry & toDst, Routing
   　おそらく一方向リンクに直面している...。RREP-ackをリクエストする
    */
   rrepHeader.SetNextnode(toOrigin.GetNextHop());
+  rrepHeader.SetNeighborEncoding (GetRrepNeighborEncoding ());
+  rrepHeader.SetNeighborDigest (m_announcedDigest);
   if (toDst.GetHop () == 1)
     {
       rrepHeader.SetAckRequired (true);
@@ -1718,6 +1804,8 @@ RoutingProtocol::SendReplyByIntermediateNode (RoutingTableEntry & toDst, Routing
                                                  /*隣接ノードリスト*/List, size,/*rreqid*/rreqid);
 
       gratRepHeader.SetNextnode(toDst.GetNextHop());
+      gratRepHeader.SetNeighborEncoding (GetRrepNeighborEncoding ());
+      gratRepHeader.SetNeighborDigest (m_announcedDigest);
 
       Ptr<Packet> packetToDst = Create<Packet> ();
       SocketIpTtlTag gratTag;
@@ -1755,8 +1843,7 @@ RoutingProtocol::SendReplyAck (Ipv4Address neighbor) //RREP_ACKを送信しま
   socket->SendTo (packet, 0, InetSocketAddress (neighbor, AODV_PORT));
 
   //総メッセージ取得
-  m_whStats.totalAodvCtrlMessages++;
-  m_whStats.totalAodvCtrlBytes += packet->GetSize();
+  CountControlPacket (packet);
 }
 
 void
@@ -1788,6 +1875,13 @@ RoutingProtocol::RecvReply (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sen
   // RREPがHelloメッセージの場合
   if (dst == rrepHeader.GetOrigin ())
     {
+      //隣接リストが変わっていない Hello には差分が付かない
+      if (rrepHeader.GetNeighborEncoding () == NEIGHBOR_LIST_REF && p->GetSize () > 0)
+        {
+          NeighborDeltaHeader delta;
+          p->RemoveHeader (delta);
+          ApplyNeighborDelta (dst, rrepHeader.GetNeighborDigest (), delta);
+        }
       ProcessHello (rrepHeader, receiver);
       return;
     }
@@ -1808,42 +1902,30 @@ RoutingProtocol::RecvReply (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sen
     NS_LOG_DEBUG("WH攻撃により転送されたRREPを受信しました。");
   }
 
-    std::ofstream writing_file;
-    std::string filename = "com_num.txt";
-    writing_file.open(filename, std::ios::app);
-    std::string writing_text ="1";
-    writing_file << writing_text << std::endl;
-    writing_file.close();
+  m_detectionLog.Record (DETECTION_RREP_RECEIVED);
 
   //printf("RREPのreceiver: %d\n", receiver.Get());
 
   if(receiver == Ipv4Address("10.1.2.1") || receiver == Ipv4Address("10.1.2.2"))
   {
     // printf("WHノードの可能性があります\n");
-
-    std::ofstream writing_file;
-    std::string filename = "WH_count.txt";
-    writing_file.open(filename, std::ios::app);
-    std::string writing_text ="1";
-    writing_file << writing_text << std::endl;
-    writing_file.close();
+    m_detectionLog.Record (DETECTION_WH_ENDPOINT_RREP);
   }
 
     //printf("Recv Reply  IP:%u\n", receiver.Get());
 
     //printf("受け取った隣接ノード情報\n");
     std::vector<Ipv4Address> get_List = rrepHeader.GetNeighbors ();
+    NeighborSet senderSet (get_List);
+    if (rrepHeader.GetNeighborEncoding () == NEIGHBOR_LIST_REF)
+    {
+      //送信者の Hello で受け取った隣接リストを使う（無ければ空のまま WHC で確認する）
+      LookupNeighborView (sender, rrepHeader.GetNeighborDigest (), senderSet);
+    }
 
-    int get_size = rrepHeader.Getsize();
-
-    int data_size = 4*get_size;
+    int data_size = rrepHeader.GetNeighborListSize ();
 
-    std::ofstream writing_file2;
-  std::string filename2 = "sample.txt";
-  writing_file2.open(filename2, std::ios::app);
-  // std::string writing_text = "";
-  writing_file2 << data_size << std::endl;
-  writing_file2.close(); 
+  m_detectionLog.Record (DETECTION_CTRL_PAYLOAD, data_size);
   //printf("get size:%d\n",get_size);
   //Ipv4Address test1 = get_List[0];
   //Ipv4Address test = get_List[1];
@@ -1860,7 +1942,7 @@ RoutingProtocol::RecvReply (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sen
   
   //隣接ノードリスト取得
   // std::vector<Ipv4Address> List = m_nb.GetNeighborList();  //全隣接ノード取得
-  std::vector<Ipv4Address> List = m_nb.GetHelloNeighborList();
+  const std::vector<Ipv4Address> &List = m_nb.GetHelloNeighborList ();
 
   //printf("隣接リスト表示\n");
 
@@ -1951,9 +2033,12 @@ RoutingProtocol::RecvReply (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sen
         NS_LOG_DEBUG("経路作成時間を記録");
         m_whStats.Getroute = true;
         m_whStats.m_routetime = Simulator::Now();
+        StatsRegistry::Get ()->Record (m_statRouteTime, m_statNode, m_whStats.m_routetime.GetSeconds ());
       }
 
       //経路作成時間を取得
+        // RREP が届いた時点で dst への経路探索は終わる（同じ経路探索への 2 つ目以降の RREP は数えない）
+        bool pending = m_discoveryStart.erase (dst) > 0;
         uint32_t msgId = rrepHeader.Getid();
 
         auto it = m_whStats.m_latencyTable.find(msgId);
@@ -1965,6 +2050,12 @@ RoutingProtocol::RecvReply (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sen
             NS_LOG_DEBUG("[LATENCY] RREQ msgId=" << msgId
                         << " established=" << it->second.established.GetSeconds()
                         << " latency=" << it->second.latency.GetSeconds());
+
+            if (pending)
+            {
+                m_routeLatency.Record (it->second.latency.GetMicroSeconds ());
+                m_routeLatencyTrace (dst, it->second.latency);
+            }
         }
         else
         {
@@ -2033,67 +2124,20 @@ RoutingProtocol::RecvReply (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sen
   
   rrepHeader.SetWHForwardFlag(0);
 
-  //RREP送信元から送信された情報を取得
-  struct recv_Rrep new_List
-  {
-    rrepHeader,
-    sender,
-    false,//検知が終了しているかを示すフラグ
-    Simulator::Now(),
-    WhForwardFlag
-  };
-
-  int size_l = Rrep_List.size();
-
-  //printf("RREP送信元の隣接ノードリストのサイズ:%d\n", size_l);
-
-  //隣接ノードリストに同じシーケンス番号存在しているか確認
-  for(int i = 0; i < size_l;i++)
-  {
-    RrepHeader get_Rrep = Rrep_List.at(i).rrepHeader;
-    uint32_t get_id = get_Rrep.Getid();
-    Ipv4Address origin = get_Rrep.GetOrigin();
-
-    if(get_id == rrepHeader.Getid() && origin == rrepHeader.GetOrigin())
-    {
-      //printf("シーケンス番号が一致\n");
-      Rrep_List.at(i) = new_List;
-      break;
-    }
-    else if(i == size_l -1)
-    {
-      //printf("新しいオブジェクト挿入\n");
-      Rrep_List.push_back(new_List);
-    }
-
-  }
-
-  if(size_l == 0){
-    //printf("size_l = 0\n");
-    Rrep_List.push_back(new_List);
-  }
-
   rrepHeader.SetNextnode(toOrigin.GetNextHop());
 
   if(m_whMode == 1 && (receiver == Ipv4Address("10.1.2.1") || receiver == Ipv4Address("10.1.2.2")))
   {
-    uint32_t random = m_uniformRandomVariable->GetInteger(0, 1); // 0 or 1（各 1/2）
+    uint32_t random = m_whDecisionVariable->GetInteger(0, 1); // 0 or 1（各 1/2）
 
     if(random == 1)
     {
       //WHノードを正常ノードとご判定
-      std::ofstream ofs("test.log", std::ios::out | std::ios::app);
-      uint32_t nodeId = GetObject<Node>()->GetId();
-
-      ofs << "WHノード自身がRREP受信したため，にWHリンクを正常リンクとご判定  ノードID：" << nodeId 
-      << "   シミュレーション時間：" << Simulator::Now() 
-      << std::endl;
+      m_detectionLog.Record (DETECTION_MISDETECTION, 1, Ipv4Address (), MISDETECTION_WH_ENDPOINT);
 
       NS_LOG_DEBUG("WHノード自身がRREP受信したため，にWHリンクを正常リンクとご判定");
-      
-      ofs.close();
 
-      m_whStats.undetectedWh++;
+      CountVerdict (m_whStats.undetectedWh, m_statFn);
 
       //RREPパケット作製
       Ptr<Packet> packet = Create<Packet> ();
@@ -2111,94 +2155,106 @@ RoutingProtocol::RecvReply (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address sen
     }else
     {
       NS_LOG_DEBUG("WHノード自身がRREP受信 正常に検知");
-      m_whStats.detectedWh++;
+      CountVerdict (m_whStats.detectedWh, m_statTp);
       return;
     }
   }
 
   //検知開始
   //隣接ノードリスト比較　自分の隣接ノードリスト：List　受信した隣接ノードリスト：get_List
-  for(int i = 0; i < my_size; i++)
+  Ipv4Address common;
+  if (NeighborSet (List).FindFirstCommon (senderSet, common))
   {
-    for(int j = 0; j < get_size; j++)
-    {
-      if(List.at(i) == get_List.at(j))
-      {
-        NS_LOG_DEBUG("同じ隣接ノードが存在：" << List.at(i));
-
-        //自身を正常リンクと判定
+    NS_LOG_DEBUG("同じ隣接ノードが存在：" << common);
 
-        if(WhForwardFlag == 1)
-        {
-          //WHノードを正常ノードとご判定
-          std::ofstream ofs("test.log", std::ios::out | std::ios::app);
-          uint32_t nodeId = GetObject<Node>()->GetId();
+    //自身を正常リンクと判定
 
-          ofs << "RREP受信時にWHリンクを正常リンクとご判定  ノードID：" << nodeId 
-          << "   シミュレーション時間：" << Simulator::Now() 
-          << "共通隣接ノード：" << List.at(i) 
-          << std::endl;
+    if(WhForwardFlag == 1)
+    {
+      //WHノードを正常ノードとご判定
+      m_detectionLog.Record (DETECTION_MISDETECTION, 1, common, MISDETECTION_RREP_NEIGHBOR);
 
-          NS_LOG_DEBUG("RREP受信時にWHリンクを正常リンクとご判定");
-          
-          ofs.close();
+      NS_LOG_DEBUG("RREP受信時にWHリンクを正常リンクとご判定");
 
-          m_whStats.undetectedWh++;
+      CountVerdict (m_whStats.undetectedWh, m_statFn);
 
-          //RREPパケット作製
-        Ptr<Packet> packet = Create<Packet> ();
-        SocketIpTtlTag ttl;
-        ttl.SetTtl (tag.GetTtl () - 1);
-        packet->AddPacketTag (ttl);
-        packet->AddHeader (rrepHeader);
-        TypeHeader tHeader (AODVTYPE_RREP);
+      //RREPパケット作製
+    Ptr<Packet> packet = Create<Packet> ();
+    SocketIpTtlTag ttl;
+    ttl.SetTtl (tag.GetTtl () - 1);
+    packet->AddPacketTag (ttl);
+    packet->AddHeader (rrepHeader);
+    TypeHeader tHeader (AODVTYPE_RREP);
 
-        packet->AddHeader (tHeader);
+    packet->AddHeader (tHeader);
 
-        SendAodvBroadcast(packet);
-        return;
-        
-        }else{
-          NS_LOG_DEBUG("RREP受信時に、正常ノードを正常に検知");
-          //正常ノードを正常ノードと判定した回数
-          m_whStats.truenegative++;
-        }
+    SendAodvBroadcast(packet);
+    return;
+    
+    }else{
+      NS_LOG_DEBUG("RREP受信時に、正常ノードを正常に検知");
+      //正常ノードを正常ノードと判定した回数
+      CountVerdict (m_whStats.truenegative, m_statTn);
+    }
 
-        rrepHeader.SetNeighbors(List);
-        rrepHeader.Setsize(my_size);
+    rrepHeader.SetNeighbors(List);
+    rrepHeader.Setsize(my_size);
+    rrepHeader.SetNeighborEncoding (GetRrepNeighborEncoding ());
+    rrepHeader.SetNeighborDigest (m_announcedDigest);
 
-        //RREPパケット作製
-        Ptr<Packet> packet = Create<Packet> ();
-        SocketIpTtlTag ttl;
-        ttl.SetTtl (tag.GetTtl () - 1);
-        packet->AddPacketTag (ttl);
-        packet->AddHeader (rrepHeader);
-        TypeHeader tHeader (AODVTYPE_RREP);
+    //RREPパケット作製
+    Ptr<Packet> packet = Create<Packet> ();
+    SocketIpTtlTag ttl;
+    ttl.SetTtl (tag.GetTtl () - 1);
+    packet->AddPacketTag (ttl);
+    packet->AddHeader (rrepHeader);
+    TypeHeader tHeader (AODVTYPE_RREP);
 
-        packet->AddHeader (tHeader);
+    packet->AddHeader (tHeader);
 
-        SendAodvBroadcast(packet);
+    SendAodvBroadcast(packet);
 
-        // Ptr<Socket> socket = FindSocketWithInterfaceAddress (toOrigin.GetInterface ());
-        // NS_ASSERT (socket);
-        // socket->SendTo (packet, 0, InetSocketAddress (toOrigin.GetNextHop (), AODV_PORT));
+    // Ptr<Socket> socket = FindSocketWithInterfaceAddress (toOrigin.GetInterface ());
+    // NS_ASSERT (socket);
+    // socket->SendTo (packet, 0, InetSocketAddress (toOrigin.GetNextHop (), AODV_PORT));
 
 
 
-        return;
-      }
-    }
+    return;
   }
 
   //printf("Send WHC  ID:%d\n", rrepHeader.Getid());
 
   //RREQ送信元IPアドレスとRREQIDをキーとして保存
-  
-
-  SendWHC(rrepHeader);
+  uint64_t key = GetRrepKey (rrepHeader.GetOrigin (), rrepHeader.Getid ());
+  std::unordered_map<uint64_t, recv_Rrep>::iterator pending = Rrep_List.find (key);
+  if (pending != Rrep_List.end ())
+    {
+      if (pending->second.sender == sender)
+        {
+          // 同じ送信者からの同じ RREP は検証中の WHC にまとめる（隣接リストが同じなので WHE の判定も変わらない）
+          NS_LOG_DEBUG ("検証中の RREP を更新　ID：" << rrepHeader.Getid ());
+          pending->second.rrepHeader = rrepHeader;
+          pending->second.WHForwardFlag = WhForwardFlag;
+          return;
+        }
+      pending->second.timeout.Cancel ();
+    }
 
+  //RREP送信元から送信された情報を取得
   Time wait = Seconds(0.5);
-  Simulator::Schedule (wait, &RoutingProtocol::CheckResult, this, rrepHeader);
+  struct recv_Rrep new_List
+  {
+    rrepHeader,
+    sender,
+    Simulator::Now(),
+    WhForwardFlag,
+    senderSet,
+    Simulator::Schedule (wait, &RoutingProtocol::CheckResult, this, rrepHeader)
+  };
+  Rrep_List[key] = new_List;
+
+  SendWHC(rrepHeader);
 
 
   NS_LOG_DEBUG("隣接ノードリクエストを送信　WHC ID：" << rrepHeader.Getid());
@@ -2221,64 +2277,33 @@ RoutingProtocol::CheckResult(RrepHeader rrepHeader)
 {
   NS_LOG_FUNCTION (this << " src " << rrepHeader);
 
-  bool rrep_flag = false;
-  struct recv_Rrep* new_rrep = nullptr;
-  int List_size = Rrep_List.size();
-  uint32_t get_id = 0;
-  Ipv4Address rrep_origin;
-
   //rrepHeaderのIDとOriginに一致するリストを取得
-  for(int i = 0; i < List_size; i++)
-  {
-    recv_Rrep& elem = Rrep_List.at(i);  // vector内要素（実体）への参照
-    rrepHeader = elem.rrepHeader;
-    get_id = rrepHeader.Getid();
-    rrep_origin = rrepHeader.GetOrigin();
-    if(rrepHeader.Getid() == get_id && rrepHeader.GetOrigin() == rrep_origin)
-    {
-      new_rrep = &elem;
-      rrep_flag = true;
-      //printf("同一のシーケンス番号を発見\n");
-      // sender_neighbors = rrepHeader.GetNeighbors();
-      break;
-    }
-  }
-
-  if(!rrep_flag)
+  std::unordered_map<uint64_t, recv_Rrep>::iterator pending =
+    Rrep_List.find (GetRrepKey (rrepHeader.GetOrigin (), rrepHeader.Getid ()));
+  if (pending == Rrep_List.end ())
   {
     NS_LOG_DEBUG("CheckResultでIDとOriginが一致するRREPが存在しません。");
     return;
   }
-
-  if(new_rrep->detec_end)
-  {
-    //検知済みなので何もしない
-    return;
-  }
+  struct recv_Rrep* new_rrep = &pending->second;
 
   //WH攻撃と判定
   if(new_rrep->WHForwardFlag == 1)
   {
     NS_LOG_DEBUG("WH攻撃を正常に判定");
     //WH攻撃を正常に判定
-    m_whStats.detectedWh++;
+    CountVerdict (m_whStats.detectedWh, m_statTp);
   }else{
     //正常ノードをWH攻撃とご検知
-    std::ofstream ofs("test.log", std::ios::out | std::ios::app);
-    uint32_t nodeId = GetObject<Node>()->GetId();
-
-    ofs << "タイムアウトにより、正常ノードをご検知  ノードID：" << nodeId 
-    << "   シミュレーション時間：" << Simulator::Now() 
-    << std::endl;
-    
-    ofs.close();
+    m_detectionLog.Record (DETECTION_MISDETECTION, 1, Ipv4Address (), MISDETECTION_TIMEOUT);
 
     NS_LOG_DEBUG("タイムアウトにより、正常ノードをご検知");
 
-    m_whStats.falsePositive++;
+    CountVerdict (m_whStats.falsePositive, m_statFp);
   }
 
-  new_rrep->detec_end = true;
+  //タイムアウトしたので検証を終了
+  Rrep_List.erase (pending);
 }
 
 void 
@@ -2334,8 +2359,7 @@ RoutingProtocol::SendWHC (RrepHeader rrepHeader)
       socket->SendTo (packet->Copy (), 0, InetSocketAddress (destination, AODV_PORT));
 
       //総メッセージ取得
-      m_whStats.totalAodvCtrlMessages++;
-      m_whStats.totalAodvCtrlBytes += packet->GetSize();
+      CountControlPacket (packet);
       //printf("送信完了\n");
     }
 
@@ -2352,12 +2376,7 @@ void RoutingProtocol::RecvWHC (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
   WHCHeader WHCHeader;
   p->RemoveHeader (WHCHeader);
 
-  std::ofstream writing_file;
-  std::string filename = "sample.txt";
-  writing_file.open(filename, std::ios::app);
-  std::string writing_text = "4";
-  writing_file << writing_text << std::endl;
-  writing_file.close();
+  m_detectionLog.Record (DETECTION_CTRL_PAYLOAD, 4);
 
   // ノードは、ブラックリストにあるノードから受信したすべてのRREQを無視する。
   RoutingTableEntry toPrev;
@@ -2406,7 +2425,7 @@ void RoutingProtocol::SendWHE (WHCHeader const & WHCHeader, RoutingTableEntry co
   
 //隣接ノードリスト取得
   // std::vector<Ipv4Address> List = m_nb.GetNeighborList();  //全隣接ノード取得
-  std::vector<Ipv4Address> List = m_nb.GetHelloNeighborList();
+  const std::vector<Ipv4Address> &List = m_nb.GetHelloNeighborList ();
 
   //printf("WHC時隣接リスト取得\n");
 
@@ -2424,6 +2443,8 @@ void RoutingProtocol::SendWHE (WHCHeader const & WHCHeader, RoutingTableEntry co
   
   WHEHeader WHEHeader (/*id=*/WHCHeader.Getid(), WHCHeader.GetOrinig(), List, my_size);
   WHEHeader.Settarget(toNeighbor.GetNextHop ());
+  WHEHeader.SetNeighborEncoding (GetWheNeighborEncoding ());
+  WHEHeader.SetNeighborDigest (m_announcedDigest);
 
   //パケット作製
   Ptr<Packet> packet = Create<Packet> ();
@@ -2472,44 +2493,16 @@ void RoutingProtocol::RecvWHE (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
   uint32_t id_WH = WHEHeader.Getid ();
   Ipv4Address origin = WHEHeader.GetOrigin(); // RREQの送信元IPアドレス
 
-  //rrepから送信された隣接ノードリストに同じシーケンス番号のものが含まれているか調べる
-  int List_size = Rrep_List.size();
-
-  struct recv_Rrep* new_rrep = nullptr;
-  RrepHeader rrepHeader;
-
-  uint32_t get_id = 0;
-  Ipv4Address rrep_origin;
-  bool rrep_flag= false;
-
   //IDとoriginが一致するRREPを探索
-  for(int i = 0; i < List_size; i++)
-  {
-    recv_Rrep& elem = Rrep_List.at(i);  // vector内要素（実体）への参照
-    rrepHeader = elem.rrepHeader;
-    get_id = rrepHeader.Getid();
-    rrep_origin = rrepHeader.GetOrigin();
-    if(id_WH == get_id && origin == rrep_origin)
-    {
-      new_rrep = &elem;
-      rrep_flag = true;
-      //printf("同一のシーケンス番号を発見\n");
-      // sender_neighbors = rrepHeader.GetNeighbors();
-      break;
-    }
-  }
-
-  if(!rrep_flag)
+  std::unordered_map<uint64_t, recv_Rrep>::iterator pending = Rrep_List.find (GetRrepKey (origin, id_WH));
+  if (pending == Rrep_List.end ())
   {
     NS_LOG_DEBUG("IDとOriginが一致するRREPが存在しません。");
     return;
   }
-
-  //検知済みの場合
-  if(new_rrep->detec_end)
-  {
-    return;
-  }
+  struct recv_Rrep* new_rrep = &pending->second;
+  RrepHeader rrepHeader = new_rrep->rrepHeader;
+  uint32_t get_id = id_WH;
 
   if(new_rrep->sender == sender){
     NS_LOG_FUNCTION ("RREPの送信元から送信されたIP:"<<sender);
@@ -2519,12 +2512,17 @@ void RoutingProtocol::RecvWHE (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
 
   NS_LOG_DEBUG("WHEを受信しました。　到達時間：" << new_rrep->sendWHC << "WH転送フラグ：" << new_rrep->WHForwardFlag);
 
-  //rrepから送信されたList取得
-  std::vector<Ipv4Address> sender_neighbors = rrepHeader.GetNeighbors();
+  //rrepから送信されたList取得（RREP受信時に整列済み）
+  const NeighborSet &sender_neighbors = new_rrep->senderNeighbors;
 
 
   //パケット内の隣接ノードリストを取得
-  std::vector<Ipv4Address> packet_neighbors = WHEHeader.GetNeighbors();
+  std::vector<Ipv4Address> packet_list = WHEHeader.GetNeighbors ();
+  NeighborSet packet_neighbors (packet_list);
+  if (WHEHeader.GetNeighborEncoding () == NEIGHBOR_LIST_REF)
+  {
+    LookupNeighborView (sender, WHEHeader.GetNeighborDigest (), packet_neighbors);
+  }
   
   //Originまでのルーティングテーブルを取得
   RoutingTableEntry toOrigin;
@@ -2537,89 +2535,90 @@ void RoutingProtocol::RecvWHE (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
   uint16_t hop = toOrigin.GetHop();
 
   //RREPのセンダの隣接ノードリストと、パケット内の隣接ノードリストを比較
-  int packet_size = packet_neighbors.size();
-  int sender_size = sender_neighbors.size();
-
-  int data_size = 6 + 4*packet_size;
+  int data_size = 6 + WHEHeader.GetNeighborListSize ();
   
-  std::ofstream writing_file;
-  std::string filename = "sample.txt";
-  writing_file.open(filename, std::ios::app);
-  // std::string writing_text = "";
-  writing_file << data_size << std::endl;
-  writing_file.close(); 
-
-  for(int i= 0; i < sender_size; i++)
+  m_detectionLog.Record (DETECTION_CTRL_PAYLOAD, data_size);
+
+  Ipv4Address common;
+  bool found;
+  if (WHEHeader.GetNeighborEncoding () == NEIGHBOR_LIST_BLOOM)
   {
-    for(int j = 0; j < packet_size; j++)
-    {
-      if(sender_neighbors.at(i) == packet_neighbors.at(j) && !IsMyOwnAddress (sender_neighbors.at(i)))
-      {
-        //NS_LOG_UNCOND("一致したip addr: "<<sender_neighbors.at(i));
+    // Bloom filter は近似なので、照合した回数から誤一致の確率を見積もって記録する
+    const NeighborBloomFilter &filter = WHEHeader.GetNeighborFilter ();
+    uint32_t probes = 0;
+    found = sender_neighbors.FindFirstIn (filter, common, probes,
+                                          [this] (Ipv4Address a) { return IsMyOwnAddress (a); });
+    double p = filter.GetFalsePositiveRate (WHEHeader.GetSize ());
+    m_whStats.bloomChecks++;
+    m_whStats.bloomFalseMatchProbability += 1.0 - std::pow (1.0 - p, static_cast<double> (probes));
+  }
+  else
+  {
+    found = sender_neighbors.FindFirstCommon (packet_neighbors, common,
+                                              [this] (Ipv4Address a) { return IsMyOwnAddress (a); });
+  }
+  if (found)
+  {
+    //NS_LOG_UNCOND("一致したip addr: "<<common);
 
-        if (m_WHEIdCache.IsDuplicate (rrepHeader.GetOrigin(), get_id))
-        {
-          NS_LOG_DEBUG ("Ignoring WHE due to duplicate");
-          return;
-        }
+    if (m_WHEIdCache.IsDuplicate (rrepHeader.GetOrigin(), get_id))
+    {
+      NS_LOG_DEBUG ("Ignoring WHE due to duplicate");
+      return;
+    }
 
-        NS_LOG_DEBUG("同一ノードを発見:" << sender_neighbors.at(i));
+    NS_LOG_DEBUG("同一ノードを発見:" << common);
 
-        new_rrep->detec_end = true;
+    //正常リンクと判定
+    if(new_rrep->WHForwardFlag == 1)
+    {
+      //WHリンクをご判定
+      m_detectionLog.Record (DETECTION_MISDETECTION, 1, common, MISDETECTION_WHE_NEIGHBOR);
 
-        //正常リンクと判定
-        if(new_rrep->WHForwardFlag == 1)
-        {
-          //WHリンクをご判定
-          std::ofstream ofs("test.log", std::ios::out | std::ios::app);
-          uint32_t nodeId = GetObject<Node>()->GetId();
+      NS_LOG_DEBUG("WHE受診時にWHリンクを正常リンクとご判定");
 
-          ofs << "WHE受信時にWHリンクを正常リンクとご判定  ノードID：" << nodeId 
-          << "   シミュレーション時間：" << Simulator::Now() 
-          << "共通隣接ノード：" << sender_neighbors.at(i)
-          << std::endl;
-          
-          ofs.close();
+      CountVerdict (m_whStats.undetectedWh, m_statFn);
 
-          NS_LOG_DEBUG("WHE受診時にWHリンクを正常リンクとご判定");
+    }else{
+      //正常リンクを正常に判定
+      NS_LOG_DEBUG("WHE受診時に正常ノードを正常に検知");
+      CountVerdict (m_whStats.truenegative, m_statTn);
+    }
 
-          m_whStats.undetectedWh++;
+    //検証が完了したのでタイムアウトを取り消して削除
+    new_rrep->timeout.Cancel ();
+    Rrep_List.erase (pending);
 
-        }else{
-          //正常リンクを正常に判定
-          NS_LOG_DEBUG("WHE受診時に正常ノードを正常に検知");
-          m_whStats.truenegative++;
-        }
+    //RREP受信時に共通隣接が見つかった場合と同じく、自身の隣接リストを載せて転送
+    const std::vector<Ipv4Address> &List = m_nb.GetHelloNeighborList ();
+    rrepHeader.SetNeighbors (List);
+    rrepHeader.Setsize (List.size ());
+    rrepHeader.SetNeighborEncoding (GetRrepNeighborEncoding ());
+    rrepHeader.SetNeighborDigest (m_announcedDigest);
 
-        //Send RREP
-        Ptr<Packet> packet = Create<Packet> ();
-        SocketIpTtlTag ttl;
-        ttl.SetTtl (hop);
-        packet->AddPacketTag (ttl);
-        packet->AddHeader (rrepHeader);
-        TypeHeader tHeader (AODVTYPE_RREP);
-        packet->AddHeader (tHeader);
-        Ptr<Socket> socket = FindSocketWithInterfaceAddress (toOrigin.GetInterface ());
-        NS_ASSERT (socket);
-        socket->SendTo (packet, 0, InetSocketAddress (toOrigin.GetNextHop (), AODV_PORT));
+    //Send RREP
+    Ptr<Packet> packet = Create<Packet> ();
+    SocketIpTtlTag ttl;
+    ttl.SetTtl (hop);
+    packet->AddPacketTag (ttl);
+    packet->AddHeader (rrepHeader);
+    TypeHeader tHeader (AODVTYPE_RREP);
+    packet->AddHeader (tHeader);
+    Ptr<Socket> socket = FindSocketWithInterfaceAddress (toOrigin.GetInterface ());
+    NS_ASSERT (socket);
+    socket->SendTo (packet, 0, InetSocketAddress (toOrigin.GetNextHop (), AODV_PORT));
 
-        //総メッセージ取得
-        m_whStats.totalAodvCtrlMessages++;
-        m_whStats.totalAodvCtrlBytes += packet->GetSize();
+    //総メッセージ取得
+    CountControlPacket (packet);
 
-        // m_whStats.
-        
-        return;
-      }
-    }
+    // m_whStats.
+    
+    return;
   }
     //int WH_List_size = WH_List.size();
 
     //1/2の確率で1と0のどちらかを出力します
-    std::srand( time(NULL) );
-    int rand = std::rand();
-
-    int WH_at = rand  % 2;
+    int WH_at = m_whDecisionVariable->GetInteger (0, 1);
 
     //WHノードの場合、rrepを偽造して送信
     //for(int k = 0; k < WH_List_size; k++)
@@ -2661,8 +2660,7 @@ void RoutingProtocol::RecvWHE (Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
           socket->SendTo (packet, 0, InetSocketAddress (toOrigin.GetNextHop (), AODV_PORT));
           
           //総メッセージ取得
-          m_whStats.totalAodvCtrlMessages++;
-          m_whStats.totalAodvCtrlBytes += packet->GetSize();
+          CountControlPacket (packet);
           
           return ;
         }
@@ -2813,6 +2811,7 @@ RoutingProtocol::RouteRequestTimerExpire (Ipv4Address dst) //ルート探索プ
       m_routingTable.DeleteRoute (dst);
       NS_LOG_DEBUG ("Route not found. Drop all packets with dst " << dst);
       m_queue.DropPacketWithDst (dst);
+      m_discoveryStart.erase (dst);
       return;
     }
 
@@ -2824,6 +2823,7 @@ RoutingProtocol::RouteRequestTimerExpire (Ipv4Address dst) //ルート探索プ
   else
     {
       NS_LOG_DEBUG ("Route down. Stop search. Drop packet with destination " << dst);
+      m_discoveryStart.erase (dst);
       m_addressReqTimer.erase (dst);
       m_routingTable.DeleteRoute (dst);
       m_queue.DropPacketWithDst (dst);
@@ -2885,6 +2885,10 @@ RoutingProtocol::SendHello () //Helloメッセージを送信
    */
 
   std::vector<Ipv4Address> List = {};
+  //隣接リストを参照で送る場合は、前回の Hello からの差分を載せる
+  bool withRef = GetWheNeighborEncoding () == NEIGHBOR_LIST_REF;
+  NeighborDeltaHeader delta;
+  bool withDelta = withRef && MakeNeighborDelta (delta);
   for (std::map<Ptr<Socket>, Ipv4InterfaceAddress>::const_iterator j = m_socketAddresses.begin (); j != m_socketAddresses.end (); ++j)
     {
       Ptr<Socket> socket = j->first;
@@ -2897,6 +2901,17 @@ RoutingProtocol::SendHello () //Helloメッセージを送信
       SocketIpTtlTag tag;
       tag.SetTtl (1);
       packet->AddPacketTag (tag);
+      if (withRef)
+        {
+          helloHeader.SetNeighborEncoding (NEIGHBOR_LIST_REF);
+          helloHeader.SetNeighborDigest (m_announcedDigest);
+          m_whStats.helloNeighborBytes += helloHeader.GetNeighborListSize ();
+        }
+      if (withDelta)
+        {
+          packet->AddHeader (delta);
+          m_whStats.helloNeighborBytes += delta.GetSerializedSize ();
+        }
       packet->AddHeader (helloHeader);
       TypeHeader tHeader (AODVTYPE_RREP);
       packet->AddHeader (tHeader);
@@ -2915,6 +2930,85 @@ RoutingProtocol::SendHello () //Helloメッセージを送信
     }
 }
 
+bool
+RoutingProtocol::MakeNeighborDelta (NeighborDeltaHeader &delta)
+{
+  NS_LOG_FUNCTION (this);
+  NeighborSet current (m_nb.GetHelloNeighborList ());
+  std::vector<Ipv4Address> added = current.GetDifference (m_announcedNeighbors);
+  std::vector<Ipv4Address> removed = m_announcedNeighbors.GetDifference (current);
+  uint32_t base = m_announcedDigest;
+  //一定回数ごと、または差分の方が大きい場合は全体を送る
+  if (++m_hellosSinceFullList >= m_helloFullListInterval || added.size () + removed.size () > current.GetSize ())
+    {
+      m_hellosSinceFullList = 0;
+      base = 0;
+      added = current.GetList ();
+      removed.clear ();
+    }
+  else if (added.empty () && removed.empty ())
+    {
+      return false;
+    }
+  m_announcedNeighbors = current;
+  m_announcedDigest = current.GetDigest ();
+  delta = NeighborDeltaHeader (base, added, removed);
+  return true;
+}
+
+void
+RoutingProtocol::ApplyNeighborDelta (Ipv4Address neighbor, uint32_t digest, NeighborDeltaHeader const &delta)
+{
+  NS_LOG_FUNCTION (this << neighbor << digest << delta);
+  std::unordered_map<Ipv4Address, NeighborView, Ipv4AddressHash>::iterator i = m_neighborViews.find (neighbor);
+  if (delta.GetBase () == 0)
+    {
+      if (i == m_neighborViews.end ())
+        {
+          i = m_neighborViews.insert (std::make_pair (neighbor, NeighborView ())).first;
+        }
+      i->second.neighbors.Assign (delta.GetAdded ());
+    }
+  else if (i != m_neighborViews.end () && i->second.digest == delta.GetBase ())
+    {
+      i->second.neighbors.Apply (delta.GetAdded (), delta.GetRemoved ());
+    }
+  else
+    {
+      //基準のリストを持っていない（Hello を取りこぼした）ので次の全体送信を待つ
+      if (i != m_neighborViews.end ())
+        {
+          m_neighborViews.erase (i);
+        }
+      return;
+    }
+  i->second.digest = i->second.neighbors.GetDigest ();
+  if (i->second.digest != digest)
+    {
+      NS_LOG_DEBUG ("Neighbor list of " << neighbor << " does not match its digest");
+      m_neighborViews.erase (i);
+    }
+}
+
+bool
+RoutingProtocol::LookupNeighborView (Ipv4Address neighbor, uint32_t digest, NeighborSet &neighbors)
+{
+  static const uint32_t emptyDigest = NeighborSet ().GetDigest ();
+  std::unordered_map<Ipv4Address, NeighborView, Ipv4AddressHash>::const_iterator i = m_neighborViews.find (neighbor);
+  if (i != m_neighborViews.end () && i->second.digest == digest)
+    {
+      neighbors = i->second.neighbors;
+      return true;
+    }
+  neighbors = NeighborSet ();
+  if (digest == emptyDigest)
+    {
+      return true;
+    }
+  m_whStats.neighborRefMisses++;
+  return false;
+}
+
 void
 RoutingProtocol::SendPacketFromQueue (Ipv4Address dst, Ptr<Ipv4Route> route) //キューからのパケット送信
 {
@@ -2935,7 +3029,7 @@ RoutingProtocol::SendPacketFromQueue (Ipv4Address dst, Ptr<Ipv4Route> route) //
       Ipv4Header header = queueEntry.GetIpv4Header ();
       header.SetSource (route->GetSource ()); //ヘッダのソースノードを取得
       header.SetTtl (header.GetTtl () + 1); // 偽ループバック・ルーティングによる余分なTTLデクリメントを補う
-     // ucb (route, p, header);
+      ucb (route, p, header);
     }
 }
 
@@ -3029,8 +3123,7 @@ RoutingProtocol::SendRerrWhenNoRouteToForward (Ipv4Address dst,
       socket->SendTo (packet, 0, InetSocketAddress (toOrigin.GetNextHop (), AODV_PORT));
     
       //総メッセージ取得
-      m_whStats.totalAodvCtrlMessages++;
-      m_whStats.totalAodvCtrlBytes += packet->GetSize();
+      CountControlPacket (packet);
 
     }
   else
@@ -3055,8 +3148,7 @@ RoutingProtocol::SendRerrWhenNoRouteToForward (Ipv4Address dst,
           socket->SendTo (packet->Copy (), 0, InetSocketAddress (destination, AODV_PORT));
         
           //総メッセージ取得
-          m_whStats.totalAodvCtrlMessages++;
-          m_whStats.totalAodvCtrlBytes += packet->GetSize();
+          CountControlPacket (packet);
         }
     }
 }
@@ -3170,6 +3262,17 @@ void
 RoutingProtocol::DoInitialize (void)
 {
   NS_LOG_FUNCTION (this);
+  m_detectionLog.SetNodeId (GetObject<Node> ()->GetId ());
+  //ノードIDが決まってから統計を登録する
+  StatsRegistry *stats = StatsRegistry::Get ();
+  m_statNode = GetObject<Node> ()->GetId ();
+  m_statTp = stats->RegisterCounter ("aodv.wh.tp");
+  m_statFn = stats->RegisterCounter ("aodv.wh.fn");
+  m_statFp = stats->RegisterCounter ("aodv.wh.fp");
+  m_statTn = stats->RegisterCounter ("aodv.wh.tn");
+  m_statCtrlMessages = stats->RegisterCounter ("aodv.ctrl.messages");
+  m_statCtrlBytes = stats->RegisterCounter ("aodv.ctrl.bytes");
+  m_statRouteTime = stats->RegisterHistogram ("aodv.route.time", 1.0, 100);
   uint32_t startTime;
   if (m_enableHello)
     {
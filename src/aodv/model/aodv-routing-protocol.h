@@ -32,14 +32,20 @@
 #include "aodv-rqueue.h"
 #include "aodv-packet.h"
 #include "aodv-neighbor.h"
+#include "aodv-neighbor-set.h"
 #include "aodv-dpd.h"
+#include "aodv-detection-log.h"
 #include "ns3/node.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4-interface.h"
 #include "ns3/ipv4-l3-protocol.h"
+#include "ns3/stats-registry.h"
+#include "ns3/hdr-histogram.h"
+#include "ns3/traced-callback.h"
 #include <map>
+#include <unordered_map>
 
 namespace ns3 {
 namespace aodv {
@@ -166,6 +172,54 @@ public:
   {
     return m_enableBroadcast;
   }
+  /**
+   * Set detection trace format
+   * \param format the detection trace format
+   */
+  void SetDetectionTraceFormat (DetectionLog::Format format)
+  {
+    m_detectionLog.SetFormat (format);
+  }
+  /**
+   * Get detection trace format
+   * \returns the detection trace format
+   */
+  DetectionLog::Format GetDetectionTraceFormat () const
+  {
+    return m_detectionLog.GetFormat ();
+  }
+  /**
+   * Set detection trace file name prefix
+   * \param name the file name prefix
+   */
+  void SetDetectionTraceFile (std::string name)
+  {
+    m_detectionLog.SetFileName (name);
+  }
+  /**
+   * Get detection trace file name prefix
+   * \returns the file name prefix
+   */
+  std::string GetDetectionTraceFile () const
+  {
+    return m_detectionLog.GetFileName ();
+  }
+  /**
+   * Set detection trace buffer size
+   * \param size the number of records buffered per node
+   */
+  void SetDetectionTraceBufferSize (uint32_t size)
+  {
+    m_detectionLog.SetBufferSize (size);
+  }
+  /**
+   * Get detection trace buffer size
+   * \returns the number of records buffered per node
+   */
+  uint32_t GetDetectionTraceBufferSize () const
+  {
+    return m_detectionLog.GetBufferSize ();
+  }
 
   /**
    * Assign a fixed random variable stream number to the random variables
@@ -204,15 +258,43 @@ public:
 
         //転送されたhelloメッセージを受信した回数
         uint32_t helloForwardedCount = 0;
+
+        uint32_t bloomChecks = 0; // Bloom filter 付き WHE で共通隣接を判定した回数
+        double bloomFalseMatchProbability = 0; // 各判定が誤一致である確率の合計（bloomChecks で割ると推定誤一致率）
+
+        uint64_t helloNeighborBytes = 0; // Hello に載せた隣接リストのダイジェストと差分のバイト数（totalAodvCtrlBytes の内数）
+        uint32_t neighborRefMisses = 0; // 参照された隣接リストがキャッシュになかった回数
     };
 
     WhDetectionStats m_whStats;
 
-    WhDetectionStats Getevaluation()
+    /**
+     * \returns the detection statistics of this node.  Totals over all
+     * nodes are available from StatsRegistry under the "aodv." names
+     * until Simulator::Destroy.
+     */
+    const WhDetectionStats & Getevaluation () const
     {
       return m_whStats;
     }
 
+  /**
+   * TracedCallback signature for completed route discoveries.
+   *
+   * \param [in] dst the destination of the discovery
+   * \param [in] latency the time from the first RREQ to the RREP, including
+   *             the retries and the WHC/WHE verification
+   */
+  typedef void (* RouteLatencyTracedCallback)(Ipv4Address dst, Time latency);
+
+  /**
+   * \returns the route discovery latencies of this node, in microseconds
+   */
+  const HdrHistogram & GetRouteLatencyHistogram () const
+  {
+    return m_routeLatency;
+  }
+
 protected:
   virtual void DoInitialize (void);
 private:
@@ -280,6 +362,89 @@ private:
   DuplicatePacketDetection m_dpd;
   /// Handle neighbors
   Neighbors m_nb;
+  /// Buffered wormhole detection trace
+  DetectionLog m_detectionLog;
+  /// Node slot used in StatsRegistry; it and the ids below are set in DoInitialize
+  uint32_t m_statNode;
+  uint32_t m_statTp;            ///< "aodv.wh.tp" counter id
+  uint32_t m_statFn;            ///< "aodv.wh.fn" counter id
+  uint32_t m_statFp;            ///< "aodv.wh.fp" counter id
+  uint32_t m_statTn;            ///< "aodv.wh.tn" counter id
+  uint32_t m_statCtrlMessages;  ///< "aodv.ctrl.messages" counter id
+  uint32_t m_statCtrlBytes;     ///< "aodv.ctrl.bytes" counter id
+  uint32_t m_statRouteTime;     ///< "aodv.route.time" histogram id
+  /// Start of the pending route discoveries, by destination
+  std::map<Ipv4Address, Time> m_discoveryStart;
+  /// Route discovery latencies, in microseconds
+  HdrHistogram m_routeLatency;
+  /// Fired when a route discovery completes
+  TracedCallback<Ipv4Address, Time> m_routeLatencyTrace;
+  /**
+   * Count a wormhole detection verdict in m_whStats and StatsRegistry
+   * \param field the m_whStats counter
+   * \param id the StatsRegistry counter id
+   */
+  void CountVerdict (uint32_t &field, uint32_t id);
+  /**
+   * Count a sent AODV control packet in m_whStats and StatsRegistry
+   * \param packet the packet
+   */
+  void CountControlPacket (Ptr<const Packet> packet);
+  /// Wire encoding of the neighbor lists we send
+  NeighborListEncoding m_neighborEncoding;
+  /**
+   * \returns the encoding used for RREP neighbor lists
+   */
+  NeighborListEncoding GetRrepNeighborEncoding () const
+  {
+    return m_neighborEncoding == NEIGHBOR_LIST_BLOOM ? NEIGHBOR_LIST_DELTA : GetWheNeighborEncoding ();
+  }
+  /**
+   * \returns the encoding used for WHE neighbor lists
+   */
+  NeighborListEncoding GetWheNeighborEncoding () const
+  {
+    // 参照は Hello で隣接リストを配っている場合だけ使える
+    return m_neighborEncoding == NEIGHBOR_LIST_REF && !m_enableHello ? NEIGHBOR_LIST_DELTA : m_neighborEncoding;
+  }
+  /// Send the whole neighbor list in every n-th Hello when it is referenced (NEIGHBOR_LIST_REF)
+  uint32_t m_helloFullListInterval;
+  /// Hellos sent since the last one with the whole neighbor list
+  uint32_t m_hellosSinceFullList;
+  /// Neighbor list announced in our last Hello, referenced by our RREP and WHE
+  NeighborSet m_announcedNeighbors;
+  /// Digest of m_announcedNeighbors
+  uint32_t m_announcedDigest;
+  /// Neighbor list of a neighbor, learnt from its Hellos
+  struct NeighborView
+  {
+    NeighborSet neighbors; ///< the list
+    uint32_t digest;       ///< its digest
+  };
+  /// Neighbor lists of the neighbors (2-hop neighborhood)
+  std::unordered_map<Ipv4Address, NeighborView, Ipv4AddressHash> m_neighborViews;
+  /**
+   * Make the current neighbor list the announced one
+   * \param delta the delta from the previously announced list, or the whole list
+   * \returns false if the list did not change and the whole list is not due,
+   * the Hello then carries no delta
+   */
+  bool MakeNeighborDelta (NeighborDeltaHeader &delta);
+  /**
+   * Update the list of a neighbor from its Hello
+   * \param neighbor the neighbor
+   * \param digest the digest of its new list
+   * \param delta the changes carried by the Hello
+   */
+  void ApplyNeighborDelta (Ipv4Address neighbor, uint32_t digest, NeighborDeltaHeader const &delta);
+  /**
+   * Resolve a neighbor list sent as a digest (NEIGHBOR_LIST_REF)
+   * \param neighbor the sender of the digest
+   * \param digest the digest
+   * \param neighbors the list, if known
+   * \returns true if the list is known
+   */
+  bool LookupNeighborView (Ipv4Address neighbor, uint32_t digest, NeighborSet &neighbors);
   /// Number of RREQs used for RREQ rate control
   uint16_t m_rreqCount;
   /// Number of RERRs used for RERR rate control
@@ -456,6 +621,8 @@ private:
 
   /// Provides uniform random variables.
   Ptr<UniformRandomVariable> m_uniformRandomVariable;
+  /// Provides the random wormhole decisions, on a stream separate from the jitter
+  Ptr<UniformRandomVariable> m_whDecisionVariable;
   /// Keep track of the last bcast time
   Time m_lastBcastTime;
 
@@ -463,12 +630,24 @@ private:
   {
     RrepHeader rrepHeader;
     Ipv4Address sender;
-    bool detec_end;
     Time sendWHC;
     uint8_t WHForwardFlag;
+    NeighborSet senderNeighbors; ///< RREP 送信者の隣接ノード（整列済み）
+    EventId timeout;             ///< 検証のタイムアウト（CheckResult）
   };
 
-  std::vector<recv_Rrep> Rrep_List;
+  /**
+   * \param origin the RREQ originator
+   * \param id the RREP ID
+   * \returns the key of the RREP in Rrep_List
+   */
+  static uint64_t GetRrepKey (Ipv4Address origin, uint32_t id)
+  {
+    return (static_cast<uint64_t> (origin.Get ()) << 32) | id;
+  }
+
+  /// WHC/WHE 検証中の RREP（(origin, id) がキー）。検証の完了かタイムアウトで削除する
+  std::unordered_map<uint64_t, recv_Rrep> Rrep_List;
 
   std::vector<Ipv4Address> WH_List;
 
@@ -27,7 +27,6 @@
  */
 #include "aodv-rqueue.h"
 #include <algorithm>
-#include <functional>
 #include "ns3/ipv4-route.h"
 #include "ns3/socket.h"
 #include "ns3/log.h"
@@ -48,12 +47,12 @@ bool
 RequestQueue::Enqueue (QueueEntry & entry)
 {
   Purge ();
-  for (std::vector<QueueEntry>::const_iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  Ipv4Address dst = entry.GetIpv4Header ().GetDestination ();
+  std::deque<std::list<QueueEntry>::iterator> &dstQueue = m_dstQueues[dst];
+  for (std::deque<std::list<QueueEntry>::iterator>::const_iterator i = dstQueue.begin ();
+       i != dstQueue.end (); ++i)
     {
-      if ((i->GetPacket ()->GetUid () == entry.GetPacket ()->GetUid ())
-          && (i->GetIpv4Header ().GetDestination ()
-              == entry.GetIpv4Header ().GetDestination ()))
+      if ((*i)->GetPacket ()->GetUid () == entry.GetPacket ()->GetUid ())
         {
           return false;
         }
@@ -62,9 +61,11 @@ RequestQueue::Enqueue (QueueEntry & entry)
   if (m_queue.size () == m_maxLen)
     {
       Drop (m_queue.front (), "Drop the most aged packet"); // Drop the most aged packet
-      m_queue.erase (m_queue.begin ());
+      Erase (m_queue.begin ());
     }
+  // Erase may have removed dstQueue if the dropped packet had the same destination
   m_queue.push_back (entry);
+  m_dstQueues[dst].push_back (--m_queue.end ());
   return true;
 }
 
@@ -73,80 +74,100 @@ RequestQueue::DropPacketWithDst (Ipv4Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
   Purge ();
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  std::unordered_map<Ipv4Address, std::deque<std::list<QueueEntry>::iterator>, Ipv4AddressHash>::iterator d =
+    m_dstQueues.find (dst);
+  if (d == m_dstQueues.end ())
     {
-      if (IsEqual (*i, dst))
-        {
-          Drop (*i, "DropPacketWithDst ");
-        }
+      return;
+    }
+  std::deque<std::list<QueueEntry>::iterator> dstQueue;
+  dstQueue.swap (d->second);
+  m_dstQueues.erase (d);
+  for (std::deque<std::list<QueueEntry>::iterator>::const_iterator i = dstQueue.begin ();
+       i != dstQueue.end (); ++i)
+    {
+      Drop (**i, "DropPacketWithDst ");
+    }
+  for (std::deque<std::list<QueueEntry>::iterator>::const_iterator i = dstQueue.begin ();
+       i != dstQueue.end (); ++i)
+    {
+      m_queue.erase (*i);
     }
-  m_queue.erase (std::remove_if (m_queue.begin (), m_queue.end (),
-                                 std::bind2nd (std::ptr_fun (RequestQueue::IsEqual), dst)), m_queue.end ());
 }
 
 bool
 RequestQueue::Dequeue (Ipv4Address dst, QueueEntry & entry)
 {
   Purge ();
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i != m_queue.end (); ++i)
+  std::unordered_map<Ipv4Address, std::deque<std::list<QueueEntry>::iterator>, Ipv4AddressHash>::const_iterator d =
+    m_dstQueues.find (dst);
+  if (d == m_dstQueues.end ())
     {
-      if (i->GetIpv4Header ().GetDestination () == dst)
-        {
-          entry = *i;
-          m_queue.erase (i);
-          return true;
-        }
+      return false;
     }
-  return false;
+  std::list<QueueEntry>::iterator i = d->second.front ();
+  entry = *i;
+  Erase (i);
+  return true;
 }
 
 bool
 RequestQueue::Find (Ipv4Address dst)
 {
-  for (std::vector<QueueEntry>::const_iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
-    {
-      if (i->GetIpv4Header ().GetDestination () == dst)
-        {
-          return true;
-        }
-    }
-  return false;
+  return m_dstQueues.find (dst) != m_dstQueues.end ();
 }
 
-/**
- * \brief IsExpired structure
- */
-struct IsExpired
+void
+RequestQueue::Erase (std::list<QueueEntry>::iterator i)
 {
-  bool
-  /**
-   * Check if the entry is expired
-   *
-   * \param e QueueEntry entry
-   * \return true if expired, false otherwise
-   */
-  operator() (QueueEntry const & e) const
-  {
-    return (e.GetExpireTime () < Seconds (0));
-  }
-};
+  std::unordered_map<Ipv4Address, std::deque<std::list<QueueEntry>::iterator>, Ipv4AddressHash>::iterator d =
+    m_dstQueues.find (i->GetIpv4Header ().GetDestination ());
+  NS_ASSERT (d != m_dstQueues.end ());
+  if (d->second.front () == i)
+    {
+      d->second.pop_front ();
+    }
+  else
+    {
+      d->second.erase (std::find (d->second.begin (), d->second.end (), i));
+    }
+  if (d->second.empty ())
+    {
+      m_dstQueues.erase (d);
+    }
+  m_queue.erase (i);
+}
 
 void
 RequestQueue::Purge ()
 {
-  IsExpired pred;
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  if (m_expireOrdered)
+    {
+      // The expired entries are the oldest ones
+      while (!m_queue.empty () && m_queue.front ().GetExpireTime () < Seconds (0))
+        {
+          Drop (m_queue.front (), "Drop outdated packet ");
+          Erase (m_queue.begin ());
+        }
+      return;
+    }
+  bool ordered = true;
+  Time last = Seconds (0);
+  for (std::list<QueueEntry>::iterator i = m_queue.begin (); i != m_queue.end (); )
     {
-      if (pred (*i))
+      Time expire = i->GetExpireTime ();
+      if (expire < Seconds (0))
         {
           Drop (*i, "Drop outdated packet ");
+          Erase (i++);
+          continue;
         }
+      ordered = ordered && !(expire < last);
+      last = expire;
+      ++i;
     }
-  m_queue.erase (std::remove_if (m_queue.begin (), m_queue.end (), pred),
-                 m_queue.end ());
+  // New entries are appended with the current timeout, they must not expire before the last one
+  m_expireOrdered = ordered && !(m_queueTimeout < last);
 }
 
 void
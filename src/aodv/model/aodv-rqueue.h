@@ -29,6 +29,9 @@
 #define AODV_RQUEUE_H
 
 #include <vector>
+#include <list>
+#include <deque>
+#include <unordered_map>
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/simulator.h"
 
@@ -176,6 +179,9 @@ private:
  * \brief AODV route request queue
  *
  * Since AODV is an on demand routing we queue requests while looking for route.
+ *
+ * The entries are kept in one list, oldest first, and indexed by destination,
+ * so that the operations on one destination only visit its own entries.
  */
 class RequestQueue
 {
@@ -188,7 +194,8 @@ public:
    */
   RequestQueue (uint32_t maxLen, Time routeToQueueTimeout)
     : m_maxLen (maxLen),
-      m_queueTimeout (routeToQueueTimeout)
+      m_queueTimeout (routeToQueueTimeout),
+      m_expireOrdered (true)
   {
   }
   /**
@@ -253,14 +260,26 @@ public:
    */
   void SetQueueTimeout (Time t)
   {
+    if (t < m_queueTimeout)
+      {
+        // entries queued from now on may expire before the older ones
+        m_expireOrdered = false;
+      }
     m_queueTimeout = t;
   }
 
 private:
-  /// The queue
-  std::vector<QueueEntry> m_queue;
+  /// The queue, oldest entry first
+  std::list<QueueEntry> m_queue;
+  /// destination -> its entries in m_queue, oldest first
+  std::unordered_map<Ipv4Address, std::deque<std::list<QueueEntry>::iterator>, Ipv4AddressHash> m_dstQueues;
   /// Remove all expired entries
   void Purge ();
+  /**
+   * Remove an entry from the queue and from its destination index
+   * \param i the entry
+   */
+  void Erase (std::list<QueueEntry>::iterator i);
   /**
    * Notify that packet is dropped from queue by timeout
    * \param en the queue entry to drop
@@ -271,16 +290,8 @@ private:
   uint32_t m_maxLen;
   /// The maximum period of time that a routing protocol is allowed to buffer a packet for, seconds.
   Time m_queueTimeout;
-  /**
-   * Determine if queue matches a destination address
-   * \param en The queue entry
-   * \param dst The destination IPv4 address
-   * \returns true if the queue entry matches the destination address
-   */
-  static bool IsEqual (QueueEntry en, const Ipv4Address dst)
-  {
-    return (en.GetIpv4Header ().GetDestination () == dst);
-  }
+  /// true if m_queue is also sorted by expire time, false after the queue timeout was shortened
+  bool m_expireOrdered;
 };
 
 
@@ -221,8 +221,7 @@ RoutingTable::LookupRoute (Ipv4Address id, RoutingTableEntry & rt)
       NS_LOG_LOGIC ("Route to " << id << " not found; m_ipv4AddressEntry is empty");
       return false;
     }
-  std::map<Ipv4Address, RoutingTableEntry>::const_iterator i =
-    m_ipv4AddressEntry.find (id);
+  EntryMap::const_iterator i = m_ipv4AddressEntry.find (id);
   if (i == m_ipv4AddressEntry.end ())
     {
       NS_LOG_LOGIC ("Route to " << id << " not found");
@@ -251,8 +250,10 @@ RoutingTable::DeleteRoute (Ipv4Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
   Purge ();
-  if (m_ipv4AddressEntry.erase (dst) != 0)
+  EntryMap::iterator i = m_ipv4AddressEntry.find (dst);
+  if (i != m_ipv4AddressEntry.end ())
     {
+      Erase (i);
       NS_LOG_LOGIC ("Route deletion to " << dst << " successful");
       return true;
     }
@@ -269,8 +270,13 @@ RoutingTable::AddRoute (RoutingTableEntry & rt)
     {
       rt.SetRreqCnt (0);
     }
-  std::pair<std::map<Ipv4Address, RoutingTableEntry>::iterator, bool> result =
+  std::pair<EntryMap::iterator, bool> result =
     m_ipv4AddressEntry.insert (std::make_pair (rt.GetDestination (), rt));
+  if (result.second)
+    {
+      IndexNextHop (rt.GetDestination (), rt.GetNextHop ());
+      PushExpiry (rt);
+    }
   return result.second;
 }
 
@@ -278,19 +284,22 @@ bool
 RoutingTable::Update (RoutingTableEntry & rt)
 {
   NS_LOG_FUNCTION (this);
-  std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-    m_ipv4AddressEntry.find (rt.GetDestination ());
+  EntryMap::iterator i = m_ipv4AddressEntry.find (rt.GetDestination ());
   if (i == m_ipv4AddressEntry.end ())
     {
       NS_LOG_LOGIC ("Route update to " << rt.GetDestination () << " fails; not found");
       return false;
     }
+  // The entries share their Ipv4Route with the copies handed out by LookupRoute,
+  // so the previous next hop may already be overwritten: its index is cleaned lazily.
+  IndexNextHop (i->first, rt.GetNextHop ());
   i->second = rt;
   if (i->second.GetFlag () != IN_SEARCH)
     {
       NS_LOG_LOGIC ("Route update to " << rt.GetDestination () << " set RreqCnt to 0");
       i->second.SetRreqCnt (0);
     }
+  PushExpiry (i->second);
   return true;
 }
 
@@ -298,8 +307,7 @@ bool
 RoutingTable::SetEntryState (Ipv4Address id, RouteFlags state)
 {
   NS_LOG_FUNCTION (this);
-  std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-    m_ipv4AddressEntry.find (id);
+  EntryMap::iterator i = m_ipv4AddressEntry.find (id);
   if (i == m_ipv4AddressEntry.end ())
     {
       NS_LOG_LOGIC ("Route set entry state to " << id << " fails; not found");
@@ -307,6 +315,8 @@ RoutingTable::SetEntryState (Ipv4Address id, RouteFlags state)
     }
   i->second.SetFlag (state);
   i->second.SetRreqCnt (0);
+  // An expired IN_SEARCH entry has left the heap, push it back for its new state
+  PushExpiry (i->second);
   NS_LOG_LOGIC ("Route set entry state to " << id << ": new state is " << state);
   return true;
 }
@@ -317,14 +327,29 @@ RoutingTable::GetListOfDestinationWithNextHop (Ipv4Address nextHop, std::map<Ipv
   NS_LOG_FUNCTION (this);
   Purge ();
   unreachable.clear ();
-  for (std::map<Ipv4Address, RoutingTableEntry>::const_iterator i =
-         m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); ++i)
+  std::unordered_map<Ipv4Address, std::unordered_set<Ipv4Address, Ipv4AddressHash>, Ipv4AddressHash>::iterator j =
+    m_nextHopIndex.find (nextHop);
+  if (j == m_nextHopIndex.end ())
+    {
+      return;
+    }
+  for (std::unordered_set<Ipv4Address, Ipv4AddressHash>::iterator k = j->second.begin ();
+       k != j->second.end (); )
     {
-      if (i->second.GetNextHop () == nextHop)
+      EntryMap::const_iterator i = m_ipv4AddressEntry.find (*k);
+      if (i == m_ipv4AddressEntry.end () || i->second.GetNextHop () != nextHop)
         {
-          NS_LOG_LOGIC ("Unreachable insert " << i->first << " " << i->second.GetSeqNo ());
-          unreachable.insert (std::make_pair (i->first, i->second.GetSeqNo ()));
+          // stale destination, deleted or routed through another next hop
+          k = j->second.erase (k);
+          continue;
         }
+      NS_LOG_LOGIC ("Unreachable insert " << i->first << " " << i->second.GetSeqNo ());
+      unreachable.insert (std::make_pair (i->first, i->second.GetSeqNo ()));
+      ++k;
+    }
+  if (j->second.empty ())
+    {
+      m_nextHopIndex.erase (j);
     }
 }
 
@@ -333,17 +358,15 @@ RoutingTable::InvalidateRoutesWithDst (const std::map<Ipv4Address, uint32_t> & u
 {
   NS_LOG_FUNCTION (this);
   Purge ();
-  for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-         m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); ++i)
+  for (std::map<Ipv4Address, uint32_t>::const_iterator j =
+         unreachable.begin (); j != unreachable.end (); ++j)
     {
-      for (std::map<Ipv4Address, uint32_t>::const_iterator j =
-             unreachable.begin (); j != unreachable.end (); ++j)
+      EntryMap::iterator i = m_ipv4AddressEntry.find (j->first);
+      if (i != m_ipv4AddressEntry.end () && i->second.GetFlag () == VALID)
         {
-          if ((i->first == j->first) && (i->second.GetFlag () == VALID))
-            {
-              NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
-              i->second.Invalidate (m_badLinkLifetime);
-            }
+          NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
+          i->second.Invalidate (m_badLinkLifetime);
+          PushExpiry (i->second);
         }
     }
 }
@@ -356,14 +379,11 @@ RoutingTable::DeleteAllRoutesFromInterface (Ipv4InterfaceAddress iface)
     {
       return;
     }
-  for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-         m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); )
+  for (EntryMap::iterator i = m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); )
     {
       if (i->second.GetInterface () == iface)
         {
-          std::map<Ipv4Address, RoutingTableEntry>::iterator tmp = i;
-          ++i;
-          m_ipv4AddressEntry.erase (tmp);
+          i = Erase (i);
         }
       else
         {
@@ -372,41 +392,95 @@ RoutingTable::DeleteAllRoutesFromInterface (Ipv4InterfaceAddress iface)
     }
 }
 
+void
+RoutingTable::Clear ()
+{
+  m_ipv4AddressEntry.clear ();
+  m_expiry = std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > ();
+  m_nextHopIndex.clear ();
+}
+
 void
 RoutingTable::Purge ()
 {
   NS_LOG_FUNCTION (this);
-  if (m_ipv4AddressEntry.empty ())
-    {
-      return;
-    }
-  for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-         m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); )
+  Time now = Simulator::Now ();
+  while (!m_expiry.empty () && m_expiry.top ().first < now)
     {
-      if (i->second.GetLifeTime () < Seconds (0))
+      ExpiryItem item = m_expiry.top ();
+      m_expiry.pop ();
+      EntryMap::iterator i = m_ipv4AddressEntry.find (item.second);
+      if (i == m_ipv4AddressEntry.end () || i->second.GetLifeTime () + now != item.first)
         {
-          if (i->second.GetFlag () == INVALID)
-            {
-              std::map<Ipv4Address, RoutingTableEntry>::iterator tmp = i;
-              ++i;
-              m_ipv4AddressEntry.erase (tmp);
-            }
-          else if (i->second.GetFlag () == VALID)
-            {
-              NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
-              i->second.Invalidate (m_badLinkLifetime);
-              ++i;
-            }
-          else
-            {
-              ++i;
-            }
+          // stale item of a deleted or updated entry
+          continue;
         }
-      else
+      if (i->second.GetFlag () == INVALID)
         {
-          ++i;
+          Erase (i);
         }
+      else if (i->second.GetFlag () == VALID)
+        {
+          NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
+          i->second.Invalidate (m_badLinkLifetime);
+          PushExpiry (i->second);
+        }
+      // expired IN_SEARCH entries are kept, Update or SetEntryState push them again
+    }
+}
+
+void
+RoutingTable::PushExpiry (const RoutingTableEntry &rt)
+{
+  m_expiry.push (std::make_pair (rt.GetLifeTime () + Simulator::Now (), rt.GetDestination ()));
+  if (m_expiry.size () > 4 * m_ipv4AddressEntry.size () + 64)
+    {
+      RebuildExpiry ();
+    }
+}
+
+void
+RoutingTable::RebuildExpiry ()
+{
+  NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
+  std::vector<ExpiryItem> items;
+  items.reserve (m_ipv4AddressEntry.size ());
+  for (EntryMap::const_iterator i = m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); ++i)
+    {
+      items.push_back (std::make_pair (i->second.GetLifeTime () + now, i->first));
+    }
+  m_expiry = std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> >
+      (std::greater<ExpiryItem> (), items);
+}
+
+void
+RoutingTable::IndexNextHop (Ipv4Address dst, Ipv4Address nextHop)
+{
+  m_nextHopIndex[nextHop].insert (dst);
+}
+
+void
+RoutingTable::UnindexNextHop (Ipv4Address dst, Ipv4Address nextHop)
+{
+  std::unordered_map<Ipv4Address, std::unordered_set<Ipv4Address, Ipv4AddressHash>, Ipv4AddressHash>::iterator j =
+    m_nextHopIndex.find (nextHop);
+  if (j == m_nextHopIndex.end ())
+    {
+      return;
     }
+  j->second.erase (dst);
+  if (j->second.empty ())
+    {
+      m_nextHopIndex.erase (j);
+    }
+}
+
+RoutingTable::EntryMap::iterator
+RoutingTable::Erase (EntryMap::iterator i)
+{
+  UnindexNextHop (i->first, i->second.GetNextHop ());
+  return m_ipv4AddressEntry.erase (i);
 }
 
 void
@@ -450,8 +524,7 @@ bool
 RoutingTable::MarkLinkAsUnidirectional (Ipv4Address neighbor, Time blacklistTimeout)
 {
   NS_LOG_FUNCTION (this << neighbor << blacklistTimeout.GetSeconds ());
-  std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-    m_ipv4AddressEntry.find (neighbor);
+  EntryMap::iterator i = m_ipv4AddressEntry.find (neighbor);
   if (i == m_ipv4AddressEntry.end ())
     {
       NS_LOG_LOGIC ("Mark link unidirectional to  " << neighbor << " fails; not found");
@@ -467,7 +540,7 @@ RoutingTable::MarkLinkAsUnidirectional (Ipv4Address neighbor, Time blacklistTime
 void
 RoutingTable::Print (Ptr<OutputStreamWrapper> stream) const
 {
-  std::map<Ipv4Address, RoutingTableEntry> table = m_ipv4AddressEntry;
+  std::map<Ipv4Address, RoutingTableEntry> table (m_ipv4AddressEntry.begin (), m_ipv4AddressEntry.end ());
   Purge (table);
   *stream->GetStream () << "\nAODV Routing table\n"
                         << "Destination\tGateway\t\tInterface\tFlag\tExpire\t\tHops\n";
@@ -31,6 +31,10 @@
 #include <stdint.h>
 #include <cassert>
 #include <map>
+#include <queue>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 #include <sys/types.h>
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-route.h"
@@ -400,6 +404,10 @@ private:
 /**
  * \ingroup aodv
  * \brief The Routing table used by AODV protocol
+ *
+ * Entries are hashed by destination.  Their expire times are kept in a
+ * min-heap, so Purge only visits the entries which have expired, and the
+ * destinations are indexed by next hop for the RERR generation.
  */
 class RoutingTable
 {
@@ -481,10 +489,7 @@ public:
    */
   void DeleteAllRoutesFromInterface (Ipv4InterfaceAddress iface);
   /// Delete all entries from routing table
-  void Clear ()
-  {
-    m_ipv4AddressEntry.clear ();
-  }
+  void Clear ();
   /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
   void Purge ();
   /** Mark entry as unidirectional (e.g. add this neighbor to "blacklist" for blacklistTimeout period)
@@ -500,10 +505,44 @@ public:
   void Print (Ptr<OutputStreamWrapper> stream) const;
 
 private:
+  /// destination -> entry
+  typedef std::unordered_map<Ipv4Address, RoutingTableEntry, Ipv4AddressHash> EntryMap;
   /// The routing table
-  std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
+  EntryMap m_ipv4AddressEntry;
   /// Deletion time for invalid routes
   Time m_badLinkLifetime;
+  /// (expire time, destination) pair of the expiry heap
+  typedef std::pair<Time, Ipv4Address> ExpiryItem;
+  /// Min-heap of expire times.  Updated entries leave stale items behind which are skipped on pop.
+  std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem> > m_expiry;
+  /// next hop -> destinations routed through it, may hold stale destinations which are checked on use
+  std::unordered_map<Ipv4Address, std::unordered_set<Ipv4Address, Ipv4AddressHash>, Ipv4AddressHash> m_nextHopIndex;
+
+  /**
+   * Add expire time of an entry to the expiry heap
+   * \param rt the entry
+   */
+  void PushExpiry (const RoutingTableEntry &rt);
+  /// Rebuild the expiry heap from the entries, dropping the stale items
+  void RebuildExpiry ();
+  /**
+   * Add a destination to the next hop index
+   * \param dst the destination
+   * \param nextHop its next hop
+   */
+  void IndexNextHop (Ipv4Address dst, Ipv4Address nextHop);
+  /**
+   * Remove a destination from the next hop index
+   * \param dst the destination
+   * \param nextHop its current next hop
+   */
+  void UnindexNextHop (Ipv4Address dst, Ipv4Address nextHop);
+  /**
+   * Remove an entry and its next hop index
+   * \param i the entry
+   * \returns the entry following i
+   */
+  EntryMap::iterator Erase (EntryMap::iterator i);
   /**
    * const version of Purge, for use by Print() method
    * \param table the routing table entry to purge
@@ -105,6 +105,62 @@ IdCacheTest::CheckTimeout3 ()
   NS_TEST_EXPECT_MSG_EQ (cache.GetSize (), 0, "All records expire");
 }
 
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Unit test for id cache expiry with a shortened lifetime and many records
+ */
+class IdCacheExpiryTest : public TestCase
+{
+public:
+  IdCacheExpiryTest () : TestCase ("Id Cache expiry"),
+                         cache (Seconds (10))
+  {
+  }
+  virtual void DoRun ();
+
+private:
+  /**
+   * Check the cache at some time
+   * \param size the expected number of records
+   */
+  void CheckSize (uint32_t size);
+
+  /// ID cache
+  IdCache cache;
+};
+
+void
+IdCacheExpiryTest::DoRun ()
+{
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (cache.IsDuplicate (Ipv4Address (0x0a000000 + i % 100), i / 100), false, "Unknown ID & address");
+    }
+  NS_TEST_EXPECT_MSG_EQ (cache.IsDuplicate (Ipv4Address ("10.0.0.99"), 9), true, "Known address & ID");
+  NS_TEST_EXPECT_MSG_EQ (cache.IsDuplicate (Ipv4Address ("10.0.0.99"), 10), false, "Unknown ID");
+  // Records added later with a shorter lifetime expire first
+  cache.SetLifetime (Seconds (2));
+  cache.IsDuplicate (Ipv4Address ("1.1.1.1"), 1);
+  NS_TEST_EXPECT_MSG_EQ (cache.GetSize (), 1002, "trivial");
+
+  Simulator::Schedule (Seconds (3), &IdCacheExpiryTest::CheckSize, this, 1001);
+  Simulator::Schedule (Seconds (11), &IdCacheExpiryTest::CheckSize, this, 0);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+IdCacheExpiryTest::CheckSize (uint32_t size)
+{
+  NS_TEST_EXPECT_MSG_EQ (cache.GetSize (), size, "records left at " << Simulator::Now ().GetSeconds ());
+  if (size == 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (cache.IsDuplicate (Ipv4Address ("10.0.0.99"), 9), false, "Expired ID");
+    }
+}
+
 /**
  * \ingroup aodv-test
  * \ingroup tests
@@ -117,6 +173,7 @@ public:
   IdCacheTestSuite () : TestSuite ("aodv-routing-id-cache", UNIT)
   {
     AddTestCase (new IdCacheTest, TestCase::QUICK);
+    AddTestCase (new IdCacheExpiryTest, TestCase::QUICK);
   }
 } g_idCacheTestSuite; ///< the test suite
 
@@ -19,10 +19,24 @@
  */
 #include "ns3/test.h"
 #include "ns3/aodv-neighbor.h"
+#include "ns3/aodv-neighbor-set.h"
 #include "ns3/aodv-packet.h"
 #include "ns3/aodv-rqueue.h"
 #include "ns3/aodv-rtable.h"
+#include "ns3/aodv-detection-log.h"
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/pointer.h"
 #include "ns3/ipv4-route.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/aodv-helper.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 
 namespace ns3 {
 namespace aodv {
@@ -109,6 +123,110 @@ NeighborTest::DoRun ()
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Unit test for the cached HELLO neighbor list
+ */
+struct HelloNeighborListTest : public TestCase
+{
+  HelloNeighborListTest () : TestCase ("HelloNeighborList"),
+                             neighbor (0),
+                             version (0)
+  {
+  }
+  virtual void DoRun ();
+  /// Check that the expired member left the list
+  void CheckExpired ();
+  /// The Neighbors
+  Neighbors * neighbor;
+  /// version seen before expiry
+  uint32_t version;
+};
+
+void
+HelloNeighborListTest::CheckExpired ()
+{
+  std::vector<Ipv4Address> list = neighbor->GetHelloNeighborList ();
+  NS_TEST_EXPECT_MSG_EQ (list.size (), 1, "expired member removed");
+  NS_TEST_EXPECT_MSG_EQ (list[0], Ipv4Address ("10.0.0.2"), "remaining member");
+  NS_TEST_EXPECT_MSG_NE (neighbor->GetHelloNeighborVersion (), version, "version changed");
+}
+
+void
+HelloNeighborListTest::DoRun ()
+{
+  Neighbors nb (Seconds (1));
+  neighbor = &nb;
+  nb.Update (Ipv4Address ("10.0.0.9"), Seconds (10));
+  nb.UpdateFromHello (Ipv4Address ("10.0.0.5"), Seconds (2));
+  nb.UpdateFromHello (Ipv4Address ("10.0.0.2"), Seconds (10));
+  std::vector<Ipv4Address> list = nb.GetHelloNeighborList ();
+  NS_TEST_EXPECT_MSG_EQ (list.size (), 2, "only HELLO neighbors");
+  NS_TEST_EXPECT_MSG_EQ (list[0], Ipv4Address ("10.0.0.2"), "sorted");
+  NS_TEST_EXPECT_MSG_EQ (list[1], Ipv4Address ("10.0.0.5"), "sorted");
+  version = nb.GetHelloNeighborVersion ();
+  nb.UpdateFromHello (Ipv4Address ("10.0.0.2"), Seconds (10));
+  nb.Update (Ipv4Address ("10.0.0.9"), Seconds (10));
+  NS_TEST_EXPECT_MSG_EQ (nb.GetHelloNeighborVersion (), version, "membership unchanged");
+  NS_TEST_EXPECT_MSG_EQ (nb.IsNeighbor (Ipv4Address ("10.0.0.9")), true, "Neighbor exists");
+  Simulator::Schedule (Seconds (3), &HelloNeighborListTest::CheckExpired, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Unit test for neighbor set intersection
+ */
+struct NeighborSetTest : public TestCase
+{
+  NeighborSetTest () : TestCase ("NeighborSet")
+  {
+  }
+  /**
+   * Skip predicate used by the test
+   * \param a the address
+   * \returns true for 10.0.0.3
+   */
+  static bool SkipThree (Ipv4Address a)
+  {
+    return a == Ipv4Address ("10.0.0.3");
+  }
+  virtual void DoRun ()
+  {
+    std::vector<Ipv4Address> l1;
+    l1.push_back (Ipv4Address ("10.0.0.7"));
+    l1.push_back (Ipv4Address ("10.0.0.3"));
+    l1.push_back (Ipv4Address ("10.0.0.5"));
+    l1.push_back (Ipv4Address ("10.0.0.3"));
+    std::vector<Ipv4Address> l2;
+    l2.push_back (Ipv4Address ("10.0.0.5"));
+    l2.push_back (Ipv4Address ("10.0.0.9"));
+    l2.push_back (Ipv4Address ("10.0.0.3"));
+    NeighborSet a (l1);
+    NeighborSet b (l2);
+    NS_TEST_EXPECT_MSG_EQ (a.GetSize (), 3, "duplicates removed");
+    NS_TEST_EXPECT_MSG_EQ (a.Get (0), Ipv4Address ("10.0.0.3"), "sorted");
+    NS_TEST_EXPECT_MSG_EQ (a.Contains (Ipv4Address ("10.0.0.7")), true, "member");
+    NS_TEST_EXPECT_MSG_EQ (a.Contains (Ipv4Address ("10.0.0.9")), false, "not a member");
+    NS_TEST_EXPECT_MSG_EQ (a.CountCommon (b), 2, "two common neighbors");
+    NS_TEST_EXPECT_MSG_EQ (b.CountCommon (a), 2, "symmetric");
+    NS_TEST_EXPECT_MSG_EQ_TOL (a.Jaccard (b), 0.5, 1e-9, "2 / 4");
+    Ipv4Address match;
+    NS_TEST_EXPECT_MSG_EQ (a.FindFirstCommon (b, match), true, "common neighbor found");
+    NS_TEST_EXPECT_MSG_EQ (match, Ipv4Address ("10.0.0.3"), "smallest common neighbor");
+    NS_TEST_EXPECT_MSG_EQ (a.FindFirstCommon (b, match, &NeighborSetTest::SkipThree), true, "second common neighbor");
+    NS_TEST_EXPECT_MSG_EQ (match, Ipv4Address ("10.0.0.5"), "skipped address ignored");
+    NeighborSet empty;
+    NS_TEST_EXPECT_MSG_EQ (a.FindFirstCommon (empty, match), false, "nothing in common");
+    NS_TEST_EXPECT_MSG_EQ (empty.Jaccard (empty), 0.0, "empty sets");
+  }
+};
+
 /**
  * \ingroup aodv-test
  * \ingroup tests
@@ -182,7 +300,7 @@ struct RreqHeaderTest : public TestCase
     p->AddHeader (h);
     RreqHeader h2;
     uint32_t bytes = p->RemoveHeader (h2);
-    NS_TEST_EXPECT_MSG_EQ (bytes, 23, "RREP is 23 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (bytes, 24, "RREQ is 23 bytes long plus the wormhole forward flag");
     NS_TEST_EXPECT_MSG_EQ (h, h2, "Round trip serialization works");
 
   }
@@ -235,11 +353,174 @@ struct RrepHeaderTest : public TestCase
     p->AddHeader (h);
     RrepHeader h2;
     uint32_t bytes = p->RemoveHeader (h2);
-    NS_TEST_EXPECT_MSG_EQ (bytes, 19, "RREP is 19 bytes long");
+    NS_TEST_EXPECT_MSG_EQ (bytes, 30, "RREP is 19 bytes long plus size, ID, next node and wormhole forward flag");
     NS_TEST_EXPECT_MSG_EQ (h, h2, "Round trip serialization works");
   }
 };
 
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Unit test for the compact neighbor list encodings of RREP and WHE
+ */
+struct NeighborListEncodingTest : public TestCase
+{
+  NeighborListEncodingTest () : TestCase ("AODV neighbor list encoding")
+  {
+  }
+  /**
+   * Skip predicate used by the test
+   * \returns false
+   */
+  static bool NoSkip (Ipv4Address)
+  {
+    return false;
+  }
+  virtual void DoRun ()
+  {
+    std::vector<Ipv4Address> list;
+    for (uint32_t k = 20; k > 0; k--)
+      {
+        list.push_back (Ipv4Address (0x0a000000 + 3 * k));
+      }
+    NeighborSet set (list);
+
+    RrepHeader raw (0, 1, Ipv4Address ("10.0.0.1"), 2, Ipv4Address ("10.0.0.2"), Seconds (3), list, list.size (), 7);
+    RrepHeader delta = raw;
+    delta.SetNeighborEncoding (NEIGHBOR_LIST_DELTA);
+    NS_TEST_EXPECT_MSG_EQ (raw.GetNeighborListSize (), 80, "4 bytes per raw address");
+    NS_TEST_EXPECT_MSG_EQ (delta.GetNeighborListSize (), 4 + 19, "first address then 1 byte deltas");
+    Ptr<Packet> p = Create<Packet> ();
+    p->AddHeader (delta);
+    RrepHeader h;
+    uint32_t bytes = p->RemoveHeader (h);
+    NS_TEST_EXPECT_MSG_EQ (bytes, 30 + 23, "delta RREP size");
+    NS_TEST_EXPECT_MSG_EQ (h.GetNeighborEncoding (), NEIGHBOR_LIST_DELTA, "encoding carried in flags");
+    NS_TEST_EXPECT_MSG_EQ ((NeighborSet (h.GetNeighbors ()).GetList () == set.GetList ()), true, "delta round trip");
+    NS_TEST_EXPECT_MSG_EQ (h.GetAckRequired (), false, "encoding does not touch the ACK flag");
+
+    WHEHeader whe (5, Ipv4Address ("10.0.0.2"), list, list.size ());
+    whe.SetNeighborEncoding (NEIGHBOR_LIST_DELTA);
+    p = Create<Packet> ();
+    p->AddHeader (whe);
+    WHEHeader w;
+    bytes = p->RemoveHeader (w);
+    NS_TEST_EXPECT_MSG_EQ (bytes, 14 + 23, "delta WHE size");
+    NS_TEST_EXPECT_MSG_EQ (w.GetSize (), 20, "size without encoding bits");
+    NS_TEST_EXPECT_MSG_EQ ((NeighborSet (w.GetNeighbors ()).GetList () == set.GetList ()), true, "delta round trip");
+
+    whe.SetNeighborEncoding (NEIGHBOR_LIST_BLOOM);
+    p = Create<Packet> ();
+    p->AddHeader (whe);
+    bytes = p->RemoveHeader (w);
+    NS_TEST_EXPECT_MSG_EQ (bytes, 14 + 1 + 4 * NeighborBloomFilter::DEFAULT_WORDS, "Bloom WHE size");
+    NS_TEST_EXPECT_MSG_EQ (w.GetNeighborEncoding (), NEIGHBOR_LIST_BLOOM, "encoding carried in size");
+    NS_TEST_EXPECT_MSG_EQ (w.GetNeighbors ().size (), 0, "no address list");
+    for (uint32_t k = 0; k < list.size (); k++)
+      {
+        NS_TEST_EXPECT_MSG_EQ (w.GetNeighborFilter ().MayContain (list[k]), true, "no false negative");
+      }
+    Ptr<Packet> again = Create<Packet> ();
+    again->AddHeader (w);
+    NS_TEST_EXPECT_MSG_EQ (again->GetSize (), bytes, "received filter is forwarded unchanged");
+
+    // 偽陽性率は理論値の程度に収まる
+    uint32_t hits = 0;
+    uint32_t probes = 0;
+    for (uint32_t k = 0; k < 10000; k++)
+      {
+        Ipv4Address other (0x0b000000 + k);
+        hits += w.GetNeighborFilter ().MayContain (other);
+        probes++;
+      }
+    double rate = w.GetNeighborFilter ().GetFalsePositiveRate (list.size ());
+    NS_TEST_EXPECT_MSG_LT (rate, 0.01, "20 addresses in 512 bits");
+    NS_TEST_EXPECT_MSG_LT (static_cast<double> (hits) / probes, 3 * rate + 0.001, "false positive rate");
+
+    Ipv4Address match;
+    uint32_t n = 0;
+    NS_TEST_EXPECT_MSG_EQ (set.FindFirstIn (w.GetNeighborFilter (), match, n, &NeighborListEncodingTest::NoSkip), true, "member found");
+    NS_TEST_EXPECT_MSG_EQ (match, set.Get (0), "smallest member");
+    NS_TEST_EXPECT_MSG_EQ (n, 1, "one probe");
+  }
+};
+
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Unit test for neighbor lists sent as Hello deltas and referenced by digest
+ */
+struct NeighborListRefTest : public TestCase
+{
+  NeighborListRefTest () : TestCase ("AODV neighbor list reference")
+  {
+  }
+  virtual void DoRun ()
+  {
+    std::vector<Ipv4Address> l1;
+    std::vector<Ipv4Address> l2;
+    for (uint32_t k = 1; k <= 20; k++)
+      {
+        l1.push_back (Ipv4Address (0x0a000000 + k));
+        if (k != 4 && k != 9)
+          {
+            l2.push_back (Ipv4Address (0x0a000000 + k));
+          }
+      }
+    l2.push_back (Ipv4Address ("10.0.0.30"));
+    NeighborSet before (l1);
+    NeighborSet after (l2);
+
+    // 送信側: 前回の Hello からの差分
+    std::vector<Ipv4Address> added = after.GetDifference (before);
+    std::vector<Ipv4Address> removed = before.GetDifference (after);
+    NS_TEST_EXPECT_MSG_EQ (added.size (), 1, "one address added");
+    NS_TEST_EXPECT_MSG_EQ (added[0], Ipv4Address ("10.0.0.30"), "added address");
+    NS_TEST_EXPECT_MSG_EQ (removed.size (), 2, "two addresses removed");
+    NS_TEST_EXPECT_MSG_EQ (removed[1], Ipv4Address ("10.0.0.9"), "removed in ascending order");
+
+    NeighborDeltaHeader delta (before.GetDigest (), added, removed);
+    Ptr<Packet> p = Create<Packet> ();
+    p->AddHeader (delta);
+    NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 8 + 4 + 4 + 1, "base, counts, then delta coded lists");
+    NeighborDeltaHeader d;
+    p->RemoveHeader (d);
+    NS_TEST_EXPECT_MSG_EQ ((d == delta), true, "delta round trip");
+
+    // 受信側: キャッシュした一覧に差分を適用するとダイジェストが一致する
+    NeighborSet view (l1);
+    view.Apply (d.GetAdded (), d.GetRemoved ());
+    NS_TEST_EXPECT_MSG_EQ ((view.GetList () == after.GetList ()), true, "delta applied");
+    NS_TEST_EXPECT_MSG_EQ (view.GetDigest (), after.GetDigest (), "digest of the new list");
+    NS_TEST_EXPECT_MSG_NE (before.GetDigest (), after.GetDigest (), "digest follows the content");
+    NS_TEST_EXPECT_MSG_NE (NeighborSet ().GetDigest (), 0, "zero digest is reserved");
+
+    // RREP と WHE はダイジェストだけを運ぶ
+    RrepHeader rrep (0, 1, Ipv4Address ("10.0.0.1"), 2, Ipv4Address ("10.0.0.2"), Seconds (3), l2, l2.size (), 7);
+    rrep.SetNeighborEncoding (NEIGHBOR_LIST_REF);
+    rrep.SetNeighborDigest (after.GetDigest ());
+    p = Create<Packet> ();
+    p->AddHeader (rrep);
+    RrepHeader h;
+    NS_TEST_EXPECT_MSG_EQ (p->RemoveHeader (h), 30 + 4, "RREP with a digest");
+    NS_TEST_EXPECT_MSG_EQ (h.GetNeighborEncoding (), NEIGHBOR_LIST_REF, "encoding carried in flags");
+    NS_TEST_EXPECT_MSG_EQ (h.GetNeighborDigest (), after.GetDigest (), "digest round trip");
+    NS_TEST_EXPECT_MSG_EQ (h.GetNeighbors ().size (), 0, "no address list");
+
+    WHEHeader whe (5, Ipv4Address ("10.0.0.2"), l2, l2.size ());
+    whe.SetNeighborEncoding (NEIGHBOR_LIST_REF);
+    whe.SetNeighborDigest (after.GetDigest ());
+    p = Create<Packet> ();
+    p->AddHeader (whe);
+    WHEHeader w;
+    NS_TEST_EXPECT_MSG_EQ (p->RemoveHeader (w), 14 + 4, "WHE with a digest");
+    NS_TEST_EXPECT_MSG_EQ (w.GetNeighborEncoding (), NEIGHBOR_LIST_REF, "encoding carried in size");
+    NS_TEST_EXPECT_MSG_EQ (w.GetNeighborDigest (), after.GetDigest (), "digest round trip");
+  }
+};
+
 /**
  * \ingroup aodv-test
  * \ingroup tests
@@ -296,6 +577,97 @@ struct RerrHeaderTest : public TestCase
   }
 };
 
+/// Unit test for RequestQueue with many destinations
+struct AodvRqueueIndexTest : public TestCase
+{
+  AodvRqueueIndexTest () : TestCase ("RqueueIndex"),
+                           q (8, Seconds (10)),
+                           drops (0)
+  {
+  }
+  /**
+   * Error test function, counts the dropped packets
+   * \param p The packet
+   * \param h The header
+   * \param e the socket error
+   */
+  void Error (Ptr<const Packet> p, const Ipv4Header & h, Socket::SocketErrno e)
+  {
+    drops++;
+  }
+  /**
+   * Enqueue a new packet
+   * \param dst the destination
+   * \returns the packet
+   */
+  Ptr<const Packet> Enqueue (Ipv4Address dst)
+  {
+    Ptr<const Packet> packet = Create<Packet> ();
+    Ipv4Header h;
+    h.SetDestination (dst);
+    QueueEntry e (packet, h, Ipv4RoutingProtocol::UnicastForwardCallback (),
+                  MakeCallback (&AodvRqueueIndexTest::Error, this));
+    NS_TEST_EXPECT_MSG_EQ (q.Enqueue (e), true, "new packet");
+    NS_TEST_EXPECT_MSG_EQ (q.Enqueue (e), false, "same packet and destination");
+    return packet;
+  }
+  /**
+   * Check the size of the queue and the number of drops
+   * \param size the expected size
+   * \param dropped the expected number of dropped packets
+   */
+  void Check (uint32_t size, uint32_t dropped)
+  {
+    NS_TEST_EXPECT_MSG_EQ (q.GetSize (), size, "size at " << Simulator::Now ().GetSeconds ());
+    NS_TEST_EXPECT_MSG_EQ (drops, dropped, "drops at " << Simulator::Now ().GetSeconds ());
+  }
+  virtual void DoRun ()
+  {
+    Ipv4Address a ("10.0.0.1");
+    Ipv4Address b ("10.0.0.2");
+    Ipv4Address c ("10.0.0.3");
+    Ptr<const Packet> a1 = Enqueue (a);
+    Ptr<const Packet> b1 = Enqueue (b);
+    Ptr<const Packet> a2 = Enqueue (a);
+    Ptr<const Packet> b2 = Enqueue (b);
+    Ptr<const Packet> a3 = Enqueue (a);
+    QueueEntry e;
+    NS_TEST_EXPECT_MSG_EQ (q.Dequeue (a, e), true, "trivial");
+    NS_TEST_EXPECT_MSG_EQ (e.GetPacket (), a1, "oldest packet of the destination first");
+    NS_TEST_EXPECT_MSG_EQ (q.Dequeue (b, e), true, "trivial");
+    NS_TEST_EXPECT_MSG_EQ (e.GetPacket (), b1, "oldest packet of the destination first");
+    NS_TEST_EXPECT_MSG_EQ (q.Dequeue (a, e), true, "trivial");
+    NS_TEST_EXPECT_MSG_EQ (e.GetPacket (), a2, "oldest packet of the destination first");
+    q.DropPacketWithDst (b);
+    NS_TEST_EXPECT_MSG_EQ (q.Find (b), false, "trivial");
+    NS_TEST_EXPECT_MSG_EQ (q.Find (a), true, "trivial");
+    Check (1, 1);
+
+    // Fill the queue, the most aged packet is dropped whatever its destination
+    for (uint32_t i = 0; i < 8; i++)
+      {
+        Enqueue (i % 2 ? b : c);
+      }
+    Check (8, 2);
+    NS_TEST_EXPECT_MSG_EQ (q.Find (a), false, "most aged packet dropped");
+
+    // Packets queued after a shorter timeout expire before the older ones
+    q.SetQueueTimeout (Seconds (2));
+    q.DropPacketWithDst (c);
+    Check (4, 6);
+    Enqueue (a);
+    Simulator::Schedule (Seconds (3), &AodvRqueueIndexTest::Check, this, 4, 7);
+    Simulator::Schedule (Seconds (11), &AodvRqueueIndexTest::Check, this, 0, 11);
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
+
+  /// Request queue
+  RequestQueue q;
+  /// Number of dropped packets
+  uint32_t drops;
+};
+
 /**
  * \ingroup aodv-test
  * \ingroup tests
@@ -641,6 +1013,355 @@ struct AodvRtableTest : public TestCase
   }
 };
 
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Unit test for AODV routing table expiry and next hop index
+ */
+struct AodvRtableExpiryTest : public TestCase
+{
+  AodvRtableExpiryTest () : TestCase ("RtableExpiry"), rtable (Seconds (1))
+  {
+  }
+  /// Routing table
+  RoutingTable rtable;
+  /**
+   * Check the state of a destination
+   * \param dst the destination
+   * \param found whether it is expected in the table
+   * \param flag the expected flag if found
+   */
+  void CheckRoute (Ipv4Address dst, bool found, RouteFlags flag)
+  {
+    RoutingTableEntry rt;
+    NS_TEST_EXPECT_MSG_EQ (rtable.LookupRoute (dst, rt), found, "route to " << dst << " at " << Simulator::Now ().GetSeconds ());
+    if (found)
+      {
+        NS_TEST_EXPECT_MSG_EQ (rt.GetFlag (), flag, "flag of " << dst << " at " << Simulator::Now ().GetSeconds ());
+      }
+  }
+  virtual void DoRun ()
+  {
+    Ptr<NetDevice> dev;
+    Ipv4InterfaceAddress iface;
+    Ipv4Address nh1 ("1.1.1.1");
+    Ipv4Address nh2 ("2.2.2.2");
+    RoutingTableEntry a (dev, Ipv4Address ("10.0.0.1"), true, 1, iface, 1, nh1, Seconds (10));
+    RoutingTableEntry b (dev, Ipv4Address ("10.0.0.2"), true, 1, iface, 1, nh1, Seconds (-1));
+    RoutingTableEntry c (dev, Ipv4Address ("10.0.0.3"), true, 1, iface, 1, nh2, Seconds (-1));
+    NS_TEST_EXPECT_MSG_EQ (rtable.AddRoute (a), true, "trivial");
+    NS_TEST_EXPECT_MSG_EQ (rtable.AddRoute (b), true, "trivial");
+    NS_TEST_EXPECT_MSG_EQ (rtable.AddRoute (c), true, "trivial");
+    NS_TEST_EXPECT_MSG_EQ (rtable.SetEntryState (c.GetDestination (), IN_SEARCH), true, "trivial");
+
+    std::map<Ipv4Address, uint32_t> unreachable;
+    rtable.GetListOfDestinationWithNextHop (nh1, unreachable);
+    NS_TEST_EXPECT_MSG_EQ (unreachable.size (), 2, "expired valid route is kept as invalid");
+    CheckRoute (b.GetDestination (), true, INVALID);
+    CheckRoute (c.GetDestination (), true, IN_SEARCH);
+    NS_TEST_EXPECT_MSG_EQ (rtable.SetEntryState (c.GetDestination (), INVALID), true, "trivial");
+    CheckRoute (c.GetDestination (), false, INVALID);
+
+    // Many updates leave stale heap items behind
+    for (uint32_t i = 0; i < 1000; i++)
+      {
+        a.SetLifeTime (Seconds (10));
+        NS_TEST_EXPECT_MSG_EQ (rtable.Update (a), true, "trivial");
+      }
+    a.SetNextHop (nh2);
+    NS_TEST_EXPECT_MSG_EQ (rtable.Update (a), true, "trivial");
+    rtable.GetListOfDestinationWithNextHop (nh1, unreachable);
+    NS_TEST_EXPECT_MSG_EQ (unreachable.size (), 1, "next hop index follows updates");
+    rtable.GetListOfDestinationWithNextHop (nh2, unreachable);
+    NS_TEST_EXPECT_MSG_EQ (unreachable.size (), 1, "next hop index follows updates");
+    NS_TEST_EXPECT_MSG_EQ (unreachable.begin ()->first, a.GetDestination (), "next hop index follows updates");
+    NS_TEST_EXPECT_MSG_EQ (rtable.DeleteRoute (b.GetDestination ()), true, "trivial");
+    rtable.GetListOfDestinationWithNextHop (nh1, unreachable);
+    NS_TEST_EXPECT_MSG_EQ (unreachable.size (), 0, "next hop index follows deletion");
+
+    Simulator::Schedule (Seconds (9.5), &AodvRtableExpiryTest::CheckRoute, this, a.GetDestination (), true, VALID);
+    Simulator::Schedule (Seconds (10.5), &AodvRtableExpiryTest::CheckRoute, this, a.GetDestination (), true, INVALID);
+    Simulator::Schedule (Seconds (12), &AodvRtableExpiryTest::CheckRoute, this, a.GetDestination (), false, INVALID);
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
+};
+
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Detection trace buffering test
+ */
+struct DetectionLogTest : public TestCase
+{
+  DetectionLogTest () : TestCase ("DetectionLog")
+  {
+  }
+  /**
+   * Count lines of a text file
+   * \param name the file name
+   * \returns the number of lines
+   */
+  uint32_t CountLines (std::string name)
+  {
+    std::ifstream is (name.c_str ());
+    std::string line;
+    uint32_t n = 0;
+    while (std::getline (is, line))
+      {
+        n++;
+      }
+    return n;
+  }
+  virtual void DoRun ()
+  {
+    std::string prefix = CreateTempDirFilename ("aodv-detection");
+    std::remove ((prefix + ".csv").c_str ());
+    {
+      DetectionLog log;
+      log.SetFormat (DetectionLog::CSV);
+      log.SetFileName (prefix);
+      log.SetBufferSize (2);
+      log.SetNodeId (7);
+      log.Record (DETECTION_RREP_RECEIVED);
+      NS_TEST_EXPECT_MSG_EQ (log.GetBufferedCount (), 1, "record is buffered");
+      NS_TEST_EXPECT_MSG_EQ (CountLines (prefix + ".csv"), 0, "nothing written yet");
+      log.Record (DETECTION_CTRL_PAYLOAD, 12);
+      NS_TEST_EXPECT_MSG_EQ (log.GetBufferedCount (), 0, "full buffer is flushed");
+      NS_TEST_EXPECT_MSG_EQ (CountLines (prefix + ".csv"), 3, "header and two records");
+      log.Record (DETECTION_MISDETECTION, 1, Ipv4Address ("10.0.0.3"), MISDETECTION_WHE_NEIGHBOR);
+      NS_TEST_EXPECT_MSG_EQ (log.GetBufferedCount (), 1, "record is buffered");
+    }
+    NS_TEST_EXPECT_MSG_EQ (CountLines (prefix + ".csv"), 4, "flushed on destruction");
+    std::ifstream is ((prefix + ".csv").c_str ());
+    std::string line;
+    std::getline (is, line);
+    NS_TEST_EXPECT_MSG_EQ (line, "time_ns,node,event,reason,value,address", "CSV header");
+    std::getline (is, line);
+    std::getline (is, line);
+    NS_TEST_EXPECT_MSG_EQ (line, "0,7,3,0,12,0.0.0.0", "payload record");
+    std::getline (is, line);
+    NS_TEST_EXPECT_MSG_EQ (line, "0,7,4,3,1,10.0.0.3", "misdetection record");
+
+    // 一方のバッファが溢れると、全ノードの記録が記録順に書かれる
+    std::string shared = CreateTempDirFilename ("aodv-detection-shared");
+    std::remove ((shared + ".csv").c_str ());
+    {
+      DetectionLog a;
+      DetectionLog b;
+      a.SetFormat (DetectionLog::CSV);
+      b.SetFormat (DetectionLog::CSV);
+      a.SetFileName (shared);
+      b.SetFileName (shared);
+      a.SetBufferSize (2);
+      a.SetNodeId (1);
+      b.SetNodeId (2);
+      a.Record (DETECTION_CTRL_PAYLOAD, 1);
+      b.Record (DETECTION_CTRL_PAYLOAD, 2);
+      a.Record (DETECTION_CTRL_PAYLOAD, 3);
+      NS_TEST_EXPECT_MSG_EQ (b.GetBufferedCount (), 0, "other node flushed too");
+      NS_TEST_EXPECT_MSG_EQ (CountLines (shared + ".csv"), 4, "header and three records");
+    }
+    std::ifstream ordered ((shared + ".csv").c_str ());
+    std::getline (ordered, line);
+    for (uint32_t k = 1; k <= 3; k++)
+      {
+        std::getline (ordered, line);
+        std::ostringstream expected;
+        expected << "0," << (k == 2 ? 2 : 1) << ",3,0," << k << ",0.0.0.0";
+        NS_TEST_EXPECT_MSG_EQ (line, expected.str (), "records in recording order");
+      }
+
+    DetectionLog off;
+    off.SetFormat (DetectionLog::NONE);
+    off.Record (DETECTION_RREP_RECEIVED);
+    NS_TEST_EXPECT_MSG_EQ (off.GetBufferedCount (), 0, "disabled log keeps nothing");
+    Simulator::Destroy ();
+  }
+};
+
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief Random streams assigned to the routing protocol
+ */
+struct AssignStreamsTest : public TestCase
+{
+  AssignStreamsTest () : TestCase ("AssignStreams")
+  {
+  }
+  /**
+   * \param rp the routing protocol
+   * \param name the attribute name
+   * \returns the random variable held by the attribute
+   */
+  Ptr<UniformRandomVariable> GetVariable (Ptr<RoutingProtocol> rp, std::string name)
+  {
+    PointerValue ptr;
+    rp->GetAttribute (name, ptr);
+    return ptr.Get<UniformRandomVariable> ();
+  }
+  virtual void DoRun ()
+  {
+    Ptr<RoutingProtocol> a = CreateObject<RoutingProtocol> ();
+    Ptr<RoutingProtocol> b = CreateObject<RoutingProtocol> ();
+    NS_TEST_EXPECT_MSG_EQ (a->AssignStreams (10), 2, "jitter and wormhole decision streams");
+    NS_TEST_EXPECT_MSG_EQ (b->AssignStreams (10), 2, "jitter and wormhole decision streams");
+    NS_TEST_EXPECT_MSG_EQ (GetVariable (a, "UniformRv")->GetStream (), 10, "jitter stream");
+    NS_TEST_EXPECT_MSG_EQ (GetVariable (a, "WhDecisionRv")->GetStream (), 11, "decision stream");
+
+    Ptr<UniformRandomVariable> da = GetVariable (a, "WhDecisionRv");
+    Ptr<UniformRandomVariable> db = GetVariable (b, "WhDecisionRv");
+    for (uint32_t i = 0; i < 32; i++)
+      {
+        NS_TEST_EXPECT_MSG_EQ (da->GetInteger (0, 1), db->GetInteger (0, 1), "same stream, same decisions");
+      }
+    a->Dispose ();
+    b->Dispose ();
+  }
+};
+
+/**
+ * \ingroup aodv-test
+ * \ingroup tests
+ *
+ * \brief WHC/WHE verification of a RREP without a common neighbor
+ *
+ * Node 0 runs AODV.  Node 1 sends it RREPs from RREQ originator node 2,
+ * and node 2 answers the WHC with a WHE naming a neighbor of node 1.
+ */
+struct WhVerificationTest : public TestCase
+{
+  WhVerificationTest () : TestCase ("WHC and WHE verification"),
+                          m_whc (0),
+                          m_rrep (0)
+  {
+  }
+  /**
+   * Send an AODV control message to node 0
+   * \param socket the sending socket
+   * \param packet the message, without its type header
+   * \param type the message type
+   */
+  void Send (Ptr<Socket> socket, Ptr<Packet> packet, MessageType type)
+  {
+    TypeHeader tHeader (type);
+    packet->AddHeader (tHeader);
+    socket->SendTo (packet, 0, InetSocketAddress (m_addr[0], RoutingProtocol::AODV_PORT));
+  }
+  /**
+   * Send a RREP from node 1 to node 0
+   * \param dstSeqNo the destination sequence number
+   */
+  void SendRrep (uint32_t dstSeqNo)
+  {
+    std::vector<Ipv4Address> neighbors (1, Ipv4Address ("10.1.1.50"));
+    RrepHeader h (0, 1, Ipv4Address ("10.1.1.200"), dstSeqNo, m_addr[2], Seconds (10), neighbors, 1, 7);
+    h.SetNextnode (m_addr[0]);
+    Ptr<Packet> p = Create<Packet> ();
+    p->AddHeader (h);
+    Send (m_sockets[1], p, AODVTYPE_RREP);
+  }
+  /// Send a WHE from node 2 to node 0
+  void SendWhe ()
+  {
+    std::vector<Ipv4Address> neighbors (1, Ipv4Address ("10.1.1.50"));
+    WHEHeader h (7, m_addr[2], neighbors, 1);
+    h.Settarget (m_addr[0]);
+    Ptr<Packet> p = Create<Packet> ();
+    p->AddHeader (h);
+    Send (m_sockets[2], p, AODVTYPE_WHE);
+  }
+  /// Send a RREP-ACK from node 2 to node 0, so that node 0 has a route to node 2
+  void SendAck ()
+  {
+    RrepAckHeader h;
+    Ptr<Packet> p = Create<Packet> ();
+    p->AddHeader (h);
+    Send (m_sockets[2], p, AODVTYPE_RREP_ACK);
+  }
+  /**
+   * Count the WHCs and the RREPs node 2 receives from node 0
+   * \param socket the receiving socket
+   */
+  void Receive (Ptr<Socket> socket)
+  {
+    Ptr<Packet> p = socket->Recv ();
+    if (socket != m_sockets[2])
+      {
+        return;
+      }
+    TypeHeader tHeader;
+    p->RemoveHeader (tHeader);
+    if (tHeader.Get () == AODVTYPE_WHC)
+      {
+        m_whc++;
+      }
+    else if (tHeader.Get () == AODVTYPE_RREP)
+      {
+        RrepHeader h;
+        p->RemoveHeader (h);
+        if (h.GetDst () != h.GetOrigin ())
+          {
+            m_rrep++;
+            m_rrepHeader = h;
+          }
+      }
+  }
+  virtual void DoRun ()
+  {
+    NodeContainer nodes;
+    nodes.Create (3);
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer devices = simple.Install (nodes);
+    InternetStackHelper stack;
+    AodvHelper aodv;
+    stack.SetRoutingHelper (aodv);
+    stack.Install (nodes.Get (0));
+    InternetStackHelper plain;
+    plain.Install (NodeContainer (nodes.Get (1), nodes.Get (2)));
+    Ipv4AddressHelper address;
+    address.SetBase ("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign (devices);
+    for (uint32_t i = 0; i < 3; i++)
+      {
+        m_addr[i] = interfaces.GetAddress (i);
+      }
+    for (uint32_t i = 1; i < 3; i++)
+      {
+        m_sockets[i] = Socket::CreateSocket (nodes.Get (i), UdpSocketFactory::GetTypeId ());
+        m_sockets[i]->Bind (InetSocketAddress (Ipv4Address::GetAny (), RoutingProtocol::AODV_PORT));
+        m_sockets[i]->SetRecvCallback (MakeCallback (&WhVerificationTest::Receive, this));
+      }
+
+    Simulator::Schedule (Seconds (1.0), &WhVerificationTest::SendAck, this);
+    Simulator::Schedule (Seconds (1.1), &WhVerificationTest::SendRrep, this, 1);
+    // 検証中に同じ送信者から届いた同じ RREP は、新しい内容で検証中のエントリを更新する
+    Simulator::Schedule (Seconds (1.2), &WhVerificationTest::SendRrep, this, 2);
+    Simulator::Schedule (Seconds (1.3), &WhVerificationTest::SendWhe, this);
+    // 解決済みの RREP に対する WHE は何もしない
+    Simulator::Schedule (Seconds (1.4), &WhVerificationTest::SendWhe, this);
+    Simulator::Stop (Seconds (2));
+    Simulator::Run ();
+    Simulator::Destroy ();
+
+    NS_TEST_EXPECT_MSG_EQ (m_whc, 1, "one WHC for the RREP and its copy");
+    NS_TEST_EXPECT_MSG_EQ (m_rrep, 1, "the WHE releases the RREP once");
+    NS_TEST_EXPECT_MSG_EQ (m_rrepHeader.Getid (), 7, "RREP id");
+    NS_TEST_EXPECT_MSG_EQ (m_rrepHeader.GetDstSeqno (), 2, "the copy replaced the pending RREP");
+    NS_TEST_EXPECT_MSG_EQ (m_rrepHeader.GetNextnode (), m_addr[2], "next node towards the origin");
+  }
+
+  Ipv4Address m_addr[3];       ///< node addresses
+  Ptr<Socket> m_sockets[3];    ///< sockets of nodes 1 and 2
+  uint32_t m_whc;              ///< WHCs received by node 2
+  uint32_t m_rrep;             ///< RREPs received by node 2
+  RrepHeader m_rrepHeader;     ///< last RREP received by node 2
+};
+
 /**
  * \ingroup aodv-test
  * \ingroup tests
@@ -653,15 +1374,24 @@ public:
   AodvTestSuite () : TestSuite ("routing-aodv", UNIT)
   {
     AddTestCase (new NeighborTest, TestCase::QUICK);
+    AddTestCase (new HelloNeighborListTest, TestCase::QUICK);
+    AddTestCase (new NeighborSetTest, TestCase::QUICK);
     AddTestCase (new TypeHeaderTest, TestCase::QUICK);
     AddTestCase (new RreqHeaderTest, TestCase::QUICK);
     AddTestCase (new RrepHeaderTest, TestCase::QUICK);
+    AddTestCase (new NeighborListEncodingTest, TestCase::QUICK);
+    AddTestCase (new NeighborListRefTest, TestCase::QUICK);
     AddTestCase (new RrepAckHeaderTest, TestCase::QUICK);
     AddTestCase (new RerrHeaderTest, TestCase::QUICK);
     AddTestCase (new QueueEntryTest, TestCase::QUICK);
     AddTestCase (new AodvRqueueTest, TestCase::QUICK);
+    AddTestCase (new AodvRqueueIndexTest, TestCase::QUICK);
     AddTestCase (new AodvRtableEntryTest, TestCase::QUICK);
     AddTestCase (new AodvRtableTest, TestCase::QUICK);
+    AddTestCase (new AodvRtableExpiryTest, TestCase::QUICK);
+    AddTestCase (new DetectionLogTest, TestCase::QUICK);
+    AddTestCase (new AssignStreamsTest, TestCase::QUICK);
+    AddTestCase (new WhVerificationTest, TestCase::QUICK);
   }
 } g_aodvTestSuite; ///< the test suite
 
@@ -53,7 +53,7 @@ Bug772ChainTest::Bug772ChainTest (const char * const prefix, const char * const
     m_proto (proto),
     m_time (t),
     m_size (size),
-    m_step (120),
+    m_step (60),
     m_port (9),
     m_receivedPackets (0)
 {
@@ -156,8 +156,8 @@ Bug772ChainTest::CreateDevices ()
   // Expect to use (3*m_size) more streams for internet stack random variables
   NS_TEST_ASSERT_MSG_EQ (streamsUsed, ((devices.GetN () * 6) + (3 * m_size)), "Stream assignment mismatch");
   streamsUsed += aodv.AssignStreams (*m_nodes, streamsUsed);
-  // Expect to use m_size more streams for AODV
-  NS_TEST_ASSERT_MSG_EQ (streamsUsed, ((devices.GetN () * 6) + (3 * m_size) + m_size), "Stream assignment mismatch");
+  // Expect to use 2 * m_size more streams for AODV
+  NS_TEST_ASSERT_MSG_EQ (streamsUsed, ((devices.GetN () * 6) + (3 * m_size) + (2 * m_size)), "Stream assignment mismatch");
   Ipv4AddressHelper address;
   address.SetBase ("10.1.1.0", "255.255.255.0");
   Ipv4InterfaceContainer interfaces = address.Assign (devices);
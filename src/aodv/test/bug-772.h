@@ -63,7 +63,8 @@ private:
   const Time m_time;
   /// Chain size
   const uint32_t m_size;
-  /// Chain step, meters
+  /// Chain step, meters; short enough for every node to hear two hops, as
+  /// an RREP is only accepted once a common neighbor of its sender answers
   const double m_step;
   /// port number
   const uint16_t m_port;
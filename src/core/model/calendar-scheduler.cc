@@ -125,6 +125,27 @@ CalendarScheduler::Insert (const Event &ev)
   m_qSize++;
   ResizeUp ();
 }
+void
+CalendarScheduler::InsertBatch (const std::vector<Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  for (std::vector<Event>::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      DoInsert (*i);
+    }
+  m_qSize += events.size ();
+  // Grow straight to the final size instead of doubling once per
+  // insertion.
+  uint32_t nBuckets = m_nBuckets;
+  while (m_qSize > nBuckets * 2 && nBuckets < 32768)
+    {
+      nBuckets *= 2;
+    }
+  if (nBuckets != m_nBuckets)
+    {
+      Resize (nBuckets);
+    }
+}
 bool
 CalendarScheduler::IsEmpty (void) const
 {
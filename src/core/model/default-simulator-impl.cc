@@ -175,6 +175,7 @@ DefaultSimulatorImpl::ProcessEventsWithContext (void)
     m_eventsWithContext.swap(eventsWithContext);
     m_eventsWithContextEmpty = true;
   }
+  m_batch.clear ();
   while (!eventsWithContext.empty ())
     {
        EventWithContext event = eventsWithContext.front ();
@@ -186,8 +187,9 @@ DefaultSimulatorImpl::ProcessEventsWithContext (void)
        ev.key.m_uid = m_uid;
        m_uid++;
        m_unscheduledEvents++;
-       m_events->Insert (ev);
+       m_batch.push_back (ev);
     }
+  m_events->InsertBatch (m_batch);
 }
 
 void
@@ -278,6 +280,44 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
     }
 }
 
+void
+DefaultSimulatorImpl::ScheduleWithContextBatch (const Simulator::ContextEventBatch &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+
+  if (SystemThread::Equals (m_main))
+    {
+      m_batch.clear ();
+      for (Simulator::ContextEventBatch::const_iterator i = events.begin (); i != events.end (); ++i)
+        {
+          Time tAbsolute = i->delay + TimeStep (m_currentTs);
+          Scheduler::Event ev;
+          ev.impl = i->event;
+          ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+          ev.key.m_context = i->context;
+          ev.key.m_uid = m_uid;
+          m_uid++;
+          m_batch.push_back (ev);
+        }
+      m_unscheduledEvents += events.size ();
+      m_events->InsertBatch (m_batch);
+    }
+  else
+    {
+      CriticalSection cs (m_eventsWithContextMutex);
+      for (Simulator::ContextEventBatch::const_iterator i = events.begin (); i != events.end (); ++i)
+        {
+          EventWithContext ev;
+          ev.context = i->context;
+          // Current time added in ProcessEventsWithContext()
+          ev.timestamp = i->delay.GetTimeStep ();
+          ev.event = i->event;
+          m_eventsWithContext.push_back (ev);
+        }
+      m_eventsWithContextEmpty = m_eventsWithContext.empty ();
+    }
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
 {
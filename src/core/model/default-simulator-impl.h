@@ -30,6 +30,7 @@
 #include "ptr.h"
 
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -65,6 +66,7 @@ public:
   virtual void Stop (const Time &delay);
   virtual EventId Schedule (const Time &delay, EventImpl *event);
   virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContextBatch (const Simulator::ContextEventBatch &events);
   virtual EventId ScheduleNow (EventImpl *event);
   virtual EventId ScheduleDestroy (EventImpl *event);
   virtual void Remove (const EventId &id);
@@ -107,6 +109,11 @@ private:
   bool m_eventsWithContextEmpty;
   /** Mutex to control access to the list of events with context. */
   SystemMutex m_eventsWithContextMutex;
+  /**
+   * Events being handed to the scheduler in one batch, kept to reuse
+   * its storage.  Only used from the main thread.
+   */
+  std::vector<Scheduler::Event> m_batch;
 
   /** Container type for the events to run at Simulator::Destroy() */
   typedef std::list<EventId> DestroyEvents;
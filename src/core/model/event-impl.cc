@@ -20,6 +20,8 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include <mutex>
+#include <new>
 
 /**
  * \file
@@ -31,6 +33,184 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/**
+ * \ingroup events
+ * Per-thread pool of event storage.
+ *
+ * Storage is carved from slabs in size classes of POOL_GRANULE bytes,
+ * and freed blocks are kept on one intrusive free list per class.  The
+ * pool is plain data so that it needs neither construction nor
+ * destruction: events released during static destruction still find a
+ * valid pool.
+ *
+ * Slabs are deliberately never returned to the global allocator: an
+ * event may be freed by another thread than the one which allocated
+ * it, so the blocks of one slab end up scattered over several pools.
+ * Instead, the free lists of an exiting thread are handed over to
+ * the orphan lists, which the next thread short of storage adopts
+ * before it carves a new slab.
+ */
+struct EventPool
+{
+  /** Size class granularity, in bytes. */
+  static const std::size_t POOL_GRANULE = 16;
+  /** Number of size classes: events up to 256 bytes are pooled. */
+  static const std::size_t POOL_CLASSES = 16;
+  /** Number of blocks per slab. */
+  static const std::size_t SLAB_BLOCKS = 64;
+
+  /** Free block, linked through its first word. */
+  struct Block
+  {
+    Block *next;  /**< Next free block. */
+  };
+
+  Block *free[POOL_CLASSES];        /**< Free lists, by size class. */
+  ns3::EventImpl::PoolStats stats;  /**< Counters. */
+  bool reaped;                      /**< Reaper set up for this thread. */
+};
+
+/** The pool of the current thread. */
+thread_local EventPool g_eventPool;
+
+/** Guards g_orphans. */
+std::mutex g_orphansMutex;
+/** Free lists left over by the threads which have exited, by size class. */
+EventPool::Block *g_orphans[EventPool::POOL_CLASSES];
+
+/**
+ * \ingroup events
+ * Hands the free lists of an exiting thread over to g_orphans.
+ */
+struct EventPoolReaper
+{
+  /** Set up the reaper of the current thread. */
+  EventPoolReaper ()
+  {
+    g_eventPool.reaped = true;
+  }
+  /** Move the free lists of the current thread to g_orphans. */
+  ~EventPoolReaper ()
+  {
+    std::lock_guard<std::mutex> lock (g_orphansMutex);
+    for (std::size_t i = 0; i < EventPool::POOL_CLASSES; i++)
+      {
+        EventPool::Block *head = g_eventPool.free[i];
+        if (head == 0)
+          {
+            continue;
+          }
+        EventPool::Block *tail = head;
+        while (tail->next != 0)
+          {
+            tail = tail->next;
+          }
+        tail->next = g_orphans[i];
+        g_orphans[i] = head;
+        g_eventPool.free[i] = 0;
+      }
+  }
+};
+
+/** The reaper of the current thread, constructed on first use. */
+thread_local EventPoolReaper g_eventPoolReaper;
+
+/**
+ * Make sure the free lists of the current thread are not lost when it
+ * exits.  The reaper is touched only once per thread, so that the
+ * fast paths do not pay for the thread_local initialization check.
+ *
+ * \param [in] pool The pool of the current thread.
+ */
+inline void
+EnsureReaper (EventPool &pool)
+{
+  if (!pool.reaped)
+    {
+      (void) &g_eventPoolReaper;
+    }
+}
+
+/**
+ * Take over the orphan free list of a size class.
+ *
+ * \param [in] sizeClass The size class index.
+ * \returns The first block of the list, or 0 if there is none.
+ */
+EventPool::Block *
+AdoptOrphans (std::size_t sizeClass)
+{
+  std::lock_guard<std::mutex> lock (g_orphansMutex);
+  EventPool::Block *head = g_orphans[sizeClass];
+  g_orphans[sizeClass] = 0;
+  return head;
+}
+
+} // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  EventPool &pool = g_eventPool;
+  EnsureReaper (pool);
+  pool.stats.allocations++;
+  std::size_t sizeClass = (size + EventPool::POOL_GRANULE - 1) / EventPool::POOL_GRANULE;
+  if (sizeClass == 0 || sizeClass > EventPool::POOL_CLASSES)
+    {
+      pool.stats.oversized++;
+      return ::operator new (size);
+    }
+  EventPool::Block *block = pool.free[sizeClass - 1];
+  if (block == 0)
+    {
+      block = AdoptOrphans (sizeClass - 1);
+      pool.free[sizeClass - 1] = block;
+    }
+  if (block == 0)
+    {
+      std::size_t blockSize = sizeClass * EventPool::POOL_GRANULE;
+      char *slab = static_cast<char *> (::operator new (blockSize * EventPool::SLAB_BLOCKS));
+      pool.stats.slabs++;
+      for (std::size_t i = 0; i < EventPool::SLAB_BLOCKS; i++)
+        {
+          block = reinterpret_cast<EventPool::Block *> (slab + i * blockSize);
+          block->next = pool.free[sizeClass - 1];
+          pool.free[sizeClass - 1] = block;
+        }
+    }
+  pool.free[sizeClass - 1] = block->next;
+  return block;
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  EventPool &pool = g_eventPool;
+  EnsureReaper (pool);
+  pool.stats.deallocations++;
+  std::size_t sizeClass = (size + EventPool::POOL_GRANULE - 1) / EventPool::POOL_GRANULE;
+  if (sizeClass == 0 || sizeClass > EventPool::POOL_CLASSES)
+    {
+      ::operator delete (p);
+      return;
+    }
+  EventPool::Block *block = static_cast<EventPool::Block *> (p);
+  block->next = pool.free[sizeClass - 1];
+  pool.free[sizeClass - 1] = block;
+}
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats (void)
+{
+  return g_eventPool.stats;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -66,6 +67,43 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate an event from the event pool of the calling thread.
+   *
+   * Every subclass, including the ones built by MakeEvent(), inherits
+   * this operator, so events and the arguments bound in them are
+   * recycled without going through the global allocator once the pool
+   * has warmed up.  Events larger than the largest size class are
+   * allocated with the global operator new.
+   *
+   * \param [in] size The size of the event object.
+   * \returns The storage for the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Return an event to the event pool of the calling thread.
+   *
+   * An event may be freed by another thread than the one which
+   * allocated it: it then joins the pool of the freeing thread.
+   *
+   * \param [in] p The storage of the event.
+   * \param [in] size The size of the event object.
+   */
+  static void operator delete (void *p, std::size_t size);
+
+  /** Event pool counters. */
+  struct PoolStats
+  {
+    uint64_t allocations;  /**< Events allocated. */
+    uint64_t deallocations; /**< Events freed. */
+    uint64_t slabs;        /**< Pool slabs taken from the global allocator. */
+    uint64_t oversized;    /**< Events too large for the pool. */
+  };
+  /**
+   * \returns The event pool counters of the calling thread.
+   */
+  static PoolStats GetPoolStats (void);
+
 protected:
   /**
    * Implementation for Invoke().
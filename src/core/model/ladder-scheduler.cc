@@ -0,0 +1,336 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include "unused.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (0),
+    m_topMax (0),
+    m_topStart (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0),
+    m_qSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::Bucket *
+LadderScheduler::FindBucket (uint64_t ts)
+{
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      else
+        {
+          m_topMin = std::min (m_topMin, ts);
+          m_topMax = std::max (m_topMax, ts);
+        }
+      return &m_top;
+    }
+  for (uint32_t r = 0; r < m_nRungs; r++)
+    {
+      Rung &rung = m_rungs[r];
+      if (ts >= CurrentStart (rung))
+        {
+          uint64_t bucket = (ts - rung.start) / rung.width;
+          NS_ASSERT (bucket < rung.nBuckets);
+          return &rung.buckets[bucket];
+        }
+    }
+  return 0;
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  m_qSize++;
+  Bucket *bucket = FindBucket (ev.key.m_ts);
+  if (bucket != 0)
+    {
+      bucket->push_back (ev);
+      return;
+    }
+  InsertBottom (ev);
+}
+
+void
+LadderScheduler::InsertBatch (const std::vector<Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  m_qSize += events.size ();
+  std::vector<Event>::const_iterator i = events.begin ();
+  while (i != events.end ())
+    {
+      // Events sharing a timestamp all go to the same tier.
+      std::vector<Event>::const_iterator end = i + 1;
+      while (end != events.end () && end->key.m_ts == i->key.m_ts)
+        {
+          ++end;
+        }
+      Bucket *bucket = FindBucket (i->key.m_ts);
+      if (bucket != 0)
+        {
+          bucket->insert (bucket->end (), i, end);
+        }
+      else
+        {
+          // A sorted run with no Bottom event between its ends is
+          // inserted in one go.
+          std::deque<Scheduler::Event>::iterator pos =
+            std::upper_bound (m_bottom.begin (), m_bottom.end (), *i);
+          if (std::is_sorted (i, end) && (pos == m_bottom.end () || !(*pos < *(end - 1))))
+            {
+              m_bottom.insert (pos, i, end);
+            }
+          else
+            {
+              for (std::vector<Event>::const_iterator j = i; j != end; ++j)
+                {
+                  InsertBottom (*j);
+                }
+            }
+        }
+      i = end;
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottom.empty ())
+    {
+      // Refilling does not change the content of the queue, only where
+      // the events are kept.
+      const_cast<LadderScheduler *> (this)->RefillBottom ();
+    }
+  return m_bottom.front ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottom.empty ())
+    {
+      RefillBottom ();
+    }
+  Scheduler::Event ev = m_bottom.front ();
+  m_bottom.pop_front ();
+  m_qSize--;
+  NS_LOG_LOGIC ("remove ts=" << ev.key.m_ts << ", key=" << ev.key.m_uid);
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  m_qSize--;
+  // An event is always found in the tier Insert would put it in now.
+  if (ts >= m_topStart)
+    {
+      bool found = RemoveFromBucket (m_top, ev);
+      NS_ASSERT (found);
+      NS_UNUSED (found);
+      return;
+    }
+  for (uint32_t r = 0; r < m_nRungs; r++)
+    {
+      Rung &rung = m_rungs[r];
+      if (ts >= CurrentStart (rung))
+        {
+          bool found = RemoveFromBucket (rung.buckets[(ts - rung.start) / rung.width], ev);
+          NS_ASSERT (found);
+          NS_UNUSED (found);
+          return;
+        }
+    }
+  std::deque<Scheduler::Event>::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev);
+  NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+  NS_ASSERT (ev.impl == i->impl);
+  m_bottom.erase (i);
+}
+
+void
+LadderScheduler::RefillBottom (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_bottom.empty ());
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          NS_ASSERT (!m_top.empty ());
+          if (m_top.size () <= THRESHOLD || m_topMin == m_topMax)
+            {
+              m_topStart = m_topMax + 1;
+              MoveToBottom (m_top);
+            }
+          else
+            {
+              SpawnRung (m_top, m_topMin, m_topMax, m_top.size ());
+              const Rung &rung = m_rungs[0];
+              m_topStart = rung.start + rung.nBuckets * rung.width;
+            }
+          continue;
+        }
+
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.current < rung.nBuckets && rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      if (rung.current == rung.nBuckets)
+        {
+          m_nRungs--;
+          continue;
+        }
+      Bucket &bucket = rung.buckets[rung.current];
+      uint64_t last = CurrentStart (rung) + rung.width - 1;
+      rung.current++;
+
+      uint64_t min = bucket.front ().key.m_ts;
+      uint64_t max = min;
+      for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); ++i)
+        {
+          min = std::min (min, i->key.m_ts);
+          max = std::max (max, i->key.m_ts);
+        }
+      if (bucket.size () <= THRESHOLD || min == max || m_nRungs == MAX_RUNGS)
+        {
+          MoveToBottom (bucket);
+        }
+      else
+        {
+          // The new rung must cover the rest of the bucket, so that later
+          // events in its range still find a place.
+          SpawnRung (bucket, min, last, bucket.size ());
+        }
+    }
+}
+
+void
+LadderScheduler::SpawnRung (Bucket &events, uint64_t min, uint64_t max, uint32_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << events.size () << min << max << nBuckets);
+  NS_ASSERT (m_nRungs < MAX_RUNGS);
+  Rung &rung = m_rungs[m_nRungs++];
+  uint64_t span = max - min + 1;
+  rung.width = (span + nBuckets - 1) / nBuckets;
+  rung.nBuckets = (span + rung.width - 1) / rung.width;
+  rung.start = min;
+  rung.current = 0;
+  if (rung.buckets.size () < rung.nBuckets)
+    {
+      rung.buckets.resize (rung.nBuckets);
+    }
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      rung.buckets[(i->key.m_ts - min) / rung.width].push_back (*i);
+    }
+  events.clear ();
+  NS_LOG_LOGIC ("rung " << m_nRungs - 1 << ": start=" << rung.start << ", width=" << rung.width
+                        << ", nBuckets=" << rung.nBuckets);
+}
+
+void
+LadderScheduler::MoveToBottom (Bucket &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  std::sort (events.begin (), events.end ());
+  m_bottom.assign (events.begin (), events.end ());
+  events.clear ();
+}
+
+void
+LadderScheduler::InsertBottom (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl);
+  if (m_bottom.empty () || !(ev < m_bottom.back ()))
+    {
+      m_bottom.push_back (ev);
+      return;
+    }
+  m_bottom.insert (std::upper_bound (m_bottom.begin (), m_bottom.end (), ev), ev);
+}
+
+bool
+LadderScheduler::RemoveFromBucket (Bucket &bucket, const Event &ev)
+{
+  for (Bucket::iterator i = bucket.begin (); i != bucket.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (ev.impl == i->impl);
+          *i = bucket.back ();
+          bucket.pop_back ();
+          return true;
+        }
+    }
+  return false;
+}
+
+} // namespace ns3
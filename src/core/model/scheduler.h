@@ -22,6 +22,7 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include <vector>
 #include "object.h"
 
 /**
@@ -104,6 +105,16 @@ public:
    * \param [in] ev Event to store in the event list
    */
   virtual void Insert (const Event &ev) = 0;
+  /**
+   * Insert a batch of new Events in the schedule.
+   *
+   * The default implementation inserts the events one at a time.
+   * Schedulers which reorganize themselves as they grow override it
+   * to do so once per batch.
+   *
+   * \param [in] events Events to store in the event list
+   */
+  virtual void InsertBatch (const std::vector<Event> &events);
   /**
    * Test if the schedule is empty.
    *
@@ -42,4 +42,14 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+void
+SimulatorImpl::ScheduleWithContextBatch (const Simulator::ContextEventBatch &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  for (Simulator::ContextEventBatch::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      ScheduleWithContext (i->context, i->delay, i->event);
+    }
+}
+
 } // namespace ns3
@@ -30,6 +30,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 /**
  * @file
@@ -1303,6 +1304,49 @@ public:
    */
   static void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
 
+  /** An event to schedule in a given context, see ScheduleWithContextBatch(). */
+  struct ContextEvent
+  {
+    /** Default constructor. */
+    ContextEvent ()
+      : context (0),
+        event (0)
+    {
+    }
+    /**
+     * Constructor.
+     *
+     * @param [in] context_ Event context.
+     * @param [in] delay_ Delay until the event expires.
+     * @param [in] event_ The event to schedule.
+     */
+    ContextEvent (uint32_t context_, const Time &delay_, EventImpl *event_)
+      : context (context_),
+        delay (delay_),
+        event (event_)
+    {
+    }
+    uint32_t context;  /**< Event context. */
+    Time delay;        /**< Delay until the event expires. */
+    EventImpl *event;  /**< The event to schedule. */
+  };
+  /** A batch of events to schedule in their own context. */
+  typedef std::vector<ContextEvent> ContextEventBatch;
+
+  /**
+   * Schedule a batch of future event executions, each in its own context.
+   * This method is thread-safe: it can be called from any thread.
+   *
+   * The outcome is the same as calling ScheduleWithContext() for each
+   * event in turn, but the simulator resolves the current time and
+   * takes its locks once, and hands the events to the scheduler in a
+   * single Scheduler::InsertBatch() call.  This suits channels which
+   * deliver one transmission to many receivers.
+   *
+   * @param [in] events The events to schedule.
+   */
+  static void ScheduleWithContextBatch (const ContextEventBatch &events);
+
   /**
    * Schedule an event to run at the end of the simulation, after
    * the Stop() time or condition has been reached.
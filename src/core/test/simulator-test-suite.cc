@@ -23,6 +23,9 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include <set>
+#include <vector>
 
 using namespace ns3;
 
@@ -170,6 +173,217 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  /**
+   * \param schedulerFactory the scheduler to test
+   * \param batch whether the bursts go through InsertBatch
+   */
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory, bool batch = false);
+  virtual void DoRun (void);
+  /**
+   * \returns the next pseudo random number
+   */
+  uint32_t Next (void);
+  ObjectFactory m_schedulerFactory;
+  bool m_batch;
+  uint32_t m_state;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory, bool batch)
+  : TestCase ("Check the event order against a sorted set with " +
+              schedulerFactory.GetTypeId ().GetName () +
+              (batch ? " and batch insertion" : "")),
+    m_schedulerFactory (schedulerFactory),
+    m_batch (batch),
+    m_state (1)
+{
+}
+uint32_t
+SchedulerOrderTestCase::Next (void)
+{
+  m_state = m_state * 1103515245 + 12345;
+  return m_state >> 8;
+}
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  std::set<Scheduler::Event> oracle;
+  uint64_t now = 0;
+  uint32_t uid = 0;
+  bool ok = true;
+  for (uint32_t step = 0; step < 4000 && ok; step++)
+    {
+      uint32_t action = Next () % 8;
+      if (action < 4 || oracle.empty ())
+        {
+          // Mostly spread events, sometimes a burst sharing one timestamp,
+          // as a broadcast delivered to many receivers.
+          uint32_t n = (Next () % 16 == 0) ? 64 : 1;
+          uint64_t ts = now + (Next () % 4 == 0 ? 0 : Next () % 100000);
+          std::vector<Scheduler::Event> batch;
+          for (uint32_t i = 0; i < n; i++)
+            {
+              Scheduler::Event ev;
+              ev.impl = reinterpret_cast<EventImpl *> (uid + 1);
+              // A batch holds runs of a few timestamps.
+              ev.key.m_ts = ts + (m_batch ? i / 16 : 0);
+              ev.key.m_uid = uid++;
+              ev.key.m_context = 0;
+              if (m_batch)
+                {
+                  batch.push_back (ev);
+                }
+              else
+                {
+                  scheduler->Insert (ev);
+                }
+              oracle.insert (ev);
+            }
+          if (m_batch)
+            {
+              scheduler->InsertBatch (batch);
+            }
+        }
+      else if (action < 7)
+        {
+          Scheduler::Event next = scheduler->PeekNext ();
+          NS_TEST_EXPECT_MSG_EQ (next.key.m_uid, oracle.begin ()->key.m_uid, "peek");
+          Scheduler::Event ev = scheduler->RemoveNext ();
+          ok = (ev.key.m_uid == oracle.begin ()->key.m_uid && ev.impl == oracle.begin ()->impl);
+          NS_TEST_EXPECT_MSG_EQ (ok, true, "remove next at step " << step);
+          now = ev.key.m_ts;
+          oracle.erase (oracle.begin ());
+        }
+      else
+        {
+          std::set<Scheduler::Event>::iterator i = oracle.begin ();
+          std::advance (i, Next () % oracle.size ());
+          scheduler->Remove (*i);
+          oracle.erase (i);
+        }
+    }
+  while (ok && !oracle.empty ())
+    {
+      Scheduler::Event ev = scheduler->RemoveNext ();
+      ok = (ev.key.m_uid == oracle.begin ()->key.m_uid);
+      NS_TEST_EXPECT_MSG_EQ (ok, true, "drain");
+      oracle.erase (oracle.begin ());
+    }
+  NS_TEST_EXPECT_MSG_EQ (scheduler->IsEmpty (), true, "all events removed");
+}
+
+class ScheduleWithContextBatchTestCase : public TestCase
+{
+public:
+  ScheduleWithContextBatchTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  /**
+   * Event callback, checking the order and context of the events
+   * \param index the position of the event in the batch
+   */
+  void Rx (uint32_t index);
+  ObjectFactory m_schedulerFactory; ///< scheduler factory
+  std::vector<uint32_t> m_order;    ///< batch positions, in execution order
+  bool m_contextOk;                 ///< true if every event ran in its context
+};
+
+ScheduleWithContextBatchTestCase::ScheduleWithContextBatchTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check ScheduleWithContextBatch with " + schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory),
+    m_contextOk (true)
+{
+}
+void
+ScheduleWithContextBatchTestCase::Rx (uint32_t index)
+{
+  m_order.push_back (index);
+  m_contextOk = m_contextOk && (Simulator::GetContext () == index % 7);
+}
+void
+ScheduleWithContextBatchTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  // Enough events to grow the calendar several times in one batch,
+  // half of them sharing a timestamp as a broadcast would.
+  const uint32_t n = 600;
+  Simulator::ContextEventBatch batch;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Time delay = (i % 2 == 0) ? MicroSeconds (5) : MicroSeconds (n - i);
+      batch.push_back (Simulator::ContextEvent (i % 7, delay,
+                                                MakeEvent (&ScheduleWithContextBatchTestCase::Rx, this, i)));
+    }
+  Simulator::ScheduleWithContextBatch (batch);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_order.size (), n, "every event should have run");
+  NS_TEST_EXPECT_MSG_EQ (m_contextOk, true, "events should run in their context");
+  bool ordered = true;
+  for (uint32_t i = 1; i < n; i++)
+    {
+      uint32_t a = m_order[i - 1];
+      uint32_t b = m_order[i];
+      uint64_t ta = (a % 2 == 0) ? 5 : n - a;
+      uint64_t tb = (b % 2 == 0) ? 5 : n - b;
+      ordered = ordered && (ta < tb || (ta == tb && a < b));
+    }
+  NS_TEST_EXPECT_MSG_EQ (ordered, true, "events should run by time, then in batch order");
+}
+
+class EventPoolTestCase : public TestCase
+{
+public:
+  EventPoolTestCase ();
+  virtual void DoRun (void);
+  /**
+   * Event callback, rescheduling itself until the count runs out
+   * \param remaining the number of events still to run
+   * \param delay the delay of the next events
+   */
+  void Next (uint32_t remaining, Time delay);
+  uint32_t m_run; ///< number of events run
+};
+
+EventPoolTestCase::EventPoolTestCase ()
+  : TestCase ("Check that events are recycled through the event pool"),
+    m_run (0)
+{
+}
+void
+EventPoolTestCase::Next (uint32_t remaining, Time delay)
+{
+  m_run++;
+  if (remaining > 0)
+    {
+      Simulator::Schedule (delay, &EventPoolTestCase::Next, this, remaining - 1, delay);
+      Simulator::Schedule (delay, &EventPoolTestCase::Next, this, 0, delay);
+    }
+}
+void
+EventPoolTestCase::DoRun (void)
+{
+  EventImpl::PoolStats before = EventImpl::GetPoolStats ();
+  Simulator::Schedule (Seconds (1), &EventPoolTestCase::Next, this, 10000, MicroSeconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  EventImpl::PoolStats after = EventImpl::GetPoolStats ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_run, 20001, "all events should have run");
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations,
+                         after.deallocations - before.deallocations,
+                         "every event should have been freed");
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (after.allocations - before.allocations, 20001,
+                               "every event should go through the pool");
+  // Only a handful of events are alive at once, so the whole run fits
+  // in the first slab.
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (after.slabs - before.slabs, 3, "events should be recycled");
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -477,5 +691,25 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    AddTestCase (new EventPoolTestCase (), TestCase::QUICK);
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new ScheduleWithContextBatchTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new ScheduleWithContextBatchTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new ScheduleWithContextBatchTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory, true), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory, true), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -26,6 +26,7 @@
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
+#include "ns3/make-event.h"
 
 #include <chrono>  // seconds, milliseconds
 #include <ctime>
@@ -226,6 +227,59 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+class EventPoolThreadTestCase : public TestCase
+{
+public:
+  EventPoolThreadTestCase ();
+  /**
+   * Thread body: allocate a batch of events, free them and record
+   * the slabs taken by the pool of the thread.
+   * \param slabs where to store the number of slabs taken
+   */
+  static void AllocateEvents (uint64_t *slabs);
+  /** Event body, never invoked. */
+  static void Nothing (int) {}
+
+private:
+  virtual void DoRun (void);
+};
+
+EventPoolThreadTestCase::EventPoolThreadTestCase ()
+  : TestCase ("Check that the event pool of an exited thread is reused")
+{
+}
+
+void
+EventPoolThreadTestCase::AllocateEvents (uint64_t *slabs)
+{
+  EventImpl::PoolStats before = EventImpl::GetPoolStats ();
+  {
+    std::list<Ptr<EventImpl> > events;
+    for (int i = 0; i < 1000; i++)
+      {
+        events.push_back (Ptr<EventImpl> (MakeEvent (&EventPoolThreadTestCase::Nothing, i), false));
+      }
+  }
+  *slabs = EventImpl::GetPoolStats ().slabs - before.slabs;
+}
+
+void
+EventPoolThreadTestCase::DoRun (void)
+{
+  uint64_t first = 0;
+  uint64_t second = 0;
+  Ptr<SystemThread> thread;
+  thread = Create<SystemThread> (MakeBoundCallback (&EventPoolThreadTestCase::AllocateEvents, &first));
+  thread->Start ();
+  thread->Join ();
+  thread = Create<SystemThread> (MakeBoundCallback (&EventPoolThreadTestCase::AllocateEvents, &second));
+  thread->Start ();
+  thread->Join ();
+
+  NS_TEST_EXPECT_MSG_GT (first, 0, "the first thread should take slabs");
+  NS_TEST_EXPECT_MSG_EQ (second, 0, "the second thread should adopt the blocks of the first one");
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -263,5 +317,6 @@ public:
               }
           }
       }
+    AddTestCase (new EventPoolThreadTestCase (), TestCase::QUICK);
   }
 } g_threadedSimulatorTestSuite;
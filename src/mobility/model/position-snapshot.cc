@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "position-snapshot.h"
+#include "mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PositionSnapshot");
+
+PositionSnapshot::PositionSnapshot ()
+  : m_updated (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PositionSnapshot::~PositionSnapshot ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+uint32_t
+PositionSnapshot::Add (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  uint32_t i = m_mobility.size ();
+  m_mobility.push_back (mobility);
+  m_x.push_back (0);
+  m_y.push_back (0);
+  m_z.push_back (0);
+  m_isMoving.push_back (false);
+  m_inMovingList.push_back (false);
+  mobility->TraceConnectWithoutContext ("CourseChange",
+                                        MakeBoundCallback (&PositionSnapshot::NotifyCourseChange, this, i));
+  Record (i, mobility);
+  return i;
+}
+
+void
+PositionSnapshot::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_mobility.size (); i++)
+    {
+      m_mobility[i]->TraceDisconnectWithoutContext ("CourseChange",
+                                                    MakeBoundCallback (&PositionSnapshot::NotifyCourseChange, this, i));
+    }
+  m_mobility.clear ();
+  m_x.clear ();
+  m_y.clear ();
+  m_z.clear ();
+  m_isMoving.clear ();
+  m_inMovingList.clear ();
+  m_moving.clear ();
+  m_updated = false;
+}
+
+uint32_t
+PositionSnapshot::GetN (void) const
+{
+  return m_mobility.size ();
+}
+
+void
+PositionSnapshot::Update (void)
+{
+  Time now = Simulator::Now ();
+  if (m_updated && now == m_time)
+    {
+      return;
+    }
+  m_updated = true;
+  m_time = now;
+  std::vector<uint32_t>::iterator last = m_moving.begin ();
+  for (std::vector<uint32_t>::const_iterator it = m_moving.begin (); it != m_moving.end (); ++it)
+    {
+      uint32_t i = *it;
+      if (!m_isMoving[i])
+        {
+          m_inMovingList[i] = false;
+          continue;
+        }
+      Vector position = m_mobility[i]->GetPosition ();
+      m_x[i] = position.x;
+      m_y[i] = position.y;
+      m_z[i] = position.z;
+      *last++ = i;
+    }
+  m_moving.erase (last, m_moving.end ());
+}
+
+void
+PositionSnapshot::Record (uint32_t i, Ptr<const MobilityModel> mobility)
+{
+  Vector position = mobility->GetPosition ();
+  m_x[i] = position.x;
+  m_y[i] = position.y;
+  m_z[i] = position.z;
+  bool isMoving = mobility->GetVelocity ().GetLength () != 0;
+  // A model stopped since the last Update is still in m_moving.
+  if (isMoving && !m_inMovingList[i])
+    {
+      m_moving.push_back (i);
+      m_inMovingList[i] = true;
+    }
+  m_isMoving[i] = isMoving;
+}
+
+void
+PositionSnapshot::NotifyCourseChange (PositionSnapshot *snapshot, uint32_t i, Ptr<const MobilityModel> mobility)
+{
+  snapshot->Record (i, mobility);
+}
+
+Vector
+PositionSnapshot::GetPosition (uint32_t i) const
+{
+  return Vector (m_x[i], m_y[i], m_z[i]);
+}
+
+double
+PositionSnapshot::GetDistance (uint32_t i, uint32_t j) const
+{
+  double dx = m_x[i] - m_x[j];
+  double dy = m_y[i] - m_y[j];
+  double dz = m_z[i] - m_z[j];
+  return std::sqrt (dx * dx + dy * dy + dz * dz);
+}
+
+void
+PositionSnapshot::GetDistancesFrom (uint32_t i, const uint32_t *indices, std::size_t n, double *distances) const
+{
+  const double x = m_x[i];
+  const double y = m_y[i];
+  const double z = m_z[i];
+  const double *xs = m_x.data ();
+  const double *ys = m_y.data ();
+  const double *zs = m_z.data ();
+  for (std::size_t k = 0; k < n; k++)
+    {
+      uint32_t j = indices[k];
+      double dx = xs[j] - x;
+      double dy = ys[j] - y;
+      double dz = zs[j] - z;
+      distances[k] = std::sqrt (dx * dx + dy * dy + dz * dz);
+    }
+}
+
+const double *
+PositionSnapshot::GetX (void) const
+{
+  return m_x.data ();
+}
+
+const double *
+PositionSnapshot::GetY (void) const
+{
+  return m_y.data ();
+}
+
+const double *
+PositionSnapshot::GetZ (void) const
+{
+  return m_z.data ();
+}
+
+} // namespace ns3
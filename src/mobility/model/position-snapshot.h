@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef POSITION_SNAPSHOT_H
+#define POSITION_SNAPSHOT_H
+
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "ns3/ptr.h"
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ * \brief The positions of a set of mobility models at the current
+ * simulation time, stored as structure of arrays.
+ *
+ * Update refreshes the snapshot at most once per simulation time, and
+ * only for the models which are moving: a model with a zero velocity is
+ * only read again when it fires its CourseChange trace.  This relies on
+ * the mobility models notifying a course change whenever their velocity
+ * changes, which all of them do except the WaypointMobilityModel with
+ * LazyNotify set.  Course changes are applied immediately, so the
+ * snapshot stays exact within a simulation time too.
+ *
+ * The coordinates are kept in separate x, y and z arrays so that the
+ * distances from one model to many others can be computed in a tight
+ * loop.
+ */
+class PositionSnapshot
+{
+public:
+  PositionSnapshot ();
+  ~PositionSnapshot ();
+
+  /**
+   * Add a mobility model to the snapshot and connect to its CourseChange
+   * trace.
+   *
+   * \param mobility the mobility model
+   * \returns the index of the model in the snapshot
+   */
+  uint32_t Add (Ptr<MobilityModel> mobility);
+  /**
+   * Remove all the mobility models and disconnect from their traces.
+   */
+  void Clear (void);
+  /**
+   * \returns the number of mobility models in the snapshot
+   */
+  uint32_t GetN (void) const;
+  /**
+   * Refresh the positions of the moving models, unless this was already
+   * done at the current simulation time.
+   */
+  void Update (void);
+
+  /**
+   * \param i the index of a mobility model
+   * \returns its position at the last Update
+   */
+  Vector GetPosition (uint32_t i) const;
+  /**
+   * \param i the index of a mobility model
+   * \param j the index of another mobility model
+   * \returns the distance between them at the last Update
+   */
+  double GetDistance (uint32_t i, uint32_t j) const;
+  /**
+   * Compute the distances from one model to many others.
+   *
+   * \param i the index of a mobility model
+   * \param indices the indices of the other models
+   * \param n the number of other models
+   * \param distances the n distances, written by this method
+   */
+  void GetDistancesFrom (uint32_t i, const uint32_t *indices, std::size_t n, double *distances) const;
+
+  /**
+   * \returns the x coordinates, indexed like the models
+   */
+  const double * GetX (void) const;
+  /**
+   * \returns the y coordinates, indexed like the models
+   */
+  const double * GetY (void) const;
+  /**
+   * \returns the z coordinates, indexed like the models
+   */
+  const double * GetZ (void) const;
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse: the traces are connected
+   * to this instance.
+   */
+  PositionSnapshot (const PositionSnapshot &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  PositionSnapshot &operator = (const PositionSnapshot &);
+
+  /**
+   * Record the position and the velocity of a model.
+   *
+   * \param i the index of the model
+   * \param mobility the mobility model
+   */
+  void Record (uint32_t i, Ptr<const MobilityModel> mobility);
+  /**
+   * CourseChange trace sink.
+   *
+   * \param snapshot the snapshot
+   * \param i the index of the model
+   * \param mobility the mobility model
+   */
+  static void NotifyCourseChange (PositionSnapshot *snapshot, uint32_t i, Ptr<const MobilityModel> mobility);
+
+  std::vector<Ptr<MobilityModel> > m_mobility; //!< The mobility models
+  std::vector<double> m_x;                     //!< The x coordinates
+  std::vector<double> m_y;                     //!< The y coordinates
+  std::vector<double> m_z;                     //!< The z coordinates
+  std::vector<bool> m_isMoving;                //!< Whether each model has a non zero velocity
+  std::vector<bool> m_inMovingList;            //!< Whether each model is in m_moving
+  std::vector<uint32_t> m_moving;              //!< The models refreshed by Update, may hold stopped ones
+  Time m_time;                                 //!< The simulation time of the last Update
+  bool m_updated;                              //!< Whether Update was called at all
+};
+
+} // namespace ns3
+
+#endif /* POSITION_SNAPSHOT_H */
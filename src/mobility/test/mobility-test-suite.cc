@@ -31,6 +31,9 @@
 #include "ns3/mobility-model.h"
 #include "ns3/waypoint-mobility-model.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/position-snapshot.h"
+#include <cmath>
 
 using namespace ns3;
 
@@ -410,6 +413,89 @@ WaypointMobilityModelViaHelper::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief PositionSnapshot Test
+ *
+ * A static and a moving model are tracked; the moving one is refreshed
+ * by Update while the static one only follows its course changes, even
+ * within one simulation time.
+ */
+class PositionSnapshotTest : public TestCase
+{
+public:
+  PositionSnapshotTest ();
+  virtual ~PositionSnapshotTest ();
+
+private:
+  /**
+   * Update the snapshot and check the distances from the first model
+   * \param snapshot the snapshot
+   * \param update whether to call Update first
+   * \param expected the expected distances
+   */
+  void TestDistances (PositionSnapshot *snapshot, bool update, Vector expected);
+  virtual void DoRun (void);
+};
+
+PositionSnapshotTest::PositionSnapshotTest ()
+  : TestCase ("Test PositionSnapshot refresh and course changes")
+{
+}
+
+PositionSnapshotTest::~PositionSnapshotTest ()
+{
+}
+
+void
+PositionSnapshotTest::TestDistances (PositionSnapshot *snapshot, bool update, Vector expected)
+{
+  if (update)
+    {
+      snapshot->Update ();
+    }
+  uint32_t indices[] = {1, 2, 0};
+  double distances[3];
+  snapshot->GetDistancesFrom (0, indices, 3, distances);
+  NS_TEST_EXPECT_MSG_EQ_TOL (distances[0], expected.x, 1e-9, "Distance to the moving model at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_EXPECT_MSG_EQ_TOL (distances[1], expected.y, 1e-9, "Distance to the stopped model at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_EXPECT_MSG_EQ (distances[2], 0, "Distance to itself");
+  NS_TEST_EXPECT_MSG_EQ_TOL (snapshot->GetDistance (1, 0), expected.x, 1e-9, "Distance is symmetric");
+}
+
+void
+PositionSnapshotTest::DoRun (void)
+{
+  Ptr<ConstantVelocityMobilityModel> fixed = CreateObject<ConstantVelocityMobilityModel> ();
+  Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+  Ptr<ConstantVelocityMobilityModel> stopped = CreateObject<ConstantVelocityMobilityModel> ();
+  moving->SetPosition (Vector (1.0, 0.0, 0.0));
+  moving->SetVelocity (Vector (1.0, 0.0, 0.0));
+  stopped->SetPosition (Vector (0.0, 1.0, 0.0));
+  stopped->SetVelocity (Vector (0.0, 1.0, 0.0));
+  PositionSnapshot snapshot;
+  snapshot.Add (fixed);
+  snapshot.Add (moving);
+  snapshot.Add (stopped);
+  NS_TEST_EXPECT_MSG_EQ (snapshot.GetN (), 3, "Three models");
+
+  Simulator::Schedule (Seconds (2), &PositionSnapshotTest::TestDistances, this, &snapshot, true, Vector (3, 3, 0));
+  // A course change is applied without waiting for the next time
+  Simulator::Schedule (Seconds (2), &MobilityModel::SetPosition, fixed, Vector (0.0, -1.0, 0.0));
+  Simulator::Schedule (Seconds (2), &PositionSnapshotTest::TestDistances, this, &snapshot, false,
+                       Vector (std::sqrt (10.0), 4, 0));
+  // Update at the same time does not read the models again
+  Simulator::Schedule (Seconds (2), &PositionSnapshotTest::TestDistances, this, &snapshot, true,
+                       Vector (std::sqrt (10.0), 4, 0));
+  Simulator::Schedule (Seconds (4), &ConstantVelocityMobilityModel::SetVelocity, stopped, Vector ());
+  Simulator::Schedule (Seconds (6), &PositionSnapshotTest::TestDistances, this, &snapshot, true,
+                       Vector (std::sqrt (50.0), 6, 0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup mobility-test
  * \ingroup tests
@@ -429,6 +515,7 @@ MobilityTestSuite::MobilityTestSuite ()
   AddTestCase (new WaypointLazyNotifyTrue, TestCase::QUICK);
   AddTestCase (new WaypointInitialPositionIsWaypoint, TestCase::QUICK);
   AddTestCase (new WaypointMobilityModelViaHelper, TestCase::QUICK);
+  AddTestCase (new PositionSnapshotTest, TestCase::QUICK);
 }
 
 static MobilityTestSuite mobilityTestSuite; ///< the test suite
@@ -36,17 +36,8 @@ bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList ()
-{
-  NS_LOG_FUNCTION (this);
-  for (iterator i = begin (); i != end (); i++)
-    {
-      PacketMetadata::Deallocate (*i);
-    }
-  PacketMetadata::m_enable = false;
-}
+struct PacketMetadata::Data *PacketMetadata::m_arena[PacketMetadata::ARENA_CLASSES];
+struct PacketMetadata::Data PacketMetadata::m_empty = { 1, 0, 0, { 0 } };
 
 void 
 PacketMetadata::Enable (void)
@@ -566,6 +557,17 @@ PacketMetadata::ReadItems (uint16_t current,
   return buffer - &m_data->m_data[current];
 }
 
+uint32_t
+PacketMetadata::GetArenaClass (uint32_t size)
+{
+  uint32_t sizeClass = 0;
+  while (sizeClass < ARENA_CLASSES && (1U << (ARENA_MIN_SHIFT + sizeClass)) < size)
+    {
+      sizeClass++;
+    }
+  return sizeClass;
+}
+
 struct PacketMetadata::Data *
 PacketMetadata::Create (uint32_t size)
 {
@@ -575,43 +577,52 @@ PacketMetadata::Create (uint32_t size)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
+  // Size all buffers for the largest metadata seen so far, so that
+  // they rarely need to grow.
+  uint32_t sizeClass = GetArenaClass (m_maxSize);
+  if (sizeClass == ARENA_CLASSES)
+    {
+      NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
+      return PacketMetadata::Allocate (m_maxSize);
+    }
+  if (m_arena[sizeClass] == 0)
     {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
-      if (data->m_size >= size) 
+      uint32_t n = 1U << (ARENA_MIN_SHIFT + sizeClass);
+      uint32_t recordSize = sizeof (struct Data) + n - PACKET_METADATA_DATA_M_DATA_SIZE;
+      recordSize = (recordSize + sizeof (struct Data *) - 1) & ~(sizeof (struct Data *) - 1);
+      uint8_t *slab = new uint8_t [recordSize * ARENA_SLAB_SIZE];
+      NS_LOG_LOGIC ("create slab size="<<n);
+      for (uint32_t i = 0; i < ARENA_SLAB_SIZE; i++)
         {
-          NS_LOG_LOGIC ("create found size="<<data->m_size);
-          data->m_count = 1;
-          return data;
+          struct PacketMetadata::Data *data = (struct PacketMetadata::Data *)(slab + i * recordSize);
+          data->m_size = n;
+          data->m_count = 0;
+          memcpy (data->m_data, &m_arena[sizeClass], sizeof (struct Data *));
+          m_arena[sizeClass] = data;
         }
-      NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
-      PacketMetadata::Deallocate (data);
     }
-  NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
-  return PacketMetadata::Allocate (m_maxSize);
+  struct PacketMetadata::Data *data = m_arena[sizeClass];
+  memcpy (&m_arena[sizeClass], data->m_data, sizeof (struct Data *));
+  data->m_count = 1;
+  data->m_dirtyEnd = 0;
+  return data;
 }
 
 void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
-    {
-      PacketMetadata::Deallocate (data);
-      return;
-    } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
+  NS_ASSERT (data != &m_empty);
+  uint32_t sizeClass = GetArenaClass (data->m_size);
+  if (sizeClass == ARENA_CLASSES)
     {
       PacketMetadata::Deallocate (data);
-    } 
-  else 
-    {
-      m_freeList.push_back (data);
+      return;
     }
+  NS_LOG_LOGIC ("recycle size="<<data->m_size);
+  memcpy (data->m_data, &m_arena[sizeClass], sizeof (struct Data *));
+  m_arena[sizeClass] = data;
 }
 
 struct PacketMetadata::Data *
@@ -655,6 +666,12 @@ PacketMetadata::AddHeader (const Header &header, uint32_t size)
 {
   NS_LOG_FUNCTION (this << &header << size);
   NS_ASSERT (IsStateOk ());
+  if (!m_enable)
+    {
+      // Skip the TypeId lookup on the fast path.
+      m_metadataSkipped = true;
+      return;
+    }
   uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   DoAddHeader (uid, size);
   NS_ASSERT (IsStateOk ());
@@ -682,14 +699,14 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
 void 
 PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
 {
-  uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &header << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (!m_enable)
     {
       m_metadataSkipped = true;
       return;
     }
+  uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_head, &item, &extraItem);
@@ -730,7 +747,6 @@ PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
 void 
 PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
 {
-  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &trailer << size);
   NS_ASSERT (IsStateOk ());
   if (!m_enable)
@@ -738,6 +754,7 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   struct PacketMetadata::SmallItem item;
   item.next = 0xffff;
   item.prev = m_tail;
@@ -752,14 +769,14 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
 void 
 PacketMetadata::RemoveTrailer (const Trailer &trailer, uint32_t size)
 {
-  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &trailer << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (!m_enable)
     {
       m_metadataSkipped = true;
       return;
     }
+  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_tail, &item, &extraItem);
@@ -494,16 +494,6 @@ private:
     uint64_t packetUid;
   };
 
-  /**
-   * \brief Class to hold all the metadata
-   */
-  class DataFreeList : public std::vector<struct Data *>
-  {
-public:
-    ~DataFreeList ();
-  };
-
-  friend DataFreeList::~DataFreeList ();
   /// Friend class
   friend class ItemIterator;
 
@@ -661,7 +651,34 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
+  /**
+   * \brief Get the size class of a metadata buffer
+   * \param size the buffer size
+   * \returns the index of the smallest arena size class holding size
+   *          bytes, or ARENA_CLASSES if the buffer is too large for the arena
+   */
+  static uint32_t GetArenaClass (uint32_t size);
+
+  /// Number of size classes in the arena
+  static const uint32_t ARENA_CLASSES = 8;
+  /// Buffer size of the smallest size class: 32 bytes
+  static const uint32_t ARENA_MIN_SHIFT = 5;
+  /// Number of buffers allocated at once for a size class
+  static const uint32_t ARENA_SLAB_SIZE = 32;
+
+  /**
+   * The metadata storage arena: free buffers of each size class, linked
+   * through their m_data field.  Buffers are carved from slabs which
+   * are never released, so that packets freed during static destruction
+   * still find a valid arena.
+   */
+  static struct Data *m_arena[ARENA_CLASSES];
+  /**
+   * The storage shared by all the packets created while the metadata is
+   * disabled.  It holds a reference of its own and has no room, so that
+   * it is never recycled nor written to.
+   */
+  static struct Data m_empty;
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -692,12 +709,20 @@ public:
 namespace ns3 {
 
 PacketMetadata::PacketMetadata (uint64_t uid, uint32_t size)
-  : m_data (PacketMetadata::Create (10)),
+  : m_data (&m_empty),
     m_head (0xffff),
     m_tail (0xffff),
     m_used (0),
     m_packetUid (uid)
 {
+  if (!m_enable)
+    {
+      // Nothing to record: share the empty storage.
+      m_empty.m_count++;
+      m_metadataSkipped = m_metadataSkipped || size > 0;
+      return;
+    }
+  m_data = PacketMetadata::Create (10);
   memset (m_data->m_data, 0xff, 4);
   if (size > 0)
     {
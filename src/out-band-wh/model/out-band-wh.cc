@@ -47,22 +47,23 @@ WhTag::GetInstanceTypeId (void) const
   return GetTypeId ();
 }
 
-// ======================================================
-// ★追加：Hello(RREP形式) 判定ヘルパ
-//   ns-3 AODVのHelloはRREPで hopCount=0, dst==origin==送信元, かつIP宛先がブロードキャスト…等の特徴
-// ======================================================
-static bool
-IsHelloRrep (const aodv::RrepHeader& rrep, const Ipv4Header& ip)
+NS_OBJECT_ENSURE_REGISTERED (WhClassTag);
+
+TypeId
+WhClassTag::GetTypeId (void)
 {
-  // const Ipv4Address ipSrc = ip.GetSource ();
-  // const Ipv4Address ipDst = ip.GetDestination ();
+  static TypeId tid = TypeId ("ns3::WhClassTag")
+    .SetParent<Tag> ()
+    .SetGroupName ("Wormhole")
+    .AddConstructor<WhClassTag> ()
+  ;
+  return tid;
+}
 
-  // Helloメッセージの場合、メッセージをドロップ
-  if (rrep.GetDst () == rrep.GetOrigin ())
-    {
-      return true;
-    }
-  return false;
+TypeId
+WhClassTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
 }
 
 // ==============================
@@ -138,9 +139,77 @@ WormholeApp::StopApplication ()
     }
 }
 
+// --------------------------------------------------------
+// Classify: 先頭バイトだけをスタック上に読み出して分類
+//   IPv4: 0=ver/IHL, 6-7=flags/offset, 9=protocol, 12=src, 16=dst
+//   UDP : ihl+0=src port, ihl+2=dst port
+//   AODV: ihl+8=type
+//   RREP: ihl+12=dst, ihl+20=origin（type, flags, prefix, hopCount の後）
+//   ns-3 AODV の Hello は dst==origin の RREP
+// --------------------------------------------------------
+static inline uint16_t
+PeekU16 (const uint8_t *p)
+{
+  return static_cast<uint16_t> ((p[0] << 8) | p[1]);
+}
+
+static inline uint32_t
+PeekU32 (const uint8_t *p)
+{
+  return (static_cast<uint32_t> (p[0]) << 24) | (static_cast<uint32_t> (p[1]) << 16)
+         | (static_cast<uint32_t> (p[2]) << 8) | p[3];
+}
+
+bool
+WormholeApp::Classify (Ptr<const Packet> pkt, WhPacketInfo &info)
+{
+  // IHL 最大 60 バイト + UDP 8 + RREP origin まで 16
+  uint8_t buf[60 + 8 + 16];
+  uint32_t n = pkt->CopyData (buf, sizeof (buf));
+  info.cls = WH_PKT_UNKNOWN;
+  if (n < 20 || (buf[0] >> 4) != 4)
+    return false;
+
+  uint32_t ihl = (buf[0] & 0x0f) * 4;
+  info.ipSrc = Ipv4Address (PeekU32 (buf + 12));
+  info.ipDst = Ipv4Address (PeekU32 (buf + 16));
+
+  // UDP 以外、または UDP ヘッダを含まない後続フラグメント
+  if (buf[9] != UdpL4Protocol::PROT_NUMBER || (PeekU16 (buf + 6) & 0x1fff) != 0
+      || ihl < 20 || n < ihl + 8)
+    {
+      info.cls = WH_PKT_NON_UDP;
+      return true;
+    }
+
+  const uint8_t *udp = buf + ihl;
+  if (PeekU16 (udp) != aodv::RoutingProtocol::AODV_PORT
+      && PeekU16 (udp + 2) != aodv::RoutingProtocol::AODV_PORT)
+    {
+      info.cls = WH_PKT_NON_AODV;
+      return true;
+    }
+
+  info.cls = WH_PKT_AODV_OTHER;
+  if (n < ihl + 9)
+    return true;
+
+  const uint8_t *msg = udp + 8;
+  if (msg[0] == aodv::AODVTYPE_RREQ)
+    {
+      info.cls = WH_PKT_AODV_RREQ;
+    }
+  else if (msg[0] == aodv::AODVTYPE_RREP && n >= ihl + 8 + 16)
+    {
+      info.cls = PeekU32 (msg + 4) == PeekU32 (msg + 12) ? WH_PKT_AODV_HELLO : WH_PKT_AODV_RREP;
+    }
+  return true;
+}
+
 // --------------------------------------------------------
 // PromiscSniff: 無線で受信したパケットをキャプチャしてトンネルへ
 //   ただし「WH が再注入したパケット（WhTag 付き）」は無視する
+//   判定は Classify で行い、コピーはトンネル送信するパケットだけ
 // --------------------------------------------------------
 bool
 WormholeApp::PromiscSniff (Ptr<NetDevice> dev,
@@ -159,115 +228,47 @@ WormholeApp::PromiscSniff (Ptr<NetDevice> dev,
   if (protocol != 0x0800)
     return true;
 
-  Ptr<Packet> copy = pkt->Copy ();
-
-  // IP/UDP を確認
-  Ipv4Header ip;
-  if (!copy->PeekHeader (ip))
+  WhPacketInfo info;
+  if (!Classify (pkt, info))
     return true;
 
-  // ============================
   // ForwardMode=0: 全て転送
-  // ============================
-  if (m_forwardMode == 0)
-  {
-    Ptr<Packet> sendPkt = pkt->Copy ();
-
-    Mac48Address srcMac = Mac48Address::ConvertFrom (src);
-    Mac48Address dstMac = Mac48Address::ConvertFrom (dst);
-
-    WhTunnelHeader meta;
-    meta.Set(/*etherType=*/protocol,
-              /*packetType=*/static_cast<uint8_t>(type),
-              /*srcMac=*/srcMac,
-              /*dstMac=*/dstMac,
-              /*ipSrc=*/ip.GetSource (),
-              /*ipDst=*/ip.GetDestination ());
-
-    sendPkt->AddHeader (meta);
-
-    if (m_socket)
-      {
-        m_socket->SendTo (sendPkt, 0, InetSocketAddress (m_peer, m_port));
-      }
+  // ForwardMode=1: RREQ/RREPのみ(Hello除外)
+  if (m_forwardMode == 1 && !IsRouteDiscovery (info.cls))
     return true;
-  }
 
-// ============================
-// ForwardMode=1: RREQ/RREPのみ(Hello除外)
-// ============================
+  // ---- ここまで来たらトンネル送信 ----
+  Ptr<Packet> sendPkt = pkt->Copy ();
 
-// UDPでないなら対象外（RREQ/RREPはUDP）
-if (ip.GetProtocol () != UdpL4Protocol::PROT_NUMBER)
-  return true;
+  Mac48Address srcMac = Mac48Address::ConvertFrom (src);
+  Mac48Address dstMac = Mac48Address::ConvertFrom (dst);
 
-copy->RemoveHeader (ip);
-UdpHeader udp;
-if (!copy->PeekHeader (udp))
-  return true;
-
-// AODVポート以外は対象外
-if (udp.GetDestinationPort () != aodv::RoutingProtocol::AODV_PORT &&
-    udp.GetSourcePort      () != aodv::RoutingProtocol::AODV_PORT)
-  return true;
-
-// AODVタイプを見て RREQ/RREP のみに限定
-copy->RemoveHeader (udp);
-
-aodv::TypeHeader th;
-if (!copy->RemoveHeader (th))
-  return true;
+  WhTunnelHeader meta;
+  meta.Set(/*etherType=*/protocol,
+            /*packetType=*/static_cast<uint8_t>(type),
+            /*srcMac=*/srcMac,
+            /*dstMac=*/dstMac,
+            /*ipSrc=*/info.ipSrc,
+            /*ipDst=*/info.ipDst);
 
-bool allowTunnel = false;
+  sendPkt->AddHeader (meta);
 
-if (th.Get () == aodv::AODVTYPE_RREQ)
-{
-  allowTunnel = true;
-}
-else if (th.Get () == aodv::AODVTYPE_RREP)
-{
-  aodv::RrepHeader rrep;
-  if (!copy->RemoveHeader (rrep))
-    return true;
+  // 分類結果を相方 WH に渡す
+  WhClassTag clsTag (info.cls);
+  sendPkt->ReplacePacketTag (clsTag);
 
-  // ★Hello(RREP形式)は除外
-  if (!IsHelloRrep (rrep, ip))
+  if (m_socket)
     {
-      allowTunnel = true;
+      m_socket->SendTo (sendPkt, 0, InetSocketAddress (m_peer, m_port));
     }
-}
-
-if (!allowTunnel)
   return true;
-
-// ---- ここまで来たらトンネル送信 ----
-Ptr<Packet> sendPkt = pkt->Copy ();
-
-Mac48Address srcMac = Mac48Address::ConvertFrom (src);
-Mac48Address dstMac = Mac48Address::ConvertFrom (dst);
-
-WhTunnelHeader meta;
-meta.Set(/*etherType=*/protocol,
-          /*packetType=*/static_cast<uint8_t>(type),
-          /*srcMac=*/srcMac,
-          /*dstMac=*/dstMac,
-          /*ipSrc=*/ip.GetSource (),
-          /*ipDst=*/ip.GetDestination ());
-
-sendPkt->AddHeader (meta);
-
-if (m_socket)
-{
-  m_socket->SendTo (sendPkt, 0, InetSocketAddress (m_peer, m_port));
-}
-
-return true;
 }
 
 
 // --------------------------------------------------------
 // TunnelRecv: P2P (UDP) 経由で受け取ったパケットを無線に再注入
 //   再注入前に WhTag を付けることで、逆側 WH の PromiscSniff でスキップできる
+//   ヘッダの付け外しは WHForwardFlag/宛先を書き換える AODV パケットだけ
 // --------------------------------------------------------
 void
 WormholeApp::TunnelRecv (Ptr<Socket> socket)
@@ -282,101 +283,64 @@ WormholeApp::TunnelRecv (Ptr<Socket> socket)
     return;
 
   // 2) 以降 pkt は「元のIPv4パケット」先頭に戻っている想定
+  //    分類は送信側のタグを使い、無ければここで覗く
+  WhPacketClass cls;
+  WhClassTag clsTag;
+  if (pkt->RemovePacketTag (clsTag) && clsTag.Get () != WH_PKT_UNKNOWN)
+    {
+      cls = clsTag.Get ();
+    }
+  else
+    {
+      WhPacketInfo info;
+      if (!Classify (pkt, info))
+        return;
+      cls = info.cls;
+    }
 
-  // ---- IP/UDP/AODV を解析（必要なら改変）----
-  Ipv4Header ip;
-  if (!pkt->RemoveHeader (ip))
-    return;
-
-  // UDPでない場合：ForwardMode=0ならそのまま再注入、ForwardMode=1なら対象外なのでdrop
-  if (ip.GetProtocol () != UdpL4Protocol::PROT_NUMBER)
-  {
-    if (m_forwardMode == 1)
-      return;
-
-    pkt->AddHeader (ip);
-    WhTag tag; pkt->AddPacketTag (tag);
-    m_dev->Send (pkt, meta.GetDstMac (), meta.GetEtherType ());
-    return;
-  }
-
-UdpHeader udp;
-  if (!pkt->RemoveHeader (udp))
+  // ForwardMode=1：RREQ/RREP(Hello除外)以外はdrop
+  if (m_forwardMode == 1 && !IsRouteDiscovery (cls))
     return;
 
-  // AODV以外：ForwardMode=0ならそのまま再注入、ForwardMode=1ならdrop
-  const bool isAodv =
-      (udp.GetDestinationPort () == aodv::RoutingProtocol::AODV_PORT ||
-       udp.GetSourcePort      () == aodv::RoutingProtocol::AODV_PORT);
-
-  if (!isAodv)
+  // UDP/AODV 以外はそのまま再注入
+  if (cls == WH_PKT_NON_UDP || cls == WH_PKT_NON_AODV)
     {
-      if (m_forwardMode == 1)
-        return;
-
-      pkt->AddHeader (udp);
-      pkt->AddHeader (ip);
       WhTag tag; pkt->AddPacketTag (tag);
       m_dev->Send (pkt, meta.GetDstMac (), meta.GetEtherType ());
       return;
     }
 
-  // ここからAODV：タイプ判定
-  aodv::TypeHeader type;
-  if (!pkt->RemoveHeader (type))
+  Ipv4Header ip;
+  if (!pkt->RemoveHeader (ip))
     return;
 
-  // ForwardMode=1：RREQ/RREP(Hello除外)以外はdrop
-  if (m_forwardMode == 1)
-    {
-      bool allow = false;
-      if (type.Get () == aodv::AODVTYPE_RREQ)
-        {
-          allow = true;
-        }
-      else if (type.Get () == aodv::AODVTYPE_RREP)
-        {
-          aodv::RrepHeader rrepCheck;
-          if (!pkt->RemoveHeader (rrepCheck))
-            return;
-
-          if (IsHelloRrep (rrepCheck, ip))
-            return; // ★Helloは再注入しない
-
-          // 判定のため一度外したので戻しておく（後で改変処理があるため）
-          pkt->AddHeader (rrepCheck);
-          allow = true;
-        }
-
-      if (!allow)
-        return;
-    }
-
-  // ---- AODV type を見てあなたのWHForwardFlag処理を維持 ----
-  if (type.Get () == aodv::AODVTYPE_RREQ)
+  // ---- RREQ/RREP は WHForwardFlag を立てる ----
+  if (cls == WH_PKT_AODV_RREQ || cls == WH_PKT_AODV_RREP || cls == WH_PKT_AODV_HELLO)
     {
-      aodv::RreqHeader rreq;
-      if (pkt->RemoveHeader (rreq))
+      UdpHeader udp;
+      aodv::TypeHeader aodvType;
+      pkt->RemoveHeader (udp);
+      pkt->RemoveHeader (aodvType);
+      if (cls == WH_PKT_AODV_RREQ)
         {
-          rreq.SetWHForwardFlag (1);
-          pkt->AddHeader (rreq);
+          aodv::RreqHeader rreq;
+          if (pkt->RemoveHeader (rreq))
+            {
+              rreq.SetWHForwardFlag (1);
+              pkt->AddHeader (rreq);
+            }
         }
-      pkt->AddHeader (type);
-    }
-  else if (type.Get () == aodv::AODVTYPE_RREP)
-    {
-      aodv::RrepHeader rrep;
-      if (pkt->RemoveHeader (rrep))
+      else
         {
-          // ★ForwardMode=1ではHelloは既にdrop済み
-          rrep.SetWHForwardFlag (1);
-          pkt->AddHeader (rrep);
+          aodv::RrepHeader rrep;
+          if (pkt->RemoveHeader (rrep))
+            {
+              rrep.SetWHForwardFlag (1);
+              pkt->AddHeader (rrep);
+            }
         }
-      pkt->AddHeader (type);
-    }
-  else
-    {
-      pkt->AddHeader (type);
+      pkt->AddHeader (aodvType);
+      pkt->AddHeader (udp);
     }
 
   // 3) ユニキャスト制御の再注入調整（元コード維持）
@@ -387,8 +351,6 @@ UdpHeader udp;
       l2dst = Mac48Address::GetBroadcast ();
     }
 
-  // UDP/IP を戻す
-  pkt->AddHeader (udp);
   pkt->AddHeader (ip);
 
   // 4) ループ防止タグを付けて再注入
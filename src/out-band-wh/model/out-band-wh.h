@@ -44,6 +44,66 @@ public:
   }
 };
 
+// ==============================
+// トンネル対象判定の分類
+// ==============================
+enum WhPacketClass
+{
+  WH_PKT_UNKNOWN = 0,  // 未分類
+  WH_PKT_NON_UDP,      // UDP 以外の IPv4（または後続フラグメント）
+  WH_PKT_NON_AODV,     // AODV ポート以外の UDP
+  WH_PKT_AODV_RREQ,    // RREQ
+  WH_PKT_AODV_RREP,    // RREP（Hello 以外）
+  WH_PKT_AODV_HELLO,   // Hello（dst == origin の RREP）
+  WH_PKT_AODV_OTHER,   // その他の AODV 制御パケット
+};
+
+// PromiscSniff/TunnelRecv が参照する IPv4 パケットの要約
+struct WhPacketInfo
+{
+  WhPacketClass cls {WH_PKT_UNKNOWN};
+  Ipv4Address ipSrc;
+  Ipv4Address ipDst;
+};
+
+// ==============================
+// 分類結果をトンネル越しに運ぶタグ
+//   受信側 WH はこれを見て再解析を省略する
+// ==============================
+class WhClassTag : public Tag
+{
+public:
+  WhClassTag (WhPacketClass cls = WH_PKT_UNKNOWN) : m_cls (cls) {}
+
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const override;
+
+  virtual uint32_t GetSerializedSize (void) const override
+  {
+    return 1;
+  }
+
+  virtual void Serialize (TagBuffer i) const override
+  {
+    i.WriteU8 (static_cast<uint8_t> (m_cls));
+  }
+
+  virtual void Deserialize (TagBuffer i) override
+  {
+    m_cls = static_cast<WhPacketClass> (i.ReadU8 ());
+  }
+
+  virtual void Print (std::ostream &os) const override
+  {
+    os << "WhClassTag cls=" << static_cast<uint32_t> (m_cls);
+  }
+
+  WhPacketClass Get () const { return m_cls; }
+
+private:
+  WhPacketClass m_cls;
+};
+
 // ==============================
 // 外部 WH アプリケーション本体
 // ==============================
@@ -57,6 +117,17 @@ public:
 
   void Setup(Ptr<NetDevice> dev, Ipv4Address peer, uint16_t port);
 
+  // IPv4/UDP/AODV の各フィールドを固定オフセットで覗いて分類する
+  // （Packet のコピーやヘッダのデシリアライズは行わない）
+  // IPv4 ヘッダとして短すぎる場合は false
+  static bool Classify (Ptr<const Packet> pkt, WhPacketInfo &info);
+
+  // ForwardMode=1 でトンネルする分類か（RREQ/RREP、Hello除外）
+  static bool IsRouteDiscovery (WhPacketClass cls)
+  {
+    return cls == WH_PKT_AODV_RREQ || cls == WH_PKT_AODV_RREP;
+  }
+
 private:
   virtual void StartApplication() override;
   virtual void StopApplication() override;
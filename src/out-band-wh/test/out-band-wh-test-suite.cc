@@ -6,6 +6,12 @@
 // An essential include is test.h
 #include "ns3/test.h"
 
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/aodv-packet.h"
+#include "ns3/aodv-routing-protocol.h"
+
 // Do not put your test classes in namespace ns3.  You may find it useful
 // to use the using directive to access the ns3 namespace directly
 using namespace ns3;
@@ -46,6 +52,90 @@ OutBandWhTestCase1::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
 }
 
+// WormholeApp::Classify の固定オフセット判定が
+// ヘッダのデシリアライズ結果と一致することを確認する
+class OutBandWhClassifyTestCase : public TestCase
+{
+public:
+  OutBandWhClassifyTestCase ();
+
+private:
+  Ptr<Packet> MakeAodv (const Header &msg, aodv::MessageType t, uint16_t port);
+  virtual void DoRun (void);
+};
+
+OutBandWhClassifyTestCase::OutBandWhClassifyTestCase ()
+  : TestCase ("OutBandWh packet classification")
+{
+}
+
+Ptr<Packet>
+OutBandWhClassifyTestCase::MakeAodv (const Header &msg, aodv::MessageType t, uint16_t port)
+{
+  Ptr<Packet> p = Create<Packet> ();
+  p->AddHeader (msg);
+  p->AddHeader (aodv::TypeHeader (t));
+  UdpHeader udp;
+  udp.SetSourcePort (port);
+  udp.SetDestinationPort (port);
+  p->AddHeader (udp);
+  Ipv4Header ip;
+  ip.SetSource (Ipv4Address ("10.0.0.1"));
+  ip.SetDestination (Ipv4Address ("10.0.0.255"));
+  ip.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+  ip.SetPayloadSize (p->GetSize ());
+  p->AddHeader (ip);
+  return p;
+}
+
+void
+OutBandWhClassifyTestCase::DoRun (void)
+{
+  const uint16_t port = aodv::RoutingProtocol::AODV_PORT;
+  WhPacketInfo info;
+
+  aodv::RreqHeader rreq;
+  NS_TEST_ASSERT_MSG_EQ (WormholeApp::Classify (MakeAodv (rreq, aodv::AODVTYPE_RREQ, port), info), true, "IPv4");
+  NS_TEST_EXPECT_MSG_EQ (info.cls, WH_PKT_AODV_RREQ, "RREQ");
+  NS_TEST_EXPECT_MSG_EQ (info.ipSrc, Ipv4Address ("10.0.0.1"), "source address");
+  NS_TEST_EXPECT_MSG_EQ (info.ipDst, Ipv4Address ("10.0.0.255"), "destination address");
+
+  aodv::RrepHeader rrep (0, 3, Ipv4Address ("10.0.0.9"), 1, Ipv4Address ("10.0.0.4"), Seconds (1));
+  WormholeApp::Classify (MakeAodv (rrep, aodv::AODVTYPE_RREP, port), info);
+  NS_TEST_EXPECT_MSG_EQ (info.cls, WH_PKT_AODV_RREP, "RREP");
+  NS_TEST_EXPECT_MSG_EQ (WormholeApp::IsRouteDiscovery (info.cls), true, "RREP is tunneled");
+
+  rrep.SetHello (Ipv4Address ("10.0.0.1"), 5, Seconds (1));
+  WormholeApp::Classify (MakeAodv (rrep, aodv::AODVTYPE_RREP, port), info);
+  NS_TEST_EXPECT_MSG_EQ (info.cls, WH_PKT_AODV_HELLO, "Hello");
+  NS_TEST_EXPECT_MSG_EQ (WormholeApp::IsRouteDiscovery (info.cls), false, "Hello is not tunneled");
+
+  aodv::RrepAckHeader ack;
+  WormholeApp::Classify (MakeAodv (ack, aodv::AODVTYPE_RREP_ACK, port), info);
+  NS_TEST_EXPECT_MSG_EQ (info.cls, WH_PKT_AODV_OTHER, "RREP-ACK");
+
+  WormholeApp::Classify (MakeAodv (rreq, aodv::AODVTYPE_RREQ, 9), info);
+  NS_TEST_EXPECT_MSG_EQ (info.cls, WH_PKT_NON_AODV, "other UDP port");
+
+  Ptr<Packet> tcp = Create<Packet> (40);
+  Ipv4Header ip;
+  ip.SetProtocol (6);
+  ip.SetPayloadSize (40);
+  tcp->AddHeader (ip);
+  WormholeApp::Classify (tcp, info);
+  NS_TEST_EXPECT_MSG_EQ (info.cls, WH_PKT_NON_UDP, "not UDP");
+
+  NS_TEST_EXPECT_MSG_EQ (WormholeApp::Classify (Create<Packet> (8), info), false, "too short for IPv4");
+
+  // 分類タグはトンネルの前後で保持される
+  Ptr<Packet> p = Create<Packet> (10);
+  p->AddPacketTag (WhClassTag (WH_PKT_AODV_RREP));
+  Ptr<Packet> q = p->Copy ();
+  WhClassTag tag;
+  NS_TEST_EXPECT_MSG_EQ (q->RemovePacketTag (tag), true, "tag present");
+  NS_TEST_EXPECT_MSG_EQ (tag.Get (), WH_PKT_AODV_RREP, "tag value");
+}
+
 // The TestSuite class names the TestSuite, identifies what type of TestSuite,
 // and enables the TestCases to be run.  Typically, only the constructor for
 // this class must be defined
@@ -61,6 +151,7 @@ OutBandWhTestSuite::OutBandWhTestSuite ()
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
   AddTestCase (new OutBandWhTestCase1, TestCase::QUICK);
+  AddTestCase (new OutBandWhClassifyTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -62,12 +62,25 @@ public:
    * \return the number of stream indices assigned by this model
    */
   int64_t AssignStreams (int64_t stream);
+  /**
+   * \returns true if the delay returned by GetDelay only depends on the
+   *          positions of the nodes, so that it can be memoized as long
+   *          as the nodes do not move
+   */
+  bool IsDeterministic (void) const;
 private:
   /**
    * Subclasses must implement this; those not using random variables
    * can return zero
    */
   virtual int64_t DoAssignStreams (int64_t stream) = 0;
+  /**
+   * Subclasses which do not use random variables can return true; the
+   * default is false.
+   *
+   * \returns true if GetDelay only depends on the positions of the nodes
+   */
+  virtual bool DoIsDeterministic (void) const;
 };
 
 /**
@@ -124,6 +137,7 @@ public:
   double GetSpeed (void) const;
 private:
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
   double m_speed; //!< speed
 };
 
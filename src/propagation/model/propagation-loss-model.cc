@@ -29,6 +29,7 @@
 #include "ns3/string.h"
 #include "ns3/pointer.h"
 #include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -82,6 +83,28 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+void
+PropagationLossModel::CalcRxPowerBatch (double txPowerDbm,
+                                        const PropagationLossBatch &batch,
+                                        double *rxPowerDbm) const
+{
+  std::fill (rxPowerDbm, rxPowerDbm + batch.n, txPowerDbm);
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      model->DoCalcRxPowerBatch (batch, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                          double *rxPowerDbm) const
+{
+  for (std::size_t i = 0; i < batch.n; i++)
+    {
+      rxPowerDbm[i] = DoCalcRxPower (rxPowerDbm[i], batch.sender, batch.receivers[i]);
+    }
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -94,6 +117,18 @@ PropagationLossModel::AssignStreams (int64_t stream)
   return (currentStream - stream);
 }
 
+bool
+PropagationLossModel::IsDeterministic (void) const
+{
+  return DoIsDeterministic () && (m_next == 0 || m_next->IsDeterministic ());
+}
+
+bool
+PropagationLossModel::DoIsDeterministic (void) const
+{
+  return false;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (RandomPropagationLossModel);
@@ -277,6 +312,29 @@ FriisPropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+FriisPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
+void
+FriisPropagationLossModel::DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                               double *rxPowerDbm) const
+{
+  // Same arithmetic as DoCalcRxPower, without branches so that the loop
+  // can be vectorized
+  const double numerator = m_lambda * m_lambda;
+  const double *distances = batch.distances;
+  for (std::size_t i = 0; i < batch.n; i++)
+    {
+      double distance = distances[i];
+      double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
+      double lossDb = -10 * log10 (numerator / denominator);
+      rxPowerDbm[i] -= distance <= 0 ? m_minLoss : std::max (lossDb, m_minLoss);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -451,6 +509,37 @@ TwoRayGroundPropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+TwoRayGroundPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
+void
+TwoRayGroundPropagationLossModel::DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                                      double *rxPowerDbm) const
+{
+  // Same arithmetic as DoCalcRxPower, without branches so that the loop
+  // can be vectorized
+  const double numerator = m_lambda * m_lambda;
+  const double txAntHeight = batch.senderPosition.z + m_heightAboveZ;
+  const double *distances = batch.distances;
+  for (std::size_t i = 0; i < batch.n; i++)
+    {
+      double distance = distances[i];
+      double rxAntHeight = batch.receiverPositions[i].z + m_heightAboveZ;
+      double dCross = (4 * M_PI * txAntHeight * rxAntHeight) / m_lambda;
+      double tmp = M_PI * distance;
+      double denominator = 16 * tmp * tmp * m_systemLoss;
+      tmp = txAntHeight * rxAntHeight;
+      double rayNumerator = tmp * tmp;
+      tmp = distance * distance;
+      double rayDenominator = tmp * tmp * m_systemLoss;
+      double pr = 10 * std::log10 (distance <= dCross ? numerator / denominator : rayNumerator / rayDenominator);
+      rxPowerDbm[i] += distance <= m_minDistance ? 0 : pr;
+    }
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (LogDistancePropagationLossModel);
@@ -540,6 +629,28 @@ LogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+LogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
+void
+LogDistancePropagationLossModel::DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                                     double *rxPowerDbm) const
+{
+  // Same arithmetic as DoCalcRxPower, without branches so that the loop
+  // can be vectorized
+  const double *distances = batch.distances;
+  for (std::size_t i = 0; i < batch.n; i++)
+    {
+      double distance = distances[i];
+      double pathLossDb = 10 * m_exponent * std::log10 (distance / m_referenceDistance);
+      double rxc = -m_referenceLoss - pathLossDb;
+      rxPowerDbm[i] = distance <= m_referenceDistance ? rxPowerDbm[i] - m_referenceLoss : rxPowerDbm[i] + rxc;
+    }
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeLogDistancePropagationLossModel);
@@ -642,6 +753,39 @@ ThreeLogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+ThreeLogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                                          double *rxPowerDbm) const
+{
+  // Same arithmetic as DoCalcRxPower: the loss accumulated up to the start
+  // of each field is summed in the same order, and each destination only
+  // selects its field, so that the loop can be vectorized.
+  const double base1 = m_referenceLoss;
+  const double base2 = m_referenceLoss
+    + 10 * m_exponent0 * std::log10 (m_distance1 / m_distance0);
+  const double base3 = base2
+    + 10 * m_exponent1 * std::log10 (m_distance2 / m_distance1);
+  const double *distances = batch.distances;
+  for (std::size_t i = 0; i < batch.n; i++)
+    {
+      double distance = distances[i];
+      NS_ASSERT (distance >= 0);
+      bool inFirst = distance < m_distance1;
+      bool inSecond = !inFirst && distance < m_distance2;
+      double base = inFirst ? base1 : (inSecond ? base2 : base3);
+      double exponent = inFirst ? m_exponent0 : (inSecond ? m_exponent1 : m_exponent2);
+      double start = inFirst ? m_distance0 : (inSecond ? m_distance1 : m_distance2);
+      double pathLossDb = base + 10 * exponent * std::log10 (distance / start);
+      rxPowerDbm[i] -= distance < m_distance0 ? 0 : pathLossDb;
+    }
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (NakagamiPropagationLossModel);
@@ -804,6 +948,12 @@ FixedRssLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+FixedRssLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (MatrixPropagationLossModel);
@@ -930,6 +1080,23 @@ RangePropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+RangePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
+void
+RangePropagationLossModel::DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                               double *rxPowerDbm) const
+{
+  const double *distances = batch.distances;
+  for (std::size_t i = 0; i < batch.n; i++)
+    {
+      rxPowerDbm[i] = distances[i] <= m_range ? rxPowerDbm[i] : -1000;
+    }
+}
+
 // ------------------------------------------------------------------------- //
 
 } // namespace ns3
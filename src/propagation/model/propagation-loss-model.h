@@ -27,6 +27,7 @@
 
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/vector.h"
 #include <map>
 
 namespace ns3 {
@@ -38,6 +39,25 @@ namespace ns3 {
 
 class MobilityModel;
 
+/**
+ * \ingroup propagation
+ *
+ * \brief The receivers of one transmission, for
+ * PropagationLossModel::CalcRxPowerBatch
+ *
+ * The receiver arrays all hold n entries.  The positions and distances
+ * must be those returned by the mobility models at the current time.
+ */
+struct PropagationLossBatch
+{
+  Ptr<MobilityModel> sender;               //!< the mobility model of the source
+  Vector senderPosition;                   //!< the position of the source
+  const Ptr<MobilityModel> *receivers;     //!< the mobility models of the destinations
+  const Vector *receiverPositions;         //!< the positions of the destinations
+  const double *distances;                 //!< the distances from the source to each destination (m)
+  std::size_t n;                           //!< the number of destinations
+};
+
 /**
  * \ingroup propagation
  *
@@ -93,6 +113,22 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Power from one source to many destinations, taking
+   * into account all the PropagationLossModel(s) chained to the current
+   * one.  Each model of the chain is applied to all the destinations
+   * before the next one, and the results are the same as those of
+   * CalcRxPower called for each destination in turn.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param batch the source and the destinations
+   * \param rxPowerDbm the reception power at each destination (in dBm),
+   *        written by this method
+   */
+  void CalcRxPowerBatch (double txPowerDbm,
+                         const PropagationLossBatch &batch,
+                         double *rxPowerDbm) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -106,6 +142,16 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * \returns true if the Rx Power returned by CalcRxPower only depends on
+   *          the transmission power and on the positions of the nodes, for
+   *          this model and all the models chained to it
+   *
+   * The results of such a chain can be memoized as long as the nodes do
+   * not move.
+   */
+  bool IsDeterministic (void) const;
+
 private:
   /**
    * \brief Copy constructor
@@ -134,12 +180,33 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
 
+  /**
+   * Applies only the particular PropagationLossModel to all the
+   * destinations of a batch.  The default calls DoCalcRxPower for each
+   * destination in turn; models which only depend on the positions
+   * override it with a loop over the distances.
+   *
+   * \param batch the source and the destinations
+   * \param rxPowerDbm the power at each destination (in dBm), updated in place
+   */
+  virtual void DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                   double *rxPowerDbm) const;
+
   /**
    * Subclasses must implement this; those not using random variables
    * can return zero
    */
   virtual int64_t DoAssignStreams (int64_t stream) = 0;
 
+  /**
+   * Subclasses which do not use random variables nor any state other than
+   * their attributes can return true; the default is false.
+   *
+   * \returns true if DoCalcRxPower only depends on the transmission power
+   *          and on the positions of the nodes
+   */
+  virtual bool DoIsDeterministic (void) const;
+
   Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -322,6 +389,9 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
+  virtual void DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                   double *rxPowerDbm) const;
 
   /**
    * Transforms a Dbm value to Watt
@@ -442,6 +512,9 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
+  virtual void DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                   double *rxPowerDbm) const;
 
   /**
    * Transforms a Dbm value to Watt
@@ -530,6 +603,9 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
+  virtual void DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                   double *rxPowerDbm) const;
 
   /**
    *  Creates a default reference loss model
@@ -613,6 +689,9 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
+  virtual void DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                   double *rxPowerDbm) const;
 
   double m_distance0; //!< Beginning of the first (near) distance field
   double m_distance1; //!< Beginning of the second (middle) distance field.
@@ -747,6 +826,7 @@ private:
                                 Ptr<MobilityModel> b) const;
 
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
   double m_rss; //!< the received signal strength
 };
 
@@ -852,6 +932,9 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
+  virtual void DoCalcRxPowerBatch (const PropagationLossBatch &batch,
+                                   double *rxPowerDbm) const;
 private:
   double m_range; //!< Maximum Transmission Range (meters)
 };
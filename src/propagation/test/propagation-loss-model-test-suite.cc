@@ -436,6 +436,97 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class PropagationLossBatchTestCase : public TestCase
+{
+public:
+  PropagationLossBatchTestCase ();
+  virtual ~PropagationLossBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Compare CalcRxPowerBatch with CalcRxPower over receivers around
+   * the distance thresholds of the models.
+   *
+   * \param batchModel the model evaluated in batch
+   * \param scalarModel the model evaluated one receiver at a time, a
+   *        copy of batchModel with the same random streams
+   * \param name the name of the model
+   */
+  void Compare (Ptr<PropagationLossModel> batchModel, Ptr<PropagationLossModel> scalarModel, std::string name);
+};
+
+PropagationLossBatchTestCase::PropagationLossBatchTestCase ()
+  : TestCase ("Check that CalcRxPowerBatch matches CalcRxPower")
+{
+}
+
+PropagationLossBatchTestCase::~PropagationLossBatchTestCase ()
+{
+}
+
+void
+PropagationLossBatchTestCase::Compare (Ptr<PropagationLossModel> batchModel, Ptr<PropagationLossModel> scalarModel,
+                                       std::string name)
+{
+  const double distances[] = {0, 0.5, 1, 1.5, 3, 50, 80, 100, 199.9, 200, 250, 350, 500, 800, 5000};
+  const uint32_t n = sizeof (distances) / sizeof (distances[0]);
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 1.5));
+  std::vector<Ptr<MobilityModel> > receivers;
+  std::vector<Vector> positions;
+  std::vector<double> rxDistances;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+      b->SetPosition (Vector (distances[i], 0, 1.5 + (i % 3)));
+      receivers.push_back (b);
+      positions.push_back (b->GetPosition ());
+      rxDistances.push_back (a->GetDistanceFrom (b));
+    }
+  PropagationLossBatch batch;
+  batch.sender = a;
+  batch.senderPosition = a->GetPosition ();
+  batch.receivers = &receivers[0];
+  batch.receiverPositions = &positions[0];
+  batch.distances = &rxDistances[0];
+  batch.n = n;
+  std::vector<double> rxPowerDbm (n);
+  batchModel->CalcRxPowerBatch (16.0206, batch, &rxPowerDbm[0]);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double expected = scalarModel->CalcRxPower (16.0206, a, receivers[i]);
+      NS_TEST_EXPECT_MSG_EQ (rxPowerDbm[i], expected, name << " differs at " << rxDistances[i] << "m");
+    }
+}
+
+void
+PropagationLossBatchTestCase::DoRun (void)
+{
+  Compare (CreateObject<FriisPropagationLossModel> (), CreateObject<FriisPropagationLossModel> (), "Friis");
+  Compare (CreateObject<TwoRayGroundPropagationLossModel> (), CreateObject<TwoRayGroundPropagationLossModel> (),
+           "TwoRayGround");
+  Compare (CreateObject<LogDistancePropagationLossModel> (), CreateObject<LogDistancePropagationLossModel> (),
+           "LogDistance");
+  Compare (CreateObject<ThreeLogDistancePropagationLossModel> (),
+           CreateObject<ThreeLogDistancePropagationLossModel> (), "ThreeLogDistance");
+  Compare (CreateObject<RangePropagationLossModel> (), CreateObject<RangePropagationLossModel> (), "Range");
+
+  // A chain with a random model, which falls back to DoCalcRxPower
+  Ptr<PropagationLossModel> chains[2];
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      chains[i] = CreateObject<LogDistancePropagationLossModel> ();
+      Ptr<PropagationLossModel> nakagami = CreateObject<NakagamiPropagationLossModel> ();
+      chains[i]->SetNext (nakagami);
+      nakagami->SetNext (CreateObject<RangePropagationLossModel> ());
+      chains[i]->AssignStreams (1);
+    }
+  Compare (chains[0], chains[1], "LogDistance+Nakagami+Range");
+  Simulator::Destroy ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +541,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new PropagationLossBatchTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -227,6 +227,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid ();
   NS_LOG_LOGIC ("txSpectrumModelUid " << txSpectrumModelUid);
 
+  m_rxBatch.clear ();
   //
   TxSpectrumModelInfoMap_t::const_iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
   NS_ASSERT (txInfoIteratorerator != m_txSpectrumModelInfoMap.end ());
@@ -332,20 +333,24 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                 {
                   // the receiver has a NetDevice, so we expect that it is attached to a Node
                   uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
+                  m_rxBatch.push_back (Simulator::ContextEvent (dstNode, delay,
+                                                                MakeEvent (&MultiModelSpectrumChannel::StartRx, this,
+                                                                           rxParams, *rxPhyIterator)));
                 }
               else
                 {
                   // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
+                  m_rxBatch.push_back (Simulator::ContextEvent (Simulator::GetContext (), delay,
+                                                                MakeEvent (&MultiModelSpectrumChannel::StartRx, this,
+                                                                           rxParams, *rxPhyIterator)));
                 }
             }
         }
 
     }
 
+  Simulator::ScheduleWithContextBatch (m_rxBatch);
+  m_rxBatch.clear ();
 }
 
 void
@@ -27,6 +27,7 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/simulator.h>
 #include <map>
 #include <set>
 
@@ -169,6 +170,11 @@ private:
    */
   std::size_t m_numDevices;
 
+  /**
+   * StartRx events of the signal being sent, scheduled in one batch.
+   */
+  Simulator::ContextEventBatch m_rxBatch;
+
 };
 
 
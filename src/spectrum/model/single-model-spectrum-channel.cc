@@ -106,6 +106,7 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
   Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility ();
 
+  m_rxBatch.clear ();
   for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
        rxPhyIterator != m_phyList.end ();
        ++rxPhyIterator)
@@ -175,16 +176,21 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
             {
               // the receiver has a NetDevice, so we expect that it is attached to a Node
               uint32_t dstNode =  netDev->GetNode ()->GetId ();
-              Simulator::ScheduleWithContext (dstNode, delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, *rxPhyIterator);
+              m_rxBatch.push_back (Simulator::ContextEvent (dstNode, delay,
+                                                            MakeEvent (&SingleModelSpectrumChannel::StartRx, this,
+                                                                       rxParams, *rxPhyIterator)));
             }
           else
             {
               // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-              Simulator::Schedule (delay, &SingleModelSpectrumChannel::StartRx, this,
-                                   rxParams, *rxPhyIterator);
+              m_rxBatch.push_back (Simulator::ContextEvent (Simulator::GetContext (), delay,
+                                                            MakeEvent (&SingleModelSpectrumChannel::StartRx, this,
+                                                                       rxParams, *rxPhyIterator)));
             }
         }
     }
+  Simulator::ScheduleWithContextBatch (m_rxBatch);
+  m_rxBatch.clear ();
 }
 
 void
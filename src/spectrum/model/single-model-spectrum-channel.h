@@ -25,6 +25,7 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-model.h>
 #include <ns3/traced-callback.h>
+#include <ns3/simulator.h>
 
 namespace ns3 {
 
@@ -82,6 +83,11 @@ private:
    */
   Ptr<const SpectrumModel> m_spectrumModel;
 
+  /**
+   * StartRx events of the signal being sent, scheduled in one batch.
+   */
+  Simulator::ContextEventBatch m_rxBatch;
+
 };
 
 }
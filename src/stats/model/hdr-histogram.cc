@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "hdr-histogram.h"
+#include "ns3/assert.h"
+#include <algorithm>
+
+namespace ns3 {
+
+HdrHistogram::HdrHistogram (uint8_t subBucketBits)
+  : m_subBucketBits (subBucketBits),
+    m_subBucketCount (1u << subBucketBits),
+    m_subBucketHalf (1u << (subBucketBits - 1)),
+    m_count (0),
+    m_sum (0),
+    m_min (0),
+    m_max (0)
+{
+  NS_ASSERT_MSG (subBucketBits >= 1 && subBucketBits <= 16, "HdrHistogram: subBucketBits out of range");
+}
+
+uint64_t
+HdrHistogram::GetHighestEquivalent (uint32_t index) const
+{
+  if (index < m_subBucketCount)
+    {
+      return index;
+    }
+  uint32_t shift = (index - m_subBucketCount) / m_subBucketHalf + 1;
+  uint64_t sub = (index - m_subBucketCount) % m_subBucketHalf + m_subBucketHalf;
+  return ((sub + 1) << shift) - 1;
+}
+
+uint64_t
+HdrHistogram::GetQuantile (double q) const
+{
+  if (m_count == 0)
+    {
+      return 0;
+    }
+  uint64_t rank = static_cast<uint64_t> (q * (m_count - 1)) + 1;
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < m_counts.size (); i++)
+    {
+      seen += m_counts[i];
+      if (seen >= rank)
+        {
+          return std::min (GetHighestEquivalent (i), m_max);
+        }
+    }
+  return m_max;
+}
+
+void
+HdrHistogram::Merge (const HdrHistogram &other)
+{
+  NS_ASSERT_MSG (other.m_subBucketBits == m_subBucketBits, "HdrHistogram: merging different layouts");
+  if (other.m_count == 0)
+    {
+      return;
+    }
+  if (other.m_counts.size () > m_counts.size ())
+    {
+      m_counts.resize (other.m_counts.size (), 0);
+    }
+  for (uint32_t i = 0; i < other.m_counts.size (); i++)
+    {
+      m_counts[i] += other.m_counts[i];
+    }
+  m_min = m_count == 0 ? other.m_min : std::min (m_min, other.m_min);
+  m_max = std::max (m_max, other.m_max);
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+}
+
+void
+HdrHistogram::Reset (void)
+{
+  m_counts.clear ();
+  m_count = 0;
+  m_sum = 0;
+  m_min = 0;
+  m_max = 0;
+}
+
+} // namespace ns3
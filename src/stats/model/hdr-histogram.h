@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef HDR_HISTOGRAM_H
+#define HDR_HISTOGRAM_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Log-linear histogram of non-negative integer values.
+ *
+ * Values below 2^subBucketBits get a bucket of their own.  Above that,
+ * every power of two range is split into 2^(subBucketBits-1) equal
+ * buckets, so the width of a bucket is at most 2^(1-subBucketBits) times
+ * the values it holds, whatever their magnitude.  Recording a value is a
+ * couple of shifts and an increment; quantiles are found by a single
+ * pass over the buckets, without keeping the samples.
+ *
+ * The bucket array grows on demand up to the largest recorded value, so
+ * an unused histogram costs no memory.
+ */
+class HdrHistogram
+{
+public:
+  /**
+   * \param subBucketBits log2 of the number of linear buckets, between 1 and 16
+   */
+  HdrHistogram (uint8_t subBucketBits = 7);
+
+  /**
+   * Add one value
+   * \param value the value
+   */
+  void Record (uint64_t value)
+  {
+    uint32_t index = GetIndex (value);
+    if (index >= m_counts.size ())
+      {
+        m_counts.resize (index + 1, 0);
+      }
+    m_counts[index]++;
+    if (m_count == 0 || value < m_min)
+      {
+        m_min = value;
+      }
+    if (value > m_max)
+      {
+        m_max = value;
+      }
+    m_count++;
+    m_sum += value;
+  }
+  /**
+   * Add the values of another histogram with the same number of sub buckets
+   * \param other the other histogram
+   */
+  void Merge (const HdrHistogram &other);
+  /// Remove all values
+  void Reset (void);
+
+  /// \return the number of values
+  uint64_t GetCount (void) const
+  {
+    return m_count;
+  }
+  /// \return the smallest value, 0 if empty
+  uint64_t GetMin (void) const
+  {
+    return m_min;
+  }
+  /// \return the largest value, 0 if empty
+  uint64_t GetMax (void) const
+  {
+    return m_max;
+  }
+  /// \return the mean value, 0 if empty
+  double GetMean (void) const
+  {
+    return m_count == 0 ? 0 : static_cast<double> (m_sum) / m_count;
+  }
+  /**
+   * \param q the quantile, in [0, 1]
+   * \return the highest value equivalent to the q quantile, within the
+   *         bucket resolution and never above GetMax, 0 if empty
+   */
+  uint64_t GetQuantile (double q) const;
+
+  /**
+   * \param value a value
+   * \return the index of the bucket holding the value
+   */
+  uint32_t GetIndex (uint64_t value) const
+  {
+    if (value < m_subBucketCount)
+      {
+        return static_cast<uint32_t> (value);
+      }
+    uint32_t msb = 63 - __builtin_clzll (value);
+    uint32_t shift = msb - m_subBucketBits + 1;
+    uint32_t sub = static_cast<uint32_t> (value >> shift);
+    return m_subBucketCount + (shift - 1) * m_subBucketHalf + (sub - m_subBucketHalf);
+  }
+  /**
+   * \param index a bucket index
+   * \return the largest value held by the bucket
+   */
+  uint64_t GetHighestEquivalent (uint32_t index) const;
+  /// \return the number of allocated buckets
+  uint32_t GetNBuckets (void) const
+  {
+    return m_counts.size ();
+  }
+
+private:
+  uint32_t m_subBucketBits;       //!< log2 of the number of linear buckets
+  uint32_t m_subBucketCount;      //!< 2^m_subBucketBits
+  uint32_t m_subBucketHalf;       //!< buckets per power of two above the linear range
+  std::vector<uint64_t> m_counts; //!< bucket counts
+  uint64_t m_count;               //!< number of values
+  uint64_t m_sum;                 //!< sum of the values
+  uint64_t m_min;                 //!< smallest value
+  uint64_t m_max;                 //!< largest value
+};
+
+} // namespace ns3
+
+#endif /* HDR_HISTOGRAM_H */
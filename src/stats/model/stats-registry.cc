@@ -0,0 +1,313 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "stats-registry.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("StatsRegistry");
+
+StatsHistogram::StatsHistogram (const std::string &name, double binWidth, uint32_t nBins)
+  : m_name (name),
+    m_binWidth (binWidth),
+    m_nBins (std::max<uint32_t> (nBins, 1))
+{
+  NS_ASSERT_MSG (binWidth > 0, "StatsHistogram " << name << ": bin width must be positive");
+}
+
+void
+StatsHistogram::Resize (uint32_t nNodes)
+{
+  m_bins.resize (nNodes * m_nBins, 0);
+  m_count.resize (nNodes, 0);
+  m_sum.resize (nNodes, 0);
+}
+
+uint64_t
+StatsHistogram::GetTotalCount (void) const
+{
+  uint64_t total = 0;
+  for (std::vector<uint64_t>::const_iterator i = m_count.begin (); i != m_count.end (); ++i)
+    {
+      total += *i;
+    }
+  return total;
+}
+
+double
+StatsHistogram::GetTotalSum (void) const
+{
+  double total = 0;
+  for (std::vector<double>::const_iterator i = m_sum.begin (); i != m_sum.end (); ++i)
+    {
+      total += *i;
+    }
+  return total;
+}
+
+std::vector<uint64_t>
+StatsHistogram::GetTotalBins (void) const
+{
+  std::vector<uint64_t> total (m_nBins, 0);
+  for (uint32_t i = 0; i < m_bins.size (); i++)
+    {
+      total[i % m_nBins] += m_bins[i];
+    }
+  return total;
+}
+
+double
+StatsHistogram::GetTotalQuantile (double q) const
+{
+  std::vector<uint64_t> bins = GetTotalBins ();
+  uint64_t count = GetTotalCount ();
+  if (count == 0)
+    {
+      return 0;
+    }
+  uint64_t rank = static_cast<uint64_t> (q * (count - 1)) + 1;
+  uint64_t seen = 0;
+  for (uint32_t b = 0; b < m_nBins; b++)
+    {
+      seen += bins[b];
+      if (seen >= rank)
+        {
+          return (b + 1) * m_binWidth;
+        }
+    }
+  return m_nBins * m_binWidth;
+}
+
+void
+StatsHistogram::Reset (void)
+{
+  std::fill (m_bins.begin (), m_bins.end (), 0);
+  std::fill (m_count.begin (), m_count.end (), 0);
+  std::fill (m_sum.begin (), m_sum.end (), 0);
+}
+
+StatsRegistry::StatsRegistry ()
+  : m_resetScheduled (false)
+{
+}
+
+void
+StatsRegistry::ScheduleResetOnDestroy (void)
+{
+  if (!m_resetScheduled)
+    {
+      m_resetScheduled = true;
+      Simulator::ScheduleDestroy (&StatsRegistry::ResetOnDestroy);
+    }
+}
+
+void
+StatsRegistry::ResetOnDestroy (void)
+{
+  StatsRegistry *reg = Get ();
+  reg->Reset ();
+  CriticalSection cs (reg->m_mutex);
+  reg->m_resetScheduled = false;
+}
+
+uint32_t
+StatsRegistry::RegisterCounter (const std::string &name)
+{
+  CriticalSection cs (m_mutex);
+  ScheduleResetOnDestroy ();
+  std::map<std::string, uint32_t>::const_iterator i = m_counterIds.find (name);
+  if (i != m_counterIds.end ())
+    {
+      return i->second;
+    }
+  NS_LOG_FUNCTION (this << name);
+  uint32_t id = m_counters.size ();
+  m_counterNames.push_back (name);
+  m_counters.push_back (std::vector<uint64_t> ());
+  m_counterIds[name] = id;
+  return id;
+}
+
+uint32_t
+StatsRegistry::RegisterHistogram (const std::string &name, double binWidth, uint32_t nBins)
+{
+  CriticalSection cs (m_mutex);
+  ScheduleResetOnDestroy ();
+  std::map<std::string, uint32_t>::const_iterator i = m_histogramIds.find (name);
+  if (i != m_histogramIds.end ())
+    {
+      return i->second;
+    }
+  NS_LOG_FUNCTION (this << name << binWidth << nBins);
+  uint32_t id = m_histograms.size ();
+  m_histograms.push_back (StatsHistogram (name, binWidth, nBins));
+  m_histogramIds[name] = id;
+  return id;
+}
+
+uint64_t
+StatsRegistry::GetCounterTotal (uint32_t id) const
+{
+  CriticalSection cs (m_mutex);
+  return DoGetCounterTotal (id);
+}
+
+uint64_t
+StatsRegistry::DoGetCounterTotal (uint32_t id) const
+{
+  uint64_t total = 0;
+  const std::vector<uint64_t> &values = m_counters[id];
+  for (std::vector<uint64_t>::const_iterator i = values.begin (); i != values.end (); ++i)
+    {
+      total += *i;
+    }
+  return total;
+}
+
+uint64_t
+StatsRegistry::GetCounterTotal (const std::string &name) const
+{
+  CriticalSection cs (m_mutex);
+  std::map<std::string, uint32_t>::const_iterator i = m_counterIds.find (name);
+  if (i == m_counterIds.end ())
+    {
+      return 0;
+    }
+  return DoGetCounterTotal (i->second);
+}
+
+const StatsHistogram *
+StatsRegistry::FindHistogram (const std::string &name) const
+{
+  CriticalSection cs (m_mutex);
+  std::map<std::string, uint32_t>::const_iterator i = m_histogramIds.find (name);
+  if (i == m_histogramIds.end ())
+    {
+      return 0;
+    }
+  return &m_histograms[i->second];
+}
+
+void
+StatsRegistry::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  for (std::vector<std::vector<uint64_t> >::iterator i = m_counters.begin (); i != m_counters.end (); ++i)
+    {
+      std::fill (i->begin (), i->end (), 0);
+    }
+  for (std::vector<StatsHistogram>::iterator i = m_histograms.begin (); i != m_histograms.end (); ++i)
+    {
+      i->Reset ();
+    }
+}
+
+/**
+ * Write bins separated by sep
+ * \param os the output stream
+ * \param bins the bins
+ * \param sep the separator
+ */
+static void
+WriteBins (std::ostream &os, const std::vector<uint64_t> &bins, char sep)
+{
+  for (uint32_t b = 0; b < bins.size (); b++)
+    {
+      if (b > 0)
+        {
+          os << sep;
+        }
+      os << bins[b];
+    }
+}
+
+void
+StatsRegistry::WriteCsv (std::ostream &os, bool perNode) const
+{
+  CriticalSection cs (m_mutex);
+  for (uint32_t id = 0; id < m_counters.size (); id++)
+    {
+      os << "counter," << m_counterNames[id] << ",all," << DoGetCounterTotal (id) << "\n";
+      for (uint32_t n = 0; perNode && n < m_counters[id].size (); n++)
+        {
+          os << "counter," << m_counterNames[id] << "," << n << "," << m_counters[id][n] << "\n";
+        }
+    }
+  for (std::vector<StatsHistogram>::const_iterator h = m_histograms.begin (); h != m_histograms.end (); ++h)
+    {
+      os << "histogram," << h->GetName () << ",all," << h->GetTotalCount () << "," << h->GetTotalSum ()
+         << "," << h->GetBinWidth () << ",";
+      WriteBins (os, h->GetTotalBins (), ';');
+      os << "\n";
+      for (uint32_t n = 0; perNode && n < h->GetNNodes (); n++)
+        {
+          std::vector<uint64_t> bins (h->GetNBins ());
+          for (uint32_t b = 0; b < bins.size (); b++)
+            {
+              bins[b] = h->GetBin (n, b);
+            }
+          os << "histogram," << h->GetName () << "," << n << "," << h->GetCount (n) << "," << h->GetSum (n)
+             << "," << h->GetBinWidth () << ",";
+          WriteBins (os, bins, ';');
+          os << "\n";
+        }
+    }
+}
+
+void
+StatsRegistry::WriteJson (std::ostream &os, bool perNode) const
+{
+  CriticalSection cs (m_mutex);
+  os << "{\"counters\":{";
+  for (uint32_t id = 0; id < m_counters.size (); id++)
+    {
+      os << (id > 0 ? "," : "") << "\"" << m_counterNames[id] << "\":{\"total\":" << DoGetCounterTotal (id);
+      if (perNode)
+        {
+          os << ",\"nodes\":[";
+          WriteBins (os, m_counters[id], ',');
+          os << "]";
+        }
+      os << "}";
+    }
+  os << "},\"histograms\":{";
+  for (uint32_t id = 0; id < m_histograms.size (); id++)
+    {
+      const StatsHistogram &h = m_histograms[id];
+      os << (id > 0 ? "," : "") << "\"" << h.GetName () << "\":{\"binWidth\":" << h.GetBinWidth ()
+         << ",\"count\":" << h.GetTotalCount () << ",\"sum\":" << h.GetTotalSum () << ",\"bins\":[";
+      WriteBins (os, h.GetTotalBins (), ',');
+      os << "]";
+      if (perNode)
+        {
+          os << ",\"nodes\":[";
+          for (uint32_t n = 0; n < h.GetNNodes (); n++)
+            {
+              os << (n > 0 ? "," : "") << "{\"count\":" << h.GetCount (n) << ",\"sum\":" << h.GetSum (n) << "}";
+            }
+          os << "]";
+        }
+      os << "}";
+    }
+  os << "}}\n";
+}
+
+} // namespace ns3
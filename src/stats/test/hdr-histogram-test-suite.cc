@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/hdr-histogram.h"
+
+using namespace ns3;
+
+// ===========================================================================
+// Bucket layout, quantiles and merging of the log-linear histogram.
+// ===========================================================================
+
+class HdrHistogramTestCase : public TestCase
+{
+public:
+  HdrHistogramTestCase ();
+  virtual ~HdrHistogramTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+HdrHistogramTestCase::HdrHistogramTestCase ()
+  : TestCase ("HDR histogram buckets and quantiles")
+{
+}
+
+HdrHistogramTestCase::~HdrHistogramTestCase ()
+{
+}
+
+void
+HdrHistogramTestCase::DoRun (void)
+{
+  HdrHistogram h (5);
+  NS_TEST_ASSERT_MSG_EQ (h.GetQuantile (0.5), 0, "empty histogram");
+  NS_TEST_ASSERT_MSG_EQ (h.GetNBuckets (), 0, "no buckets before the first value");
+
+  // Every value falls in the bucket whose range it belongs to, and the
+  // buckets are contiguous.
+  for (uint64_t v = 0; v < 100000; v++)
+    {
+      uint32_t i = h.GetIndex (v);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (h.GetHighestEquivalent (i), v, "value above its bucket");
+      NS_TEST_ASSERT_MSG_EQ ((i == 0 || h.GetHighestEquivalent (i - 1) < v), true, "value below its bucket");
+    }
+  NS_TEST_ASSERT_MSG_EQ (h.GetIndex (31), 31, "linear range");
+  NS_TEST_ASSERT_MSG_EQ (h.GetIndex (32), 32, "first log bucket");
+  NS_TEST_ASSERT_MSG_EQ (h.GetIndex (33), 32, "two values per bucket above 32");
+  NS_TEST_ASSERT_MSG_EQ (h.GetHighestEquivalent (h.GetIndex (1000000)), 1015807, "bucket width 2^15 at 1e6");
+
+  for (uint64_t v = 1; v <= 10000; v++)
+    {
+      h.Record (v);
+    }
+  NS_TEST_ASSERT_MSG_EQ (h.GetCount (), 10000, "count");
+  NS_TEST_ASSERT_MSG_EQ (h.GetMin (), 1, "min");
+  NS_TEST_ASSERT_MSG_EQ (h.GetMax (), 10000, "max");
+  NS_TEST_ASSERT_MSG_EQ_TOL (h.GetMean (), 5000.5, 1e-9, "mean");
+  NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (h.GetQuantile (0.5)), 5000, 5000.0 / 16, "median");
+  NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (h.GetQuantile (0.99)), 9900, 9900.0 / 16, "p99");
+  NS_TEST_ASSERT_MSG_EQ (h.GetQuantile (1), 10000, "p100 is the max");
+  NS_TEST_ASSERT_MSG_EQ (h.GetQuantile (0), 1, "p0 is the min");
+
+  HdrHistogram tail (5);
+  tail.Record (1000000);
+  h.Merge (tail);
+  NS_TEST_ASSERT_MSG_EQ (h.GetCount (), 10001, "merged count");
+  NS_TEST_ASSERT_MSG_EQ (h.GetMax (), 1000000, "merged max");
+  NS_TEST_ASSERT_MSG_EQ (h.GetQuantile (1), 1000000, "merged tail");
+
+  h.Reset ();
+  NS_TEST_ASSERT_MSG_EQ (h.GetCount (), 0, "reset");
+  NS_TEST_ASSERT_MSG_EQ (h.GetQuantile (0.99), 0, "reset quantile");
+}
+
+class HdrHistogramTestSuite : public TestSuite
+{
+public:
+  HdrHistogramTestSuite ();
+};
+
+HdrHistogramTestSuite::HdrHistogramTestSuite ()
+  : TestSuite ("stats-hdr-histogram", UNIT)
+{
+  AddTestCase (new HdrHistogramTestCase, TestCase::QUICK);
+}
+
+static HdrHistogramTestSuite hdrHistogramTestSuite;
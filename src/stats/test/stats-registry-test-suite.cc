@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+
+#include "ns3/test.h"
+#include "ns3/stats-registry.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+const double TOLERANCE = 1e-12;
+
+// ===========================================================================
+// Counters and histograms registered by name, updated per node.
+// ===========================================================================
+
+class StatsRegistryTestCase : public TestCase
+{
+public:
+  StatsRegistryTestCase ();
+  virtual ~StatsRegistryTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+StatsRegistryTestCase::StatsRegistryTestCase ()
+  : TestCase ("Stats registry counters, histograms and export")
+{
+}
+
+StatsRegistryTestCase::~StatsRegistryTestCase ()
+{
+}
+
+void
+StatsRegistryTestCase::DoRun (void)
+{
+  StatsRegistry *reg = StatsRegistry::Get ();
+  uint32_t a = reg->RegisterCounter ("test.registry.a");
+  uint32_t b = reg->RegisterCounter ("test.registry.b");
+  NS_TEST_ASSERT_MSG_EQ (reg->RegisterCounter ("test.registry.a"), a, "registering twice returns the same id");
+  NS_TEST_ASSERT_MSG_NE (a, b, "distinct counters");
+  reg->Reset ();
+
+  reg->Add (a, 0);
+  reg->Add (a, 7, 5);
+  reg->Add (a, 7);
+  reg->Add (b, 3, 2);
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounter (a, 7), 6, "per node value");
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounter (a, 100), 0, "unused node slot");
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounterValues (a).size (), 8, "contiguous array up to the highest node");
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounterTotal (a), 7, "total");
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounterTotal ("test.registry.b"), 2, "total by name");
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounterTotal ("test.registry.none"), 0, "unknown name");
+
+  uint32_t h = reg->RegisterHistogram ("test.registry.h", 0.1, 10);
+  reg->Record (h, 0, 0.05);
+  reg->Record (h, 0, 0.15);
+  reg->Record (h, 2, 0.25);
+  reg->Record (h, 2, 5.0);
+  const StatsHistogram &hist = reg->GetHistogram (h);
+  NS_TEST_ASSERT_MSG_EQ (hist.GetCount (0), 2, "node 0 count");
+  NS_TEST_ASSERT_MSG_EQ (hist.GetTotalCount (), 4, "total count");
+  NS_TEST_ASSERT_MSG_EQ_TOL (hist.GetTotalSum (), 5.45, TOLERANCE, "total sum");
+  NS_TEST_ASSERT_MSG_EQ (hist.GetBin (2, 9), 1, "overflow goes to the last bin");
+  NS_TEST_ASSERT_MSG_EQ_TOL (hist.GetTotalQuantile (0.5), 0.2, TOLERANCE, "median bin");
+  NS_TEST_ASSERT_MSG_EQ (reg->FindHistogram ("test.registry.h"), &hist, "lookup by name");
+
+  std::ostringstream csv;
+  reg->WriteCsv (csv, true);
+  NS_TEST_ASSERT_MSG_NE (csv.str ().find ("counter,test.registry.a,all,7\n"), std::string::npos, "CSV total");
+  NS_TEST_ASSERT_MSG_NE (csv.str ().find ("counter,test.registry.a,7,6\n"), std::string::npos, "CSV node row");
+  NS_TEST_ASSERT_MSG_NE (csv.str ().find ("histogram,test.registry.h,all,4,5.45,0.1,1;1;1;0;0;0;0;0;0;1\n"),
+                         std::string::npos, "CSV histogram");
+  std::ostringstream json;
+  reg->WriteJson (json);
+  NS_TEST_ASSERT_MSG_NE (json.str ().find ("\"test.registry.b\":{\"total\":2}"), std::string::npos, "JSON counter");
+
+  reg->Reset ();
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounterTotal (a), 0, "reset clears values");
+  NS_TEST_ASSERT_MSG_EQ (reg->RegisterCounter ("test.registry.a"), a, "reset keeps ids");
+  NS_TEST_ASSERT_MSG_EQ (hist.GetTotalCount (), 0, "reset clears histograms");
+
+  reg->Add (a, 1);
+  reg->Record (h, 1, 0.5);
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounterTotal (a), 0, "Simulator::Destroy clears values");
+  NS_TEST_ASSERT_MSG_EQ (hist.GetTotalCount (), 0, "Simulator::Destroy clears histograms");
+
+  NS_TEST_ASSERT_MSG_EQ (reg->RegisterCounter ("test.registry.a"), a, "ids survive Simulator::Destroy");
+  reg->Add (a, 1);
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (reg->GetCounterTotal (a), 0, "registering again clears at the next Simulator::Destroy");
+}
+
+class StatsRegistryTestSuite : public TestSuite
+{
+public:
+  StatsRegistryTestSuite ();
+};
+
+StatsRegistryTestSuite::StatsRegistryTestSuite ()
+  : TestSuite ("stats-registry", UNIT)
+{
+  AddTestCase (new StatsRegistryTestCase, TestCase::QUICK);
+}
+
+static StatsRegistryTestSuite statsRegistryTestSuite;
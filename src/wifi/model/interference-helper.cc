@@ -26,6 +26,7 @@
 #include "wifi-phy.h"
 #include "error-rate-model.h"
 #include "wifi-utils.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -90,12 +91,19 @@ Event::GetPayloadMode (void) const
  *       short period of time.
  ****************************************************************/
 
-InterferenceHelper::NiChange::NiChange (double power, Ptr<Event> event)
-  : m_power (power),
+InterferenceHelper::NiChange::NiChange (Time moment, double power, Ptr<Event> event)
+  : m_moment (moment),
+    m_power (power),
     m_event (event)
 {
 }
 
+Time
+InterferenceHelper::NiChange::GetMoment (void) const
+{
+  return m_moment;
+}
+
 double
 InterferenceHelper::NiChange::GetPower (void) const
 {
@@ -122,11 +130,12 @@ InterferenceHelper::NiChange::GetEvent (void) const
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_numRxAntennas (1),
+    m_niFirst (0),
     m_firstPower (0),
     m_rxing (false)
 {
   // Always have a zero power noise event in the list
-  AddNiChangeEvent (Time (0), NiChange (0.0, 0));
+  m_niChanges.push_back (NiChange (Time (0), 0.0, 0));
 }
 
 InterferenceHelper::~InterferenceHelper ()
@@ -181,12 +190,12 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW) const
 {
   Time now = Simulator::Now ();
-  auto i = GetPreviousPosition (now);
-  Time end = i->first;
+  auto i = m_niChanges.begin () + GetPreviousPosition (now);
+  Time end = i->GetMoment ();
   for (; i != m_niChanges.end (); ++i)
     {
-      double noiseInterferenceW = i->second.GetPower ();
-      end = i->first;
+      double noiseInterferenceW = i->GetPower ();
+      end = i->GetMoment ();
       if (noiseInterferenceW < energyW)
         {
           break;
@@ -201,21 +210,20 @@ InterferenceHelper::AppendEvent (Ptr<Event> event)
   NS_LOG_FUNCTION (this);
   double previousPowerStart = 0;
   double previousPowerEnd = 0;
-  previousPowerStart = GetPreviousPosition (event->GetStartTime ())->second.GetPower ();
-  previousPowerEnd = GetPreviousPosition (event->GetEndTime ())->second.GetPower ();
+  previousPowerStart = m_niChanges[GetPreviousPosition (event->GetStartTime ())].GetPower ();
+  previousPowerEnd = m_niChanges[GetPreviousPosition (event->GetEndTime ())].GetPower ();
 
   if (!m_rxing)
     {
       m_firstPower = previousPowerStart;
-      // Always leave the first zero power noise event in the list
-      m_niChanges.erase (++(m_niChanges.begin ()),
-                         GetNextPosition (event->GetStartTime ()));
+      EraseNiChanges (GetNextPosition (event->GetStartTime ()));
     }
-  auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
-  auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  std::size_t first = AddNiChangeEvent (NiChange (event->GetStartTime (), previousPowerStart, event));
+  std::size_t last = AddNiChangeEvent (NiChange (event->GetEndTime (), previousPowerEnd, event));
+  double rxPowerW = event->GetRxPowerW ();
+  for (std::size_t i = first; i != last; ++i)
     {
-      i->second.AddPower (event->GetRxPowerW ());
+      m_niChanges[i].AddPower (rxPowerW);
     }
 }
 
@@ -235,22 +243,26 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint1
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiRange *ni) const
 {
   double noiseInterferenceW = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->first < Simulator::Now (); ++it)
+  std::size_t start = GetPosition (event->GetStartTime ());
+  // The power is that of the last change before now, if the event had
+  // started by then.
+  std::size_t now = GetPosition (Simulator::Now ());
+  if (now > start)
     {
-      noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
+      noiseInterferenceW = m_niChanges[now - 1].GetPower () - event->GetRxPowerW ();
     }
-  it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it);
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
-  while (++it != m_niChanges.end () && it->second.GetEvent () != event)
-    {
-      ni->insert (*it);
-    }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
+  // An event owns exactly two changes, at its start and end times; the
+  // changes in between are those it overlaps.
+  for (; start != m_niChanges.size () && m_niChanges[start].GetEvent () != event; ++start);
+  NS_ASSERT (start != m_niChanges.size ());
+  std::size_t end = std::max (GetPosition (event->GetEndTime ()), start + 1);
+  for (; end != m_niChanges.size () && m_niChanges[end].GetEvent () != event; ++end);
+  NS_ASSERT (end != m_niChanges.size ());
+  ni->first = start;
+  ni->second = end;
   NS_ASSERT_MSG (noiseInterferenceW >= 0, "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
   return noiseInterferenceW;
 }
@@ -278,16 +290,17 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 }
 
 double
-InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni, std::pair<Time, Time> window) const
+InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiRange ni, std::pair<Time, Time> window) const
 {
   NS_LOG_FUNCTION (this << window.first << window.second);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  auto j = ni->begin ();
-  Time previous = j->first;
+  auto j = m_niChanges.begin () + ni.first;
+  auto niEnd = m_niChanges.begin () + ni.second + 1;
+  Time previous = j->GetMoment ();
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = txVector.GetPreambleType ();
-  Time plcpHeaderStart = j->first + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
+  Time plcpHeaderStart = j->GetMoment () + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
@@ -295,9 +308,9 @@ InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni,
   Time windowEnd = plcpPayloadStart + window.second;
   double noiseInterferenceW = m_firstPower;
   double powerW = event->GetRxPowerW ();
-  while (++j != ni->end ())
+  while (++j != niEnd)
     {
-      Time current = j->first;
+      Time current = j->GetMoment ();
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       //Case 1: Both previous and current point to the windowed payload
@@ -320,8 +333,8 @@ InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni,
                                             payloadMode, txVector);
           NS_LOG_DEBUG ("previous is before windowed payload and current is in the windowed payload: mode=" << payloadMode << ", psr=" << psr);
         }
-      noiseInterferenceW = j->second.GetPower () - powerW;
-      previous = j->first;
+      noiseInterferenceW = j->GetPower () - powerW;
+      previous = j->GetMoment ();
       if (previous > windowEnd)
         {
           NS_LOG_DEBUG ("Stop: new previous=" << previous << " after time window end=" << windowEnd);
@@ -334,24 +347,25 @@ InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni,
 }
 
 double
-InterferenceHelper::CalculateLegacyPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateLegacyPhyHeaderPer (Ptr<const Event> event, NiRange ni) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  auto j = ni->begin ();
-  Time previous = j->first;
+  auto j = m_niChanges.begin () + ni.first;
+  auto niEnd = m_niChanges.begin () + ni.second + 1;
+  Time previous = j->GetMoment ();
   WifiPreamble preamble = txVector.GetPreambleType ();
   WifiMode headerMode = WifiPhy::GetPlcpHeaderMode (txVector);
-  Time plcpHeaderStart = j->first + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
+  Time plcpHeaderStart = j->GetMoment () + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
   double noiseInterferenceW = m_firstPower;
   double powerW = event->GetRxPowerW ();
-  while (++j != ni->end ())
+  while (++j != niEnd)
     {
-      Time current = j->first;
+      Time current = j->GetMoment ();
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       //Case 1: previous and current after playload start
@@ -469,8 +483,8 @@ InterferenceHelper::CalculateLegacyPhyHeaderPer (Ptr<const Event> event, NiChang
             }
         }
 
-      noiseInterferenceW = j->second.GetPower () - powerW;
-      previous = j->first;
+      noiseInterferenceW = j->GetPower () - powerW;
+      previous = j->GetMoment ();
     }
 
   double per = 1 - psr;
@@ -478,13 +492,14 @@ InterferenceHelper::CalculateLegacyPhyHeaderPer (Ptr<const Event> event, NiChang
 }
 
 double
-InterferenceHelper::CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiRange ni) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  auto j = ni->begin ();
-  Time previous = j->first;
+  auto j = m_niChanges.begin () + ni.first;
+  auto niEnd = m_niChanges.begin () + ni.second + 1;
+  Time previous = j->GetMoment ();
   WifiPreamble preamble = txVector.GetPreambleType ();
   WifiMode mcsHeaderMode;
   if (preamble == WIFI_PREAMBLE_HT_MF || preamble == WIFI_PREAMBLE_HT_GF)
@@ -503,15 +518,15 @@ InterferenceHelper::CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiCh
       mcsHeaderMode = WifiPhy::GetHePlcpHeaderMode ();
     }
   WifiMode headerMode = WifiPhy::GetPlcpHeaderMode (txVector);
-  Time plcpHeaderStart = j->first + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
+  Time plcpHeaderStart = j->GetMoment () + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
   double noiseInterferenceW = m_firstPower;
   double powerW = event->GetRxPowerW ();
-  while (++j != ni->end ())
+  while (++j != niEnd)
     {
-      Time current = j->first;
+      Time current = j->GetMoment ();
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       //Case 1: previous and current after playload start: nothing to do
@@ -838,8 +853,8 @@ InterferenceHelper::CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiCh
             }
         }
 
-      noiseInterferenceW = j->second.GetPower () - powerW;
-      previous = j->first;
+      noiseInterferenceW = j->GetPower () - powerW;
+      previous = j->GetMoment ();
     }
 
   double per = 1 - psr;
@@ -849,7 +864,7 @@ InterferenceHelper::CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiCh
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Time> relativeMpduStartStop) const
 {
-  NiChanges ni;
+  NiRange ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -858,7 +873,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Ti
   /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePayloadPer (event, &ni, relativeMpduStartStop);
+  double per = CalculatePayloadPer (event, ni, relativeMpduStartStop);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -869,7 +884,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Ti
 double
 InterferenceHelper::CalculateSnr (Ptr<Event> event) const
 {
-  NiChanges ni;
+  NiRange ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -880,7 +895,7 @@ InterferenceHelper::CalculateSnr (Ptr<Event> event) const
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculateLegacyPhyHeaderSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
+  NiRange ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -889,7 +904,7 @@ InterferenceHelper::CalculateLegacyPhyHeaderSnrPer (Ptr<Event> event) const
   /* calculate the SNIR at the start of the plcp header and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculateLegacyPhyHeaderPer (event, &ni);
+  double per = CalculateLegacyPhyHeaderPer (event, ni);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -900,7 +915,7 @@ InterferenceHelper::CalculateLegacyPhyHeaderSnrPer (Ptr<Event> event) const
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculateNonLegacyPhyHeaderSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
+  NiRange ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -909,7 +924,7 @@ InterferenceHelper::CalculateNonLegacyPhyHeaderSnrPer (Ptr<Event> event) const
   /* calculate the SNIR at the start of the plcp header and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculateNonLegacyPhyHeaderPer (event, &ni);
+  double per = CalculateNonLegacyPhyHeaderPer (event, ni);
   
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -922,31 +937,95 @@ InterferenceHelper::EraseEvents (void)
 {
   m_niChanges.clear ();
   // Always have a zero power noise event in the list
-  AddNiChangeEvent (Time (0), NiChange (0.0, 0));
+  m_niChanges.push_back (NiChange (Time (0), 0.0, 0));
+  m_niFirst = 0;
   m_rxing = false;
   m_firstPower = 0;
 }
 
-InterferenceHelper::NiChanges::const_iterator
+namespace {
+
+/**
+ * Order a time before a NiChange.
+ *
+ * \param moment the time
+ * \param change the NiChange
+ * \returns true if moment is earlier than the change
+ */
+template <typename T>
+bool
+IsBefore (Time moment, const T &change)
+{
+  return moment < change.GetMoment ();
+}
+
+/**
+ * Order a NiChange before a time.
+ *
+ * \param change the NiChange
+ * \param moment the time
+ * \returns true if the change is earlier than moment
+ */
+template <typename T>
+bool
+IsAfter (const T &change, Time moment)
+{
+  return change.GetMoment () < moment;
+}
+
+} // unnamed namespace
+
+std::size_t
 InterferenceHelper::GetNextPosition (Time moment) const
 {
-  return m_niChanges.upper_bound (moment);
+  return std::upper_bound (m_niChanges.begin () + m_niFirst, m_niChanges.end (),
+                           moment, IsBefore<NiChange>) - m_niChanges.begin ();
+}
+
+std::size_t
+InterferenceHelper::GetPosition (Time moment) const
+{
+  return std::lower_bound (m_niChanges.begin () + m_niFirst, m_niChanges.end (),
+                           moment, IsAfter<NiChange>) - m_niChanges.begin ();
 }
 
-InterferenceHelper::NiChanges::const_iterator
+std::size_t
 InterferenceHelper::GetPreviousPosition (Time moment) const
 {
-  auto it = GetNextPosition (moment);
   // This is safe since there is always an NiChange at time 0,
   // before moment.
-  --it;
-  return it;
+  return GetNextPosition (moment) - 1;
 }
 
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change)
+std::size_t
+InterferenceHelper::AddNiChangeEvent (NiChange change)
 {
-  return m_niChanges.insert (GetNextPosition (moment), std::make_pair (moment, change));
+  std::size_t position = GetNextPosition (change.GetMoment ());
+  m_niChanges.insert (m_niChanges.begin () + position, change);
+  return position;
+}
+
+void
+InterferenceHelper::EraseNiChanges (std::size_t index)
+{
+  if (index <= m_niFirst + 1)
+    {
+      return;
+    }
+  // Rather than shifting the whole list, move the zero power noise event
+  // just before the first change to keep, releasing the dropped events.
+  // The stale head is reclaimed once it outgrows the live part.
+  for (std::size_t i = m_niFirst; i != index - 1; ++i)
+    {
+      m_niChanges[i] = NiChange (Time (0), 0.0, 0);
+    }
+  m_niFirst = index - 1;
+  m_niChanges[m_niFirst] = NiChange (Time (0), 0.0, 0);
+  if (m_niFirst > m_niChanges.size () / 2)
+    {
+      m_niChanges.erase (m_niChanges.begin (), m_niChanges.begin () + m_niFirst);
+      m_niFirst = 0;
+    }
 }
 
 void
@@ -962,9 +1041,9 @@ InterferenceHelper::NotifyRxEnd ()
   NS_LOG_FUNCTION (this);
   m_rxing = false;
   //Update m_firstPower for frame capture
-  auto it = m_niChanges.find (Simulator::Now ());
-  it--;
-  m_firstPower = it->second.GetPower ();
+  std::size_t it = GetPosition (Simulator::Now ());
+  NS_ASSERT (it > m_niFirst);
+  m_firstPower = m_niChanges[it - 1].GetPower ();
 }
 
 } //namespace ns3
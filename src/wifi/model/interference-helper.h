@@ -23,7 +23,7 @@
 
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
-#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -235,10 +235,17 @@ public:
     /**
      * Create a NiChange at the given time and the amount of NI change.
      *
+     * \param moment the time of the change
      * \param power the power
      * \param event causes this NI change
      */
-    NiChange (double power, Ptr<Event> event);
+    NiChange (Time moment, double power, Ptr<Event> event);
+    /**
+     * Return the time of the change
+     *
+     * \return the time of the change
+     */
+    Time GetMoment (void) const;
     /**
      * Return the power
      *
@@ -260,14 +267,19 @@ public:
 
 
 private:
+    Time m_moment; ///< time of the change
     double m_power; ///< power
     Ptr<Event> m_event; ///< event
   };
 
   /**
-   * typedef for a multimap of NiChanges
+   * typedef for a time-sorted vector of NiChanges
+   */
+  typedef std::vector<NiChange> NiChanges;
+  /**
+   * Indexes in m_niChanges of the first and last NiChanges of an event
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  typedef std::pair<std::size_t, std::size_t> NiRange;
 
   /**
    * Append the given Event.
@@ -279,11 +291,11 @@ private:
    * Calculate noise and interference power in W.
    *
    * \param event
-   * \param ni
+   * \param ni the NI changes spanning the event
    *
    * \return noise and interference power
    */
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event, NiRange *ni) const;
   /**
    * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
    *
@@ -312,72 +324,85 @@ private:
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param ni the NI changes spanning the event
    * \param window time window (pair of start and end times) of PLCP payload to focus on
    *
    * \return the error rate of the payload
    */
-  double CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni, std::pair<Time, Time> window) const;
+  double CalculatePayloadPer (Ptr<const Event> event, NiRange ni, std::pair<Time, Time> window) const;
   /**
    * Calculate the error rate of the legacy PHY header. The legacy PHY header
    * can be divided into multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param ni the NI changes spanning the event
    *
    * \return the error rate of the legacy PHY header
    */
-  double CalculateLegacyPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculateLegacyPhyHeaderPer (Ptr<const Event> event, NiRange ni) const;
   /**
    * Calculate the error rate of the non-legacy PHY header. The non-legacy PHY header
    * can be divided into multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param ni the NI changes spanning the event
    *
    * \return the error rate of the non-legacy PHY header
    */
-  double CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiRange ni) const;
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel; ///< error rate model
   uint8_t m_numRxAntennas; /**< the number of RX antennas in the corresponding receiver */
-  /// Experimental: needed for energy duration calculation
+  /**
+   * Experimental: needed for energy duration calculation.
+   * The NI changes are kept sorted by time in a flat vector, and each
+   * of them holds the total power from that time on, so that looking up
+   * the power at a given time is a binary search.  Changes before
+   * m_niFirst are stale and are dropped in bulk.
+   */
   NiChanges m_niChanges;
+  std::size_t m_niFirst; ///< index of the first live NiChange, the zero power noise event
   double m_firstPower; ///< first power
   bool m_rxing; ///< flag whether it is in receiving state
 
   /**
-   * Returns an iterator to the first nichange that is later than moment
+   * Returns the index of the first nichange that is later than moment
    *
    * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
+   * \returns an index in the list of NiChanges
    */
-  NiChanges::const_iterator GetNextPosition (Time moment) const;
+  std::size_t GetNextPosition (Time moment) const;
   /**
-   * Returns an iterator to the first nichange that is later than moment
+   * Returns the index of the first nichange that is not earlier than moment
    *
    * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
+   * \returns an index in the list of NiChanges
    */
-  //NiChanges::iterator GetNextPosition (Time moment);
+  std::size_t GetPosition (Time moment) const;
   /**
-   * Returns an iterator to the last nichange that is before than moment
+   * Returns the index of the last nichange that is not later than moment
    *
    * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
+   * \returns an index in the list of NiChanges
    */
-  NiChanges::const_iterator GetPreviousPosition (Time moment) const;
+  std::size_t GetPreviousPosition (Time moment) const;
 
   /**
    * Add NiChange to the list at the appropriate position and
-   * return the iterator of the new event.
+   * return the index of the new event.
    *
-   * \param moment
    * \param change
-   * \returns the iterator of the new event
+   * \returns the index of the new event
+   */
+  std::size_t AddNiChangeEvent (NiChange change);
+  /**
+   * Drop the NiChanges before the given index, keeping the zero power
+   * noise event first in the list.
+   *
+   * \param index the index of the first NiChange to keep
    */
-  NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change);
+  void EraseNiChanges (std::size_t index);
 };
 
 } //namespace ns3
@@ -239,8 +239,7 @@ SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
     }
 
   NS_LOG_INFO ("Received Wi-Fi signal");
-  Ptr<Packet> packet = wifiRxParams->packet->Copy ();
-  StartReceivePreamble (packet, rxPowerW, rxDuration);
+  StartReceivePreamble (wifiRxParams->packet, rxPowerW, rxDuration);
 }
 
 Ptr<AntennaModel>
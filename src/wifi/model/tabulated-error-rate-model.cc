@@ -0,0 +1,317 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/object-factory.h"
+#include "tabulated-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "wifi-tx-vector.h"
+#include <cmath>
+#include <map>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TabulatedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TabulatedErrorRateModel);
+
+namespace {
+
+/// The lowest SNR of the grid, in dB
+const double MIN_SNR_DB = -20;
+/// The highest SNR of the grid, in dB
+const double MAX_SNR_DB = 60;
+/// The initial grid step, in dB
+const double INITIAL_STEP_DB = 0.1;
+/// The smallest grid step, in dB
+const double MIN_STEP_DB = 0.001;
+/// log (-log (q)) when q is 1, i.e., when no bit error can happen
+const double MIN_VALUE = -800;
+/// log (-log (q)) when q is 0, i.e., when all bits are in error
+const double MAX_VALUE = std::log (1000.0);
+/// The success rate below which q rather than log (-log (q)) is interpolated
+const double MAX_INTERPOLATED_RATE = 0.5;
+
+} // unnamed namespace
+
+TypeId
+TabulatedErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TabulatedErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<TabulatedErrorRateModel> ()
+    .AddAttribute ("Model",
+                   "The analytic error rate model to tabulate.",
+                   TypeIdValue (NistErrorRateModel::GetTypeId ()),
+                   MakeTypeIdAccessor (&TabulatedErrorRateModel::m_modelTypeId),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("Epsilon",
+                   "The largest difference allowed between a chunk success rate "
+                   "and the one of the analytic model.",
+                   DoubleValue (1e-5),
+                   MakeDoubleAccessor (&TabulatedErrorRateModel::m_epsilon),
+                   MakeDoubleChecker<double> (0))
+  ;
+  return tid;
+}
+
+TabulatedErrorRateModel::TabulatedErrorRateModel ()
+  : m_lastTable (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TabulatedErrorRateModel::~TabulatedErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TabulatedErrorRateModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_model = 0;
+  ErrorRateModel::DoDispose ();
+}
+
+Ptr<ErrorRateModel>
+TabulatedErrorRateModel::GetAnalyticModel (void) const
+{
+  if (m_model == 0)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (m_modelTypeId);
+      m_model = factory.Create<ErrorRateModel> ();
+    }
+  return m_model;
+}
+
+bool
+TabulatedErrorRateModel::IsTabulated (WifiMode mode)
+{
+  return mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
+         || mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
+         || mode.GetModulationClass () == WIFI_MOD_CLASS_HT
+         || mode.GetModulationClass () == WIFI_MOD_CLASS_VHT
+         || mode.GetModulationClass () == WIFI_MOD_CLASS_HE;
+}
+
+double
+TabulatedErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << snr << nbits);
+  if (!IsTabulated (mode) || snr <= 0)
+    {
+      return GetAnalyticModel ()->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  const Table &table = GetTable (mode, txVector);
+  double position = (10 * std::log10 (snr) - table.start) / table.step;
+  if (position < 0 || position >= table.values.size () - 1)
+    {
+      return GetAnalyticModel ()->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  std::size_t index = static_cast<std::size_t> (position);
+  double fraction = position - index;
+  if (table.rates[index] < MAX_INTERPOLATED_RATE)
+    {
+      // q is smooth down to zero at the start of the grid
+      double q = Interpolate (table.rates, index, fraction, -1, 1);
+      return std::pow (std::min (std::max (q, 0.0), 1.0), nbits);
+    }
+  double value = Interpolate (table.values, index, fraction, MIN_VALUE, MAX_VALUE);
+  return std::exp (-std::exp (value) * nbits);
+}
+
+double
+TabulatedErrorRateModel::Interpolate (const std::vector<double> &points, std::size_t index, double fraction,
+                                      double low, double high)
+{
+  if (points.size () >= 4)
+    {
+      // Lagrange polynomial through the four nearest points, shifted
+      // inwards at the edges of the grid
+      std::size_t first = std::min (index > 0 ? index - 1 : 0, points.size () - 4);
+      const double *p = &points[first];
+      if (p[0] > low && p[0] < high && p[1] > low && p[1] < high
+          && p[2] > low && p[2] < high && p[3] > low && p[3] < high)
+        {
+          double x = index - first + fraction;
+          return - (x - 1) * (x - 2) * (x - 3) / 6 * p[0]
+                 + x * (x - 2) * (x - 3) / 2 * p[1]
+                 - x * (x - 1) * (x - 3) / 2 * p[2]
+                 + x * (x - 1) * (x - 2) / 6 * p[3];
+        }
+    }
+  return points[index] + fraction * (points[index + 1] - points[index]);
+}
+
+double
+TabulatedErrorRateModel::GetInterpolatedValue (const Table &table, std::size_t index, double fraction)
+{
+  if (table.rates[index] < MAX_INTERPOLATED_RATE)
+    {
+      return GetValue (Interpolate (table.rates, index, fraction, -1, 1));
+    }
+  return Interpolate (table.values, index, fraction, MIN_VALUE, MAX_VALUE);
+}
+
+uint32_t
+TabulatedErrorRateModel::GetTableSize (WifiMode mode, WifiTxVector txVector) const
+{
+  if (!IsTabulated (mode))
+    {
+      return 0;
+    }
+  return GetTable (mode, txVector).values.size ();
+}
+
+const TabulatedErrorRateModel::Table &
+TabulatedErrorRateModel::GetTable (WifiMode mode, WifiTxVector txVector) const
+{
+  static std::map<TableKey, Table> tables;
+  TableKey key (m_modelTypeId.GetUid (), mode.GetUid (), txVector.GetChannelWidth (),
+                txVector.GetGuardInterval (), txVector.GetNss (), m_epsilon);
+  // Consecutive chunks mostly belong to the same transmission.
+  if (m_lastTable != 0 && m_lastKey == key)
+    {
+      return *m_lastTable;
+    }
+  auto it = tables.find (key);
+  if (it == tables.end ())
+    {
+      it = tables.insert (std::make_pair (key, Table ())).first;
+      BuildTable (mode, txVector, &it->second);
+    }
+  m_lastKey = key;
+  m_lastTable = &it->second;
+  return it->second;
+}
+
+double
+TabulatedErrorRateModel::GetAnalyticRate (WifiMode mode, WifiTxVector txVector, double snrDb) const
+{
+  return GetAnalyticModel ()->GetChunkSuccessRate (mode, txVector, std::pow (10.0, snrDb / 10), 1);
+}
+
+double
+TabulatedErrorRateModel::GetValue (double q)
+{
+  if (q <= 0)
+    {
+      return MAX_VALUE;
+    }
+  if (q >= 1)
+    {
+      return MIN_VALUE;
+    }
+  return std::min (std::max (std::log (-std::log (q)), MIN_VALUE), MAX_VALUE);
+}
+
+double
+TabulatedErrorRateModel::GetError (double expected, double actual)
+{
+  // The chunk success rates are exp (-a n) and exp (-b n), whose
+  // difference peaks at n = log (a / b) / (a - b).
+  double a = std::exp (expected);
+  double b = std::exp (actual);
+  if (a == b)
+    {
+      return 0;
+    }
+  double n = MAX_BITS;
+  if (a > 0 && b > 0)
+    {
+      n = std::min (n, std::log (a / b) / (a - b));
+    }
+  n = std::max (n, 1.0);
+  return std::abs (std::exp (-a * n) - std::exp (-b * n));
+}
+
+void
+TabulatedErrorRateModel::BuildTable (WifiMode mode, WifiTxVector txVector, Table *table) const
+{
+  NS_LOG_FUNCTION (this << mode << m_epsilon);
+  // q is zero at low SNRs, where all bits are in error, and has a kink
+  // where it becomes positive: start the grid right there.
+  table->start = MIN_SNR_DB;
+  if (GetAnalyticRate (mode, txVector, MIN_SNR_DB) <= 0)
+    {
+      double low = MIN_SNR_DB;
+      double high = MAX_SNR_DB;
+      while (high - low > 1e-9)
+        {
+          double middle = (low + high) / 2;
+          if (GetAnalyticRate (mode, txVector, middle) <= 0)
+            {
+              low = middle;
+            }
+          else
+            {
+              high = middle;
+            }
+        }
+      table->start = low;
+    }
+  table->step = INITIAL_STEP_DB;
+  uint32_t size = static_cast<uint32_t> ((MAX_SNR_DB - table->start) / table->step) + 1;
+  table->rates.resize (size);
+  table->values.resize (size);
+  for (uint32_t i = 0; i < size; i++)
+    {
+      table->rates[i] = GetAnalyticRate (mode, txVector, table->start + i * table->step);
+      table->values[i] = GetValue (table->rates[i]);
+    }
+  while (true)
+    {
+      // The interpolation error peaks around the middle of each interval,
+      // where the points of the next, finer grid lie.
+      std::vector<double> middles (size - 1);
+      double error = 0;
+      for (uint32_t i = 0; i < size - 1; i++)
+        {
+          middles[i] = GetAnalyticRate (mode, txVector, table->start + (i + 0.5) * table->step);
+          error = std::max (error, GetError (GetValue (middles[i]), GetInterpolatedValue (*table, i, 0.5)));
+        }
+      NS_LOG_DEBUG ("mode=" << mode << " step=" << table->step << "dB error=" << error);
+      if (error <= m_epsilon || table->step / 2 < MIN_STEP_DB)
+        {
+          if (error > m_epsilon)
+            {
+              NS_LOG_WARN ("Cannot tabulate " << mode << " within " << m_epsilon << ": error=" << error);
+            }
+          break;
+        }
+      std::vector<double> rates (2 * size - 1);
+      for (uint32_t i = 0; i < size - 1; i++)
+        {
+          rates[2 * i] = table->rates[i];
+          rates[2 * i + 1] = middles[i];
+        }
+      rates.back () = table->rates.back ();
+      table->rates.swap (rates);
+      size = table->rates.size ();
+      table->values.resize (size);
+      for (uint32_t i = 0; i < size; i++)
+        {
+          table->values[i] = GetValue (table->rates[i]);
+        }
+      table->step /= 2;
+    }
+}
+
+} //namespace ns3
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABULATED_ERROR_RATE_MODEL_H
+#define TABULATED_ERROR_RATE_MODEL_H
+
+#include "error-rate-model.h"
+#include <vector>
+#include <tuple>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * An error rate model which tabulates an analytic model, such as the
+ * NistErrorRateModel or the YansErrorRateModel, over a dense SNR grid.
+ *
+ * For OFDM based modulations, these models compute the success rate of
+ * a chunk of n bits as q(snr)^n, where q is the success rate of a single
+ * bit.  The table holds q every few hundredths of a dB, along with
+ * log (-log (q)) which is interpolated instead when bit errors are rare,
+ * so that the error on q^n stays small for long chunks.  Both are cubic
+ * interpolations of the four nearest grid points, which replaces the
+ * erfc, pow and binomial evaluations of the analytic model with four
+ * table loads and a few exponentials.  The grid starts at the SNR below
+ * which q is zero, where the analytic model is not smooth.
+ *
+ * A table is built on first use of each WifiMode (and channel width,
+ * guard interval and number of spatial streams), and is shared by all
+ * the models of the process which tabulate the same analytic model with
+ * the same accuracy.  The grid is refined until the chunk success rates
+ * differ from the analytic model by at most the Epsilon attribute, for
+ * chunks of up to MAX_BITS bits.  SNRs outside of the grid and DSSS
+ * modulations are handed to the analytic model.
+ *
+ * The analytic model is created from its TypeId and its attributes
+ * are left to their default values.
+ */
+class TabulatedErrorRateModel : public ErrorRateModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TabulatedErrorRateModel ();
+  virtual ~TabulatedErrorRateModel ();
+
+  double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
+  /**
+   * \returns the analytic model tabulated by this model
+   */
+  Ptr<ErrorRateModel> GetAnalyticModel (void) const;
+
+  /**
+   * \param mode the Wi-Fi mode
+   * \param txVector the TXVECTOR of the transmission
+   * \returns the number of points of the SNR grid of the given mode,
+   *          building the table if needed, or 0 if the mode is not tabulated
+   */
+  uint32_t GetTableSize (WifiMode mode, WifiTxVector txVector) const;
+
+  /// The largest chunk, in bits, for which Epsilon is guaranteed
+  static const uint64_t MAX_BITS = 100000000;
+
+
+private:
+  virtual void DoDispose (void);
+
+  /**
+   * An SNR grid of the success rate q of a single bit.
+   */
+  struct Table
+  {
+    double start;               ///< the first SNR of the grid, in dB
+    double step;                ///< the grid step, in dB
+    std::vector<double> rates;  ///< q on the grid
+    std::vector<double> values; ///< log (-log (q)) on the grid
+  };
+
+  /**
+   * The key of a table: the analytic model TypeId, the WifiMode, the
+   * channel width, the guard interval, the number of spatial streams and
+   * the accuracy.
+   */
+  typedef std::tuple<uint16_t, uint32_t, uint16_t, uint16_t, uint8_t, double> TableKey;
+
+  /**
+   * Find or build the table of a mode.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector the TXVECTOR of the transmission
+   * \returns the table
+   */
+  const Table & GetTable (WifiMode mode, WifiTxVector txVector) const;
+  /**
+   * Build the table of a mode, halving the grid step until the
+   * accuracy is met.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector the TXVECTOR of the transmission
+   * \param table the table to fill
+   */
+  void BuildTable (WifiMode mode, WifiTxVector txVector, Table *table) const;
+  /**
+   * \param mode the Wi-Fi mode
+   * \param txVector the TXVECTOR of the transmission
+   * \param snrDb the SNR, in dB
+   * \returns q from the analytic model
+   */
+  double GetAnalyticRate (WifiMode mode, WifiTxVector txVector, double snrDb) const;
+  /**
+   * \param rate the success rate q of a single bit
+   * \returns log (-log (q)), bounded
+   */
+  static double GetValue (double rate);
+  /**
+   * Interpolate a grid with the four nearest points, or with the two
+   * nearest ones where the values are not strictly within bounds, such
+   * as on the plateau where no bit error can happen.
+   *
+   * \param points the values on the grid
+   * \param index the index of the grid point before the SNR
+   * \param fraction the position of the SNR between the grid points
+   * \param low the lower bound of the values
+   * \param high the upper bound of the values
+   * \returns the interpolated value
+   */
+  static double Interpolate (const std::vector<double> &points, std::size_t index, double fraction,
+                             double low, double high);
+  /**
+   * Interpolate the table.
+   *
+   * \param table the table
+   * \param index the index of the grid point before the SNR
+   * \param fraction the position of the SNR between the grid points
+   * \returns log (-log (q)) at the SNR
+   */
+  static double GetInterpolatedValue (const Table &table, std::size_t index, double fraction);
+  /**
+   * \param mode the Wi-Fi mode
+   * \returns whether the chunk success rates of the mode are tabulated
+   */
+  static bool IsTabulated (WifiMode mode);
+  /**
+   * \param expected log (-log (q)) from the analytic model
+   * \param actual log (-log (q)) interpolated from the table
+   * \returns the largest difference between the chunk success rates they
+   *          lead to, over chunks of up to MAX_BITS bits
+   */
+  static double GetError (double expected, double actual);
+
+  TypeId m_modelTypeId;                 //!< The TypeId of the analytic model
+  mutable Ptr<ErrorRateModel> m_model;  //!< The analytic model
+  double m_epsilon;                     //!< The accuracy of the tables
+  mutable TableKey m_lastKey;           //!< The key of the last table used
+  mutable const Table *m_lastTable;     //!< The last table used
+};
+
+} //namespace ns3
+
+#endif /* TABULATED_ERROR_RATE_MODEL_H */
@@ -2740,17 +2740,109 @@ WifiPhy::ContinueReceiveHeader (Ptr<Event> event)
     }
 }
 
-void
-WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDuration)
+namespace {
+
+/**
+ * A received packet and its content once stripped of its WifiPhyTag and
+ * PHY headers.  None of them depends on the receiver.
+ */
+struct StrippedPpdu
+{
+  Ptr<const Packet> ppdu;  //!< the packet as sent on the channel
+  Ptr<const Packet> psdu;  //!< the packet without its WifiPhyTag and PHY headers
+  WifiPhyTag tag;          //!< the WifiPhyTag
+  DsssSigHeader dsssSig;   //!< the DSSS SIG header, if any
+  LSigHeader lSig;         //!< the L-SIG header, if any
+  HtSigHeader htSig;       //!< the HT-SIG header, if any
+  VhtSigHeader vhtSig;     //!< the VHT-SIG header, if any
+  HeSigHeader heSig;       //!< the HE-SIG header, if any
+};
+
+/**
+ * Strip a received packet of its WifiPhyTag and PHY headers.
+ *
+ * The receivers of a transmission get the same packet from the channel
+ * one after the other, so the last packet stripped is kept and the
+ * receivers share its PSDU instead of each stripping a copy of their
+ * own.  The cache is never freed, so that it stays valid during static
+ * destruction.
+ *
+ * \param ppdu the packet as sent on the channel
+ * \return the stripped packet
+ */
+const StrippedPpdu &
+StripPpdu (Ptr<const Packet> ppdu)
 {
-  NS_LOG_FUNCTION (this << packet << rxPowerW << rxDuration);
-  WifiPhyTag tag;
-  bool found = packet->RemovePacketTag (tag);
+  static StrippedPpdu *last = new StrippedPpdu ();
+  if (last->ppdu == ppdu)
+    {
+      return *last;
+    }
+  last->ppdu = 0;
+  Ptr<Packet> packet = ppdu->Copy ();
+  bool found = packet->RemovePacketTag (last->tag);
   if (!found)
     {
       NS_FATAL_ERROR ("Received Wi-Fi Signal with no WifiPhyTag");
-      return;
     }
+  WifiPreamble preamble = last->tag.GetPreambleType ();
+  WifiModulationClass modulation = last->tag.GetModulation ();
+  if ((modulation == WIFI_MOD_CLASS_DSSS) || (modulation == WIFI_MOD_CLASS_HR_DSSS))
+    {
+      found = packet->RemoveHeader (last->dsssSig);
+      if (!found)
+        {
+          NS_FATAL_ERROR ("Received 802.11b signal with no SIG field");
+        }
+    }
+  else if ((modulation != WIFI_MOD_CLASS_HT) || (preamble != WIFI_PREAMBLE_HT_GF))
+    {
+      found = packet->RemoveHeader (last->lSig);
+      if (!found)
+        {
+          NS_FATAL_ERROR ("Received OFDM 802.11 signal with no SIG field");
+        }
+    }
+  if (modulation == WIFI_MOD_CLASS_HT)
+    {
+      found = packet->RemoveHeader (last->htSig);
+      if (!found)
+        {
+          NS_FATAL_ERROR ("Received 802.11n signal with no HT-SIG field");
+        }
+    }
+  else if (modulation == WIFI_MOD_CLASS_VHT)
+    {
+      last->vhtSig.SetMuFlag (preamble == WIFI_PREAMBLE_VHT_MU);
+      found = packet->RemoveHeader (last->vhtSig);
+      if (!found)
+        {
+          NS_FATAL_ERROR ("Received 802.11ac signal with no VHT-SIG field");
+        }
+    }
+  else if (modulation == WIFI_MOD_CLASS_HE)
+    {
+      last->heSig.SetMuFlag (preamble == WIFI_PREAMBLE_HE_MU);
+      found = packet->RemoveHeader (last->heSig);
+      if (!found)
+        {
+          NS_FATAL_ERROR ("Received 802.11ax signal with no HE-SIG field");
+        }
+    }
+  last->psdu = packet;
+  last->ppdu = ppdu;
+  return *last;
+}
+
+} // unnamed namespace
+
+void
+WifiPhy::StartReceivePreamble (Ptr<const Packet> ppdu, double rxPowerW, Time rxDuration)
+{
+  NS_LOG_FUNCTION (this << ppdu << rxPowerW << rxDuration);
+  const StrippedPpdu &stripped = StripPpdu (ppdu);
+  Ptr<const Packet> packet = stripped.psdu;
+  WifiPhyTag tag = stripped.tag;
 
   WifiPreamble preamble = tag.GetPreambleType ();
   WifiModulationClass modulation = tag.GetModulation ();
@@ -2758,13 +2850,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
   txVector.SetPreambleType (preamble);
   if ((modulation == WIFI_MOD_CLASS_DSSS) || (modulation == WIFI_MOD_CLASS_HR_DSSS))
     {
-      DsssSigHeader dsssSigHdr;
-      found = packet->RemoveHeader (dsssSigHdr);
-      if (!found)
-        {
-          NS_FATAL_ERROR ("Received 802.11b signal with no SIG field");
-          return;
-        }
+      const DsssSigHeader &dsssSigHdr = stripped.dsssSig;
       txVector.SetChannelWidth (22);
       for (uint8_t i = 0; i < GetNModes (); i++)
         {
@@ -2779,13 +2865,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
     }
   else if ((modulation != WIFI_MOD_CLASS_HT) || (preamble != WIFI_PREAMBLE_HT_GF))
     {
-      LSigHeader lSigHdr;
-      found = packet->RemoveHeader (lSigHdr);
-      if (!found)
-        {
-          NS_FATAL_ERROR ("Received OFDM 802.11 signal with no SIG field");
-          return;
-        }
+      const LSigHeader &lSigHdr = stripped.lSig;
       uint16_t channelWidth = GetChannelWidth ();
       txVector.SetChannelWidth (channelWidth > 20 ? 20 : channelWidth);
       for (uint8_t i = 0; i < GetNModes (); i++)
@@ -2800,13 +2880,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
     }
   if (modulation == WIFI_MOD_CLASS_HT)
     {
-      HtSigHeader htSigHdr;
-      found = packet->RemoveHeader (htSigHdr);
-      if (!found)
-        {
-          NS_FATAL_ERROR ("Received 802.11n signal with no HT-SIG field");
-          return;
-        }
+      const HtSigHeader &htSigHdr = stripped.htSig;
       txVector.SetChannelWidth (htSigHdr.GetChannelWidth ());
       for (uint8_t i = 0; i < GetNMcs (); i++)
         {
@@ -2823,14 +2897,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
     }
   else if (modulation == WIFI_MOD_CLASS_VHT)
     {
-      VhtSigHeader vhtSigHdr;
-      vhtSigHdr.SetMuFlag (preamble == WIFI_PREAMBLE_VHT_MU);
-      found = packet->RemoveHeader (vhtSigHdr);
-      if (!found)
-        {
-          NS_FATAL_ERROR ("Received 802.11ac signal with no VHT-SIG field");
-          return;
-        }
+      const VhtSigHeader &vhtSigHdr = stripped.vhtSig;
       txVector.SetChannelWidth (vhtSigHdr.GetChannelWidth ());
       txVector.SetNss (vhtSigHdr.GetNStreams ());
       for (uint8_t i = 0; i < GetNMcs (); i++)
@@ -2850,14 +2917,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
     }
   else if (modulation == WIFI_MOD_CLASS_HE)
     {
-      HeSigHeader heSigHdr;
-      heSigHdr.SetMuFlag (preamble == WIFI_PREAMBLE_HE_MU);
-      found = packet->RemoveHeader (heSigHdr);
-      if (!found)
-        {
-          NS_FATAL_ERROR ("Received 802.11ax signal with no HE-SIG field");
-          return;
-        }
+      const HeSigHeader &heSigHdr = stripped.heSig;
       txVector.SetChannelWidth (heSigHdr.GetChannelWidth ());
       txVector.SetNss (heSigHdr.GetNStreams ());
       for (uint8_t i = 0; i < GetNMcs (); i++)
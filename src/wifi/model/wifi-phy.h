@@ -29,6 +29,7 @@
 #include "wifi-phy-standard.h"
 #include "interference-helper.h"
 #include "wifi-phy-state-helper.h"
+#include <map>
 
 namespace ns3 {
 
@@ -139,11 +140,15 @@ public:
   /**
    * Start receiving the PHY preamble of a packet (i.e. the first bit of the preamble has arrived).
    *
+   * The packet is not modified: all the receivers of a transmission
+   * share it, along with the packet stripped of its WifiPhyTag and PHY
+   * headers, which is only copied once it is passed up to the MAC.
+   *
    * \param packet the arriving packet
    * \param rxPowerW the receive power in W
    * \param rxDuration the duration needed for the reception of the packet
    */
-  void StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDuration);
+  void StartReceivePreamble (Ptr<const Packet> packet, double rxPowerW, Time rxDuration);
 
   /**
    * Start receiving the PHY header of a packet (i.e. after the end of receiving the preamble).
@@ -18,10 +18,15 @@
  * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <algorithm>
+#include <cmath>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/abort.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
@@ -46,17 +51,55 @@ YansWifiChannel::GetTypeId (void)
     .AddConstructor<YansWifiChannel> ()
     .AddAttribute ("PropagationLossModel", "A pointer to the propagation loss model attached to this channel.",
                    PointerValue (),
-                   MakePointerAccessor (&YansWifiChannel::m_loss),
+                   MakePointerAccessor (&YansWifiChannel::SetPropagationLossModel,
+                                        &YansWifiChannel::GetPropagationLossModel),
                    MakePointerChecker<PropagationLossModel> ())
     .AddAttribute ("PropagationDelayModel", "A pointer to the propagation delay model attached to this channel.",
                    PointerValue (),
-                   MakePointerAccessor (&YansWifiChannel::m_delay),
+                   MakePointerAccessor (&YansWifiChannel::SetPropagationDelayModel,
+                                        &YansWifiChannel::GetPropagationDelayModel),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "PHYs farther than this distance (m) from the sender do not receive the frame. "
+                   "The PHY positions are then indexed in a grid of MaxRange sized cells so that "
+                   "Send only visits nearby PHYs. 0 disables the cutoff.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("CullBelowSensitivity",
+                   "Do not schedule a reception event for a PHY whose rx power is below its "
+                   "RxSensitivity; such frames are otherwise discarded on arrival.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_cullBelowSensitivity),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ValidateCulling",
+                   "Compare every MaxRange culled Send with the exhaustive loop and abort if a "
+                   "culled PHY would have received the frame. Debugging aid: the loss model is "
+                   "evaluated for every PHY, which changes the draws of random loss models.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_validateCulling),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CachePropagation",
+                   "Memoize the rx power and the delay of each sender/receiver pair while both "
+                   "PHYs have a zero velocity, until one of them fires its CourseChange trace. "
+                   "Only used when the loss and delay models are deterministic; the cache is "
+                   "cleared when they are replaced, through the PropagationLossModel and "
+                   "PropagationDelayModel attributes or their setters.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_cachePropagation),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0),
+    m_cullBelowSensitivity (false),
+    m_validateCulling (false),
+    m_cachePropagation (false),
+    m_gridValid (false),
+    m_gridMaxSpeed (0),
+    m_propagationCache (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -67,11 +110,30 @@ YansWifiChannel::~YansWifiChannel ()
   m_phyList.clear ();
 }
 
+void
+YansWifiChannel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_mobility.size (); i++)
+    {
+      m_mobility[i]->TraceDisconnectWithoutContext ("CourseChange",
+                                                    MakeBoundCallback (&YansWifiChannel::NotifyCourseChange, this, i));
+    }
+  m_mobility.clear ();
+  m_positions.Clear ();
+  m_propagationCache.Clear ();
+  m_grid.clear ();
+  m_gridCell.clear ();
+  m_gridValid = false;
+  Channel::DoDispose ();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel (const Ptr<PropagationLossModel> loss)
 {
   NS_LOG_FUNCTION (this << loss);
   m_loss = loss;
+  m_propagationCache.Clear ();
 }
 
 void
@@ -79,50 +141,319 @@ YansWifiChannel::SetPropagationDelayModel (const Ptr<PropagationDelayModel> dela
 {
   NS_LOG_FUNCTION (this << delay);
   m_delay = delay;
+  m_propagationCache.Clear ();
+}
+
+Ptr<PropagationLossModel>
+YansWifiChannel::GetPropagationLossModel (void) const
+{
+  return m_loss;
+}
+
+Ptr<PropagationDelayModel>
+YansWifiChannel::GetPropagationDelayModel (void) const
+{
+  return m_delay;
 }
 
 void
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration) const
 {
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds ());
-  Ptr<MobilityModel> senderMobility = sender->GetMobility ();
-  NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  NS_ASSERT (sender->GetMobility () != 0);
+  m_rxBatch.clear ();
+  m_receivers.clear ();
+  TrackMobility ();
+  std::unordered_map<const YansWifiPhy *, uint32_t>::const_iterator senderIt = m_phyIndex.find (PeekPointer (sender));
+  NS_ASSERT_MSG (senderIt != m_phyIndex.end (), "Sender PHY is not attached to this channel");
+  uint32_t senderIndex = senderIt->second;
+  if (m_maxRange <= 0)
     {
-      if (sender != (*i))
+      for (uint32_t i = 0; i < m_phyList.size (); i++)
         {
           //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          if (i != senderIndex && m_phyList[i]->GetChannelNumber () == sender->GetChannelNumber ())
             {
-              continue;
+              m_receivers.push_back (i);
             }
+        }
+    }
+  else
+    {
+      FindCandidates (senderIndex);
+      if (m_validateCulling)
+        {
+          ValidateCandidates (sender, txPowerDbm);
+        }
+      for (std::vector<uint32_t>::const_iterator i = m_candidates.begin (); i != m_candidates.end (); i++)
+        {
+          if (*i != senderIndex && m_phyList[*i]->GetChannelNumber () == sender->GetChannelNumber ())
+            {
+              m_receivers.push_back (*i);
+            }
+        }
+    }
+  CalcPropagation (senderIndex, txPowerDbm);
+  for (std::size_t k = 0; k < m_receivers.size (); k++)
+    {
+      SendTo (m_phyList[m_receivers[k]], packet, m_rxPowerDbm[k], m_delays[k], duration);
+    }
+  Simulator::ScheduleWithContextBatch (m_rxBatch);
+  m_rxBatch.clear ();
+}
+
+void
+YansWifiChannel::SendTo (Ptr<YansWifiPhy> receiver, Ptr<const Packet> packet,
+                         double rxPowerDbm, Time delay, Time duration) const
+{
+  if (m_cullBelowSensitivity && (rxPowerDbm + receiver->GetRxGain ()) < receiver->GetRxSensitivity ())
+    {
+      NS_LOG_INFO ("Signal too weak to be received, not scheduled: " << rxPowerDbm << " dBm");
+      return;
+    }
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+  m_rxBatch.push_back (Simulator::ContextEvent (dstNode, delay,
+                                                MakeEvent (&YansWifiChannel::Receive,
+                                                           receiver, packet, rxPowerDbm, duration)));
+}
+
+void
+YansWifiChannel::CalcPropagation (uint32_t sender, double txPowerDbm) const
+{
+  std::size_t n = m_receivers.size ();
+  m_rxPowerDbm.resize (n);
+  m_delays.resize (n);
+  m_rxDistances.resize (n);
+  m_positions.Update ();
+  m_positions.GetDistancesFrom (sender, m_receivers.data (), n, m_rxDistances.data ());
+  Ptr<MobilityModel> senderMobility = m_mobility[sender];
+
+  // Look up the static pairs in the cache; the others go to the batch.
+  // Lazy mobility models only update their course when queried, so the
+  // velocities are checked on every lookup rather than only when caching.
+  bool cacheEnabled = m_cachePropagation && m_loss->IsDeterministic () && m_delay->IsDeterministic ()
+    && senderMobility->GetVelocity ().GetLength () == 0;
+  m_misses.clear ();
+  m_missPaths.clear ();
+  for (std::size_t k = 0; k < n; k++)
+    {
+      Ptr<MobilityModel> receiverMobility = m_mobility[m_receivers[k]];
+      Ptr<PathData> path;
+      if (cacheEnabled && receiverMobility->GetVelocity ().GetLength () == 0)
+        {
+          path = m_propagationCache.GetPathData (senderMobility, receiverMobility, 0);
+          if (path != 0 && path->txPowerDbm == txPowerDbm)
+            {
+              m_rxPowerDbm[k] = path->rxPowerDbm;
+              m_delays[k] = path->delay;
+              continue;
+            }
+          if (path == 0)
             {
-              dstNode = 0xffffffff;
+              path = Create<PathData> ();
+              m_propagationCache.AddPathData (path, senderMobility, receiverMobility, 0);
             }
-          else
+        }
+      m_misses.push_back (k);
+      m_missPaths.push_back (path);
+    }
+  if (m_misses.empty ())
+    {
+      return;
+    }
+
+  std::size_t misses = m_misses.size ();
+  m_batchMobility.resize (misses);
+  m_batchPositions.resize (misses);
+  m_batchDistances.resize (misses);
+  m_batchRxPowerDbm.resize (misses);
+  for (std::size_t j = 0; j < misses; j++)
+    {
+      std::size_t k = m_misses[j];
+      m_batchMobility[j] = m_mobility[m_receivers[k]];
+      m_batchPositions[j] = m_positions.GetPosition (m_receivers[k]);
+      m_batchDistances[j] = m_rxDistances[k];
+    }
+  PropagationLossBatch batch;
+  batch.sender = senderMobility;
+  batch.senderPosition = m_positions.GetPosition (sender);
+  batch.receivers = m_batchMobility.data ();
+  batch.receiverPositions = m_batchPositions.data ();
+  batch.distances = m_batchDistances.data ();
+  batch.n = misses;
+  m_loss->CalcRxPowerBatch (txPowerDbm, batch, m_batchRxPowerDbm.data ());
+  for (std::size_t j = 0; j < misses; j++)
+    {
+      std::size_t k = m_misses[j];
+      m_rxPowerDbm[k] = m_batchRxPowerDbm[j];
+      m_delays[k] = m_delay->GetDelay (senderMobility, m_batchMobility[j]);
+      NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << m_rxPowerDbm[k] << "dbm, " <<
+                    "distance=" << m_rxDistances[k] << "m, delay=" << m_delays[k]);
+      Ptr<PathData> path = m_missPaths[j];
+      if (path != 0)
+        {
+          path->txPowerDbm = txPowerDbm;
+          path->rxPowerDbm = m_rxPowerDbm[k];
+          path->delay = m_delays[k];
+        }
+    }
+}
+
+void
+YansWifiChannel::TrackMobility (void) const
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = m_mobility.size (); i < m_phyList.size (); i++)
+    {
+      Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility ();
+      NS_ASSERT_MSG (mobility != 0, "YansWifiChannel requires a mobility model on every PHY");
+      mobility->TraceConnectWithoutContext ("CourseChange",
+                                            MakeBoundCallback (&YansWifiChannel::NotifyCourseChange, this, i));
+      m_mobility.push_back (mobility);
+      m_positions.Add (mobility);
+    }
+}
+
+uint64_t
+YansWifiChannel::GetCellKey (const Vector &position) const
+{
+  int32_t x = static_cast<int32_t> (std::floor (position.x / m_maxRange));
+  int32_t y = static_cast<int32_t> (std::floor (position.y / m_maxRange));
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
+
+void
+YansWifiChannel::BuildGrid (void) const
+{
+  NS_LOG_FUNCTION (this);
+  TrackMobility ();
+  m_positions.Update ();
+  m_grid.clear ();
+  m_gridCell.resize (m_phyList.size ());
+  m_gridMaxSpeed = 0;
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      Ptr<MobilityModel> mobility = m_mobility[i];
+      uint64_t key = GetCellKey (m_positions.GetPosition (i));
+      m_grid[key].push_back (i);
+      m_gridCell[i] = key;
+      m_gridMaxSpeed = std::max (m_gridMaxSpeed, CalculateDistance (mobility->GetVelocity (), Vector ()));
+    }
+  m_gridTime = Simulator::Now ();
+  m_gridValid = true;
+}
+
+void
+YansWifiChannel::NotifyCourseChange (const YansWifiChannel *channel, uint32_t index, Ptr<const MobilityModel> mobility)
+{
+  channel->m_propagationCache.RemovePathData (mobility);
+  if (!channel->m_gridValid || index >= channel->m_gridCell.size ())
+    {
+      return;
+    }
+  // The position recorded now drifts less than the others, so the slack
+  // computed from m_gridTime still bounds its displacement.
+  uint64_t key = channel->GetCellKey (mobility->GetPosition ());
+  uint64_t old = channel->m_gridCell[index];
+  if (key != old)
+    {
+      std::vector<uint32_t> &cell = channel->m_grid[old];
+      cell.erase (std::find (cell.begin (), cell.end (), index));
+      channel->m_grid[key].push_back (index);
+      channel->m_gridCell[index] = key;
+    }
+  channel->m_gridMaxSpeed = std::max (channel->m_gridMaxSpeed,
+                                      CalculateDistance (mobility->GetVelocity (), Vector ()));
+}
+
+void
+YansWifiChannel::FindCandidates (uint32_t sender) const
+{
+  // PHYs may have moved by up to slack since their position was recorded;
+  // the grid is rebuilt once this exceeds half a cell.
+  double slack = m_gridMaxSpeed * (Simulator::Now () - m_gridTime).GetSeconds ();
+  if (!m_gridValid || m_gridCell.size () != m_phyList.size () || slack > m_maxRange / 2)
+    {
+      BuildGrid ();
+      slack = 0;
+    }
+  m_positions.Update ();
+  Vector position = m_positions.GetPosition (sender);
+  double reach = m_maxRange + slack;
+  int32_t x0 = static_cast<int32_t> (std::floor ((position.x - reach) / m_maxRange));
+  int32_t x1 = static_cast<int32_t> (std::floor ((position.x + reach) / m_maxRange));
+  int32_t y0 = static_cast<int32_t> (std::floor ((position.y - reach) / m_maxRange));
+  int32_t y1 = static_cast<int32_t> (std::floor ((position.y + reach) / m_maxRange));
+  m_candidates.clear ();
+  for (int32_t x = x0; x <= x1; x++)
+    {
+      for (int32_t y = y0; y <= y1; y++)
+        {
+          uint64_t key = (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+          Grid::const_iterator cell = m_grid.find (key);
+          if (cell != m_grid.end ())
             {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
+              m_candidates.insert (m_candidates.end (), cell->second.begin (), cell->second.end ());
             }
+        }
+    }
+  // Same order as m_phyList, then exact distance check on current positions
+  std::sort (m_candidates.begin (), m_candidates.end ());
+  m_distances.resize (m_candidates.size ());
+  m_positions.GetDistancesFrom (sender, m_candidates.data (), m_candidates.size (), m_distances.data ());
+  std::vector<uint32_t>::iterator last = m_candidates.begin ();
+  for (std::size_t k = 0; k < m_candidates.size (); k++)
+    {
+      if (m_distances[k] <= m_maxRange)
+        {
+          *last++ = m_candidates[k];
+        }
+    }
+  m_candidates.erase (last, m_candidates.end ());
+  NS_LOG_DEBUG ("MaxRange " << m_maxRange << "m: " << m_candidates.size () << " of "
+                            << m_phyList.size () << " PHYs in range");
+}
 
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm, duration);
+void
+YansWifiChannel::ValidateCandidates (Ptr<YansWifiPhy> sender, double txPowerDbm) const
+{
+  Ptr<MobilityModel> senderMobility = sender->GetMobility ();
+  std::vector<uint32_t>::const_iterator c = m_candidates.begin ();
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      if (c != m_candidates.end () && *c == i)
+        {
+          c++;
+          continue;
+        }
+      Ptr<YansWifiPhy> receiver = m_phyList[i];
+      if (receiver == sender || receiver->GetChannelNumber () != sender->GetChannelNumber ())
+        {
+          continue;
         }
+      Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
+      double distance = senderMobility->GetDistanceFrom (receiverMobility);
+      NS_ABORT_MSG_IF (distance <= m_maxRange,
+                       "YansWifiChannel grid missed a PHY at " << distance << "m (MaxRange " << m_maxRange << "m)");
+      double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+      NS_ABORT_MSG_IF ((rxPowerDbm + receiver->GetRxGain ()) >= receiver->GetRxSensitivity (),
+                       "YansWifiChannel MaxRange " << m_maxRange << "m is too small: PHY at " << distance
+                       << "m would receive " << rxPowerDbm << " dBm");
     }
 }
 
 void
-YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<Packet> packet, double rxPowerDbm, Time duration)
+YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<const Packet> packet, double rxPowerDbm, Time duration)
 {
   NS_LOG_FUNCTION (phy << packet << rxPowerDbm << duration.GetSeconds ());
   // Do no further processing if signal is too weak
@@ -151,7 +482,9 @@ void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
+  m_phyIndex[PeekPointer (phy)] = m_phyList.size ();
   m_phyList.push_back (phy);
+  m_gridValid = false;
 }
 
 int64_t
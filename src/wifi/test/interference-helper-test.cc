@@ -0,0 +1,311 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief InterferenceHelper base test case
+ *
+ * Sets up an InterferenceHelper for 802.11a at 6 Mbps and computes the
+ * expected SNR and chunk success rates from first principles.
+ */
+class InterferenceHelperTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name the test case name
+   */
+  InterferenceHelperTestCase (std::string name);
+  virtual ~InterferenceHelperTestCase ();
+
+protected:
+  virtual void DoSetup (void);
+  virtual void DoTeardown (void);
+
+  /**
+   * Add a signal to the interference helper
+   *
+   * \param duration the signal duration
+   * \param rxPowerW the signal power in W
+   */
+  void AddSignal (Time duration, double rxPowerW);
+  /**
+   * Start receiving a signal
+   *
+   * \param duration the signal duration
+   * \param rxPowerW the signal power in W
+   */
+  void StartRx (Time duration, double rxPowerW);
+  /**
+   * End the ongoing reception
+   */
+  void EndRx (void);
+  /**
+   * Check the SNR of the signal being received
+   *
+   * \param interferenceW the expected noise and interference power, apart from thermal noise
+   */
+  void CheckSnr (double interferenceW);
+  /**
+   * \param interferenceW the noise and interference power, apart from thermal noise
+   * \returns the SNR of the signal being received
+   */
+  double GetExpectedSnr (double interferenceW) const;
+  /**
+   * \param snr the SNR
+   * \param duration the chunk duration
+   * \returns the success rate of a payload chunk of the signal being received
+   */
+  double GetExpectedChunkSuccessRate (double snr, Time duration) const;
+
+  InterferenceHelper m_interference; ///< the interference helper under test
+  Ptr<NistErrorRateModel> m_errorRateModel; ///< the error rate model
+  WifiTxVector m_txVector; ///< the TXVECTOR of all the signals
+  Ptr<Event> m_rx; ///< the signal being received
+};
+
+InterferenceHelperTestCase::InterferenceHelperTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+InterferenceHelperTestCase::~InterferenceHelperTestCase ()
+{
+}
+
+void
+InterferenceHelperTestCase::DoSetup (void)
+{
+  m_errorRateModel = CreateObject<NistErrorRateModel> ();
+  m_interference.EraseEvents ();
+  m_interference.SetNoiseFigure (1);
+  m_interference.SetErrorRateModel (m_errorRateModel);
+  m_txVector = WifiTxVector (WifiPhy::GetOfdmRate6Mbps (), 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 20, false, false);
+}
+
+void
+InterferenceHelperTestCase::DoTeardown (void)
+{
+  m_rx = 0;
+  m_interference.EraseEvents ();
+  m_interference.SetErrorRateModel (0);
+  m_errorRateModel = 0;
+}
+
+void
+InterferenceHelperTestCase::AddSignal (Time duration, double rxPowerW)
+{
+  m_interference.Add (0, m_txVector, duration, rxPowerW);
+}
+
+void
+InterferenceHelperTestCase::StartRx (Time duration, double rxPowerW)
+{
+  m_rx = m_interference.Add (0, m_txVector, duration, rxPowerW);
+  m_interference.NotifyRxStart ();
+}
+
+void
+InterferenceHelperTestCase::EndRx (void)
+{
+  m_interference.NotifyRxEnd ();
+  m_rx = 0;
+}
+
+void
+InterferenceHelperTestCase::CheckSnr (double interferenceW)
+{
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_interference.CalculateSnr (m_rx), GetExpectedSnr (interferenceW),
+                             GetExpectedSnr (interferenceW) * 1e-12,
+                             "Unexpected SNR at " << Simulator::Now ().As (Time::US));
+}
+
+double
+InterferenceHelperTestCase::GetExpectedSnr (double interferenceW) const
+{
+  double noiseFloorW = 1.3803e-23 * 290 * 20e6;
+  return m_rx->GetRxPowerW () / (noiseFloorW + interferenceW);
+}
+
+double
+InterferenceHelperTestCase::GetExpectedChunkSuccessRate (double snr, Time duration) const
+{
+  WifiMode mode = m_txVector.GetMode ();
+  uint64_t nbits = static_cast<uint64_t> (mode.GetDataRate (m_txVector) * duration.GetSeconds ());
+  return m_errorRateModel->GetChunkSuccessRate (mode, m_txVector, snr, nbits);
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the SNR and the energy duration with overlapping interferers
+ */
+class InterferenceHelperSnrTestCase : public InterferenceHelperTestCase
+{
+public:
+  InterferenceHelperSnrTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the energy duration
+   *
+   * \param energyW the energy threshold in W
+   * \param expected the expected duration
+   */
+  void CheckEnergyDuration (double energyW, Time expected);
+};
+
+InterferenceHelperSnrTestCase::InterferenceHelperSnrTestCase ()
+  : InterferenceHelperTestCase ("Check the SNR with overlapping interferers")
+{
+}
+
+void
+InterferenceHelperSnrTestCase::CheckEnergyDuration (double energyW, Time expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_interference.GetEnergyDuration (energyW), expected,
+                         "Unexpected energy duration at " << Simulator::Now ().As (Time::US));
+}
+
+void
+InterferenceHelperSnrTestCase::DoRun (void)
+{
+  double powerW = 1e-9;
+  double interfererW = 2e-10;
+  // An interferer which starts before the reception is counted from the start.
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperSnrTestCase::AddSignal, this, MicroSeconds (500), interfererW / 2);
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperSnrTestCase::StartRx, this, MicroSeconds (1000), powerW);
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperSnrTestCase::CheckSnr, this, interfererW / 2);
+  Simulator::Schedule (MicroSeconds (150), &InterferenceHelperSnrTestCase::CheckSnr, this, interfererW / 2);
+  // Two more interferers overlapping each other
+  Simulator::Schedule (MicroSeconds (200), &InterferenceHelperSnrTestCase::AddSignal, this, MicroSeconds (400), interfererW);
+  Simulator::Schedule (MicroSeconds (300), &InterferenceHelperSnrTestCase::AddSignal, this, MicroSeconds (200), interfererW);
+  Simulator::Schedule (MicroSeconds (250), &InterferenceHelperSnrTestCase::CheckSnr, this, 1.5 * interfererW);
+  Simulator::Schedule (MicroSeconds (350), &InterferenceHelperSnrTestCase::CheckSnr, this, 2.5 * interfererW);
+  Simulator::Schedule (MicroSeconds (350), &InterferenceHelperSnrTestCase::CheckEnergyDuration, this, powerW + 1.5 * interfererW, MicroSeconds (150));
+  Simulator::Schedule (MicroSeconds (350), &InterferenceHelperSnrTestCase::CheckEnergyDuration, this, powerW + 0.5 * interfererW, MicroSeconds (250));
+  Simulator::Schedule (MicroSeconds (350), &InterferenceHelperSnrTestCase::CheckEnergyDuration, this, powerW / 2, MicroSeconds (750));
+  Simulator::Schedule (MicroSeconds (550), &InterferenceHelperSnrTestCase::CheckSnr, this, interfererW);
+  Simulator::Schedule (MicroSeconds (700), &InterferenceHelperSnrTestCase::CheckSnr, this, 0);
+  Simulator::Schedule (MicroSeconds (1100), &InterferenceHelperSnrTestCase::EndRx, this);
+  // Once idle, a new reception drops the changes of the former ones.
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      Time start = MicroSeconds (2000 + 100 * i);
+      Simulator::Schedule (start, &InterferenceHelperSnrTestCase::AddSignal, this, MicroSeconds (100), interfererW);
+      Simulator::Schedule (start + MicroSeconds (50), &InterferenceHelperSnrTestCase::StartRx, this, MicroSeconds (20), powerW);
+      Simulator::Schedule (start + MicroSeconds (50), &InterferenceHelperSnrTestCase::CheckSnr, this, interfererW);
+      Simulator::Schedule (start + MicroSeconds (60), &InterferenceHelperSnrTestCase::CheckSnr, this, interfererW);
+      Simulator::Schedule (start + MicroSeconds (70), &InterferenceHelperSnrTestCase::EndRx, this);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the payload PER when interferers split the payload in chunks
+ */
+class InterferenceHelperPerTestCase : public InterferenceHelperTestCase
+{
+public:
+  InterferenceHelperPerTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the payload PER of the signal being received
+   */
+  void CheckPayloadPer (void);
+};
+
+InterferenceHelperPerTestCase::InterferenceHelperPerTestCase ()
+  : InterferenceHelperTestCase ("Check the payload PER with interferers")
+{
+}
+
+void
+InterferenceHelperPerTestCase::CheckPayloadPer (void)
+{
+  Time payloadStart = m_rx->GetStartTime () + WifiPhy::GetPlcpPreambleDuration (m_txVector)
+    + WifiPhy::GetPlcpHeaderDuration (m_txVector);
+  Time payloadDuration = m_rx->GetEndTime () - payloadStart;
+  double interfererW = 2.5e-12;
+  // The payload is split in chunks by the two interferers: from the
+  // payload start to 100 us, from 100 us to 300 us with one interferer,
+  // from 300 us to 350 us with both, and then with the second one only
+  // until 400 us.
+  double psr = GetExpectedChunkSuccessRate (GetExpectedSnr (0), MicroSeconds (100) - payloadStart);
+  psr *= GetExpectedChunkSuccessRate (GetExpectedSnr (interfererW), MicroSeconds (200));
+  psr *= GetExpectedChunkSuccessRate (GetExpectedSnr (3 * interfererW), MicroSeconds (50));
+  psr *= GetExpectedChunkSuccessRate (GetExpectedSnr (2 * interfererW), MicroSeconds (50));
+  psr *= GetExpectedChunkSuccessRate (GetExpectedSnr (0), MicroSeconds (600));
+  InterferenceHelper::SnrPer snrPer = m_interference.CalculatePayloadSnrPer (m_rx, std::make_pair (Time (0), payloadDuration));
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.snr, GetExpectedSnr (0), GetExpectedSnr (0) * 1e-12, "Unexpected SNR");
+  NS_TEST_EXPECT_MSG_GT (snrPer.per, 0, "The interferers should corrupt the payload");
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.per, 1 - psr, 1e-12, "Unexpected PER");
+}
+
+void
+InterferenceHelperPerTestCase::DoRun (void)
+{
+  double powerW = 1e-11;
+  double interfererW = 2.5e-12;
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperPerTestCase::StartRx, this, MicroSeconds (1000), powerW);
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperPerTestCase::AddSignal, this, MicroSeconds (250), interfererW);
+  Simulator::Schedule (MicroSeconds (300), &InterferenceHelperPerTestCase::AddSignal, this, MicroSeconds (100), 2 * interfererW);
+  Simulator::Schedule (MicroSeconds (1000), &InterferenceHelperPerTestCase::CheckPayloadPer, this);
+  Simulator::Schedule (MicroSeconds (1000), &InterferenceHelperPerTestCase::EndRx, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief InterferenceHelper Test Suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+public:
+  InterferenceHelperTestSuite ();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite ()
+  : TestSuite ("wifi-interference-helper", UNIT)
+{
+  AddTestCase (new InterferenceHelperSnrTestCase, TestCase::QUICK);
+  AddTestCase (new InterferenceHelperPerTestCase, TestCase::QUICK);
+}
+
+static InterferenceHelperTestSuite interferenceHelperTestSuite; ///< the test suite
@@ -22,6 +22,10 @@
 #include "ns3/test.h"
 #include "ns3/nist-error-rate-model.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
+#include "ns3/tabulated-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/double.h"
 #include "ns3/wifi-tx-vector.h"
 
 using namespace ns3;
@@ -291,6 +295,104 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Error Rate Models Test Case Tabulated
+ *
+ * Compares the chunk success rates of TabulatedErrorRateModel with those
+ * of the NIST and YANS models it tabulates, off the SNR grid and for
+ * chunks from one bit to a million bits.
+ */
+class WifiErrorRateModelsTestCaseTabulated : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTabulated ();
+  virtual ~WifiErrorRateModelsTestCaseTabulated ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the largest difference with the analytic model over a mode
+   *
+   * \param tabulated the tabulated model
+   * \param mode the Wi-Fi mode
+   * \param epsilon the largest difference allowed
+   */
+  void CheckMode (Ptr<TabulatedErrorRateModel> tabulated, WifiMode mode, double epsilon);
+};
+
+WifiErrorRateModelsTestCaseTabulated::WifiErrorRateModelsTestCaseTabulated ()
+  : TestCase ("WifiErrorRateModel test case Tabulated")
+{
+}
+
+WifiErrorRateModelsTestCaseTabulated::~WifiErrorRateModelsTestCaseTabulated ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTabulated::CheckMode (Ptr<TabulatedErrorRateModel> tabulated, WifiMode mode, double epsilon)
+{
+  WifiTxVector txVector (mode, 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 20, false, false);
+  Ptr<ErrorRateModel> analytic = tabulated->GetAnalyticModel ();
+  const uint64_t nbits[] = {1, 100, 12000, 1000000};
+  double error = 0;
+  for (double snrDb = -5; snrDb < 40; snrDb += 0.0371)
+    {
+      double snr = std::pow (10.0, snrDb / 10.0);
+      for (uint32_t i = 0; i < sizeof (nbits) / sizeof (nbits[0]); i++)
+        {
+          double expected = analytic->GetChunkSuccessRate (mode, txVector, snr, nbits[i]);
+          double actual = tabulated->GetChunkSuccessRate (mode, txVector, snr, nbits[i]);
+          error = std::max (error, std::abs (actual - expected));
+        }
+    }
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (error, epsilon, "Tabulated " << mode << " is not within " << epsilon);
+}
+
+void
+WifiErrorRateModelsTestCaseTabulated::DoRun (void)
+{
+  std::vector<WifiMode> modes;
+  modes.push_back (WifiPhy::GetOfdmRate6Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate9Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate12Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate18Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate24Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate36Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate48Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate54Mbps ());
+  modes.push_back (WifiPhy::GetVhtMcs8 ());
+  modes.push_back (WifiPhy::GetHeMcs11 ());
+
+  Ptr<TabulatedErrorRateModel> nist = CreateObject<TabulatedErrorRateModel> ();
+  Ptr<TabulatedErrorRateModel> yans = CreateObject<TabulatedErrorRateModel> ();
+  yans->SetAttribute ("Model", TypeIdValue (YansErrorRateModel::GetTypeId ()));
+  for (std::vector<WifiMode>::const_iterator it = modes.begin (); it != modes.end (); ++it)
+    {
+      CheckMode (nist, *it, 1e-5);
+      CheckMode (yans, *it, 1e-5);
+    }
+
+  // A tighter accuracy needs a finer grid.
+  Ptr<TabulatedErrorRateModel> fine = CreateObject<TabulatedErrorRateModel> ();
+  fine->SetAttribute ("Epsilon", DoubleValue (1e-7));
+  CheckMode (fine, WifiPhy::GetOfdmRate6Mbps (), 1e-7);
+  WifiTxVector txVector (WifiPhy::GetOfdmRate6Mbps (), 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 20, false, false);
+  NS_TEST_EXPECT_MSG_GT (fine->GetTableSize (WifiPhy::GetOfdmRate6Mbps (), txVector),
+                         nist->GetTableSize (WifiPhy::GetOfdmRate6Mbps (), txVector),
+                         "A tighter accuracy should need more points");
+
+  // DSSS modulations are not tabulated.
+  WifiMode dsss = WifiPhy::GetDsssRate1Mbps ();
+  NS_TEST_EXPECT_MSG_EQ (nist->GetTableSize (dsss, txVector), 0, "DSSS should not be tabulated");
+  NS_TEST_EXPECT_MSG_EQ (nist->GetChunkSuccessRate (dsss, txVector, 1.5, 1000),
+                         nist->GetAnalyticModel ()->GetChunkSuccessRate (dsss, txVector, 1.5, 1000),
+                         "DSSS should use the analytic model");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -308,6 +410,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTabulated, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
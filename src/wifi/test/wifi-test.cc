@@ -30,6 +30,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
 #include "ns3/test.h"
 #include "ns3/pointer.h"
 #include "ns3/rng-seed-manager.h"
@@ -46,6 +48,7 @@
 #include "ns3/mgt-headers.h"
 #include "ns3/ht-configuration.h"
 #include "ns3/wifi-phy-header.h"
+#include <set>
 
 using namespace ns3;
 
@@ -207,6 +210,305 @@ WifiTest::DoRun (void)
   RunOne ();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Common fixture of the YansWifiChannel tests: 802.11a ad hoc
+ * nodes with a constant velocity, counting their PhyRxBegin events.
+ */
+class YansWifiChannelTestBase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param name the test case name
+   */
+  YansWifiChannelTestBase (std::string name);
+
+protected:
+  /**
+   * Create one node
+   * \param pos the position
+   * \param velocity the velocity
+   * \param channel the wifi channel
+   * \returns the device
+   */
+  Ptr<WifiNetDevice> CreateOne (Vector pos, Vector velocity, Ptr<YansWifiChannel> channel);
+  /**
+   * Send one broadcast packet
+   * \param dev the device
+   */
+  void SendOnePacket (Ptr<WifiNetDevice> dev);
+  /**
+   * PhyRxBegin trace
+   * \param context the receiver index
+   * \param p the packet
+   */
+  void RxBegin (std::string context, Ptr<const Packet> p);
+
+  std::vector<uint32_t> m_rx; ///< PhyRxBegin count per node
+  std::set<const Packet *> m_rxPackets; ///< distinct packets seen by PhyRxBegin
+};
+
+YansWifiChannelTestBase::YansWifiChannelTestBase (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+YansWifiChannelTestBase::SendOnePacket (Ptr<WifiNetDevice> dev)
+{
+  Ptr<Packet> p = Create<Packet> (100);
+  dev->Send (p, dev->GetBroadcast (), 1);
+}
+
+void
+YansWifiChannelTestBase::RxBegin (std::string context, Ptr<const Packet> p)
+{
+  m_rx[std::atoi (context.c_str ())]++;
+  m_rxPackets.insert (PeekPointer (p));
+}
+
+Ptr<WifiNetDevice>
+YansWifiChannelTestBase::CreateOne (Vector pos, Vector velocity, Ptr<YansWifiChannel> channel)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice> ();
+  ObjectFactory mac;
+  mac.SetTypeId ("ns3::AdhocWifiMac");
+  Ptr<WifiMac> wifiMac = mac.Create<WifiMac> ();
+  wifiMac->SetDevice (dev);
+  wifiMac->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel> ();
+  mobility->SetPosition (pos);
+  mobility->SetVelocity (velocity);
+  node->AggregateObject (mobility);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetDevice (dev);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  std::ostringstream oss;
+  oss << m_rx.size ();
+  phy->TraceConnect ("PhyRxBegin", oss.str (), MakeCallback (&YansWifiChannelTestBase::RxBegin, this));
+  m_rx.push_back (0);
+  ObjectFactory manager;
+  manager.SetTypeId ("ns3::ConstantRateWifiManager");
+  wifiMac->SetAddress (Mac48Address::Allocate ());
+  dev->SetMac (wifiMac);
+  dev->SetPhy (phy);
+  dev->SetRemoteStationManager (manager.Create<WifiRemoteStationManager> ());
+  node->AddDevice (dev);
+  return dev;
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief YansWifiChannel MaxRange grid culling
+ *
+ * A sender at the origin broadcasts twice.  Receivers sit at 10 m, 40 m and
+ * 500 m, and a fourth one moves from 1000 m towards the sender so that it
+ * is only within 100 m at the second transmission.
+ */
+class YansWifiChannelCullingTest : public YansWifiChannelTestBase
+{
+public:
+  YansWifiChannelCullingTest ();
+
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Run one configuration
+   * \param maxRange the MaxRange attribute
+   * \param validate the ValidateCulling attribute
+   */
+  void RunOne (double maxRange, bool validate);
+};
+
+YansWifiChannelCullingTest::YansWifiChannelCullingTest ()
+  : YansWifiChannelTestBase ("YansWifiChannel MaxRange culling")
+{
+}
+
+void
+YansWifiChannelCullingTest::RunOne (double maxRange, bool validate)
+{
+  m_rx.clear ();
+  m_rxPackets.clear ();
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->SetAttribute ("ValidateCulling", BooleanValue (validate));
+  channel->SetAttribute ("CullBelowSensitivity", BooleanValue (validate));
+
+  Ptr<WifiNetDevice> sender = CreateOne (Vector (0.0, 0.0, 0.0), Vector (), channel);
+  CreateOne (Vector (10.0, 0.0, 0.0), Vector (), channel);
+  CreateOne (Vector (0.0, 40.0, 0.0), Vector (), channel);
+  CreateOne (Vector (-500.0, 0.0, 0.0), Vector (), channel);
+  CreateOne (Vector (1000.0, 0.0, 0.0), Vector (-100.0, 0.0, 0.0), channel);
+
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelCullingTest::SendOnePacket, this, sender);
+  Simulator::Schedule (Seconds (9.7), &YansWifiChannelCullingTest::SendOnePacket, this, sender);
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+YansWifiChannelCullingTest::DoRun (void)
+{
+  RunOne (0, false);
+  NS_TEST_EXPECT_MSG_EQ (m_rx[1], 2, "10 m receiver without cutoff");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[2], 2, "40 m receiver without cutoff");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[3], 0, "500 m receiver is out of reach");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[4], 1, "moving receiver only at the second frame");
+  // The receivers of a broadcast share one packet instead of a copy each.
+  NS_TEST_EXPECT_MSG_EQ (m_rxPackets.size (), 2, "one packet per broadcast");
+
+  RunOne (100, true);
+  NS_TEST_EXPECT_MSG_EQ (m_rx[1], 2, "10 m receiver within MaxRange");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[2], 2, "40 m receiver within MaxRange");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[3], 0, "500 m receiver culled");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[4], 1, "moving receiver found after the grid is refreshed");
+
+  RunOne (35, false);
+  NS_TEST_EXPECT_MSG_EQ (m_rx[1], 2, "10 m receiver within MaxRange");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[2], 0, "40 m receiver beyond MaxRange");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Deterministic log distance loss model counting its evaluations
+ */
+class CountingLossModel : public PropagationLossModel
+{
+public:
+  CountingLossModel ()
+    : m_count (0)
+  {
+  }
+
+  uint32_t m_count; ///< number of DoCalcRxPower calls
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+  {
+    const_cast<CountingLossModel *> (this)->m_count++;
+    return txPowerDbm - 40 - 20 * std::log10 (std::max (a->GetDistanceFrom (b), 1.0));
+  }
+  virtual int64_t DoAssignStreams (int64_t stream)
+  {
+    return 0;
+  }
+  virtual bool DoIsDeterministic (void) const
+  {
+    return true;
+  }
+};
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief YansWifiChannel CachePropagation
+ *
+ * A sender at the origin broadcasts three times.  Two receivers are
+ * static, and one of them is moved out of reach after the second frame;
+ * a third receiver moves slowly.  The loss model is only evaluated again
+ * for the moved and the moving receivers.  A loss model set through the
+ * PropagationLossModel attribute is evaluated for every receiver.
+ */
+class YansWifiChannelCacheTest : public YansWifiChannelTestBase
+{
+public:
+  YansWifiChannelCacheTest ();
+
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Run one configuration
+   * \param cache the CachePropagation attribute
+   * \param replacement loss model set through the attribute before the
+   *        third frame, or null
+   * \returns the number of loss model evaluations
+   */
+  uint32_t RunOne (bool cache, Ptr<CountingLossModel> replacement);
+  /**
+   * Set the PropagationLossModel attribute
+   * \param channel the wifi channel
+   * \param loss the new loss model
+   */
+  void ReplaceLoss (Ptr<YansWifiChannel> channel, Ptr<CountingLossModel> loss);
+};
+
+YansWifiChannelCacheTest::YansWifiChannelCacheTest ()
+  : YansWifiChannelTestBase ("YansWifiChannel propagation cache")
+{
+}
+
+void
+YansWifiChannelCacheTest::ReplaceLoss (Ptr<YansWifiChannel> channel, Ptr<CountingLossModel> loss)
+{
+  channel->SetAttribute ("PropagationLossModel", PointerValue (loss));
+}
+
+uint32_t
+YansWifiChannelCacheTest::RunOne (bool cache, Ptr<CountingLossModel> replacement)
+{
+  m_rx.clear ();
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  Ptr<CountingLossModel> loss = CreateObject<CountingLossModel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (loss);
+  channel->SetAttribute ("CachePropagation", BooleanValue (cache));
+
+  Ptr<WifiNetDevice> sender = CreateOne (Vector (0.0, 0.0, 0.0), Vector (), channel);
+  CreateOne (Vector (10.0, 0.0, 0.0), Vector (), channel);
+  Ptr<WifiNetDevice> moved = CreateOne (Vector (0.0, 40.0, 0.0), Vector (), channel);
+  CreateOne (Vector (20.0, 0.0, 0.0), Vector (1.0, 0.0, 0.0), channel);
+
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelCacheTest::SendOnePacket, this, sender);
+  Simulator::Schedule (Seconds (2.0), &YansWifiChannelCacheTest::SendOnePacket, this, sender);
+  Simulator::Schedule (Seconds (3.0), &MobilityModel::SetPosition,
+                       moved->GetNode ()->GetObject<MobilityModel> (), Vector (0.0, 10000.0, 0.0));
+  if (replacement)
+    {
+      Simulator::Schedule (Seconds (3.5), &YansWifiChannelCacheTest::ReplaceLoss, this, channel, replacement);
+    }
+  Simulator::Schedule (Seconds (4.0), &YansWifiChannelCacheTest::SendOnePacket, this, sender);
+  Simulator::Stop (Seconds (5.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return loss->m_count;
+}
+
+void
+YansWifiChannelCacheTest::DoRun (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (RunOne (false, 0), 9, "every pair evaluated without cache");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[1], 3, "static receiver");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[2], 2, "moved receiver out of reach at the third frame");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[3], 3, "moving receiver");
+
+  NS_TEST_EXPECT_MSG_EQ (RunOne (true, 0), 6, "static pairs evaluated once until CourseChange");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[1], 3, "static receiver");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[2], 2, "moved receiver out of reach at the third frame");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[3], 3, "moving receiver");
+
+  Ptr<CountingLossModel> replacement = CreateObject<CountingLossModel> ();
+  NS_TEST_EXPECT_MSG_EQ (RunOne (true, replacement), 4, "first loss model used for the first two frames");
+  NS_TEST_EXPECT_MSG_EQ (replacement->m_count, 3, "cache cleared when the attribute is set");
+  NS_TEST_EXPECT_MSG_EQ (m_rx[1], 3, "static receiver");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2201,6 +2503,8 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug2831TestCase, TestCase::QUICK); //Bug 2831
   AddTestCase (new StaWifiMacScanningTestCase, TestCase::QUICK); //Bug 2399
   AddTestCase (new Bug2470TestCase, TestCase::QUICK); //Bug 2470
+  AddTestCase (new YansWifiChannelCullingTest, TestCase::QUICK);
+  AddTestCase (new YansWifiChannelCacheTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -328,6 +328,41 @@ benchByteTags (uint32_t n)
     }
 }
 
+static void
+benchAodv (uint32_t n)
+{
+  BenchHeader<1> type;
+  BenchHeader<19> rrep;
+  BenchHeader<8> udp;
+  BenchHeader<20> ipv4;
+  BenchHeader<8> llc;
+
+  // A route reply relayed over four hops: every hop strips the
+  // stack down to the AODV message and builds it again.
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> ();
+    p->AddHeader (rrep);
+    p->AddHeader (type);
+    p->AddHeader (udp);
+    p->AddHeader (ipv4);
+    p->AddHeader (llc);
+    for (uint32_t hop = 0; hop < 4; hop++) {
+      Ptr<Packet> q = p->Copy ();
+      q->RemoveHeader (llc);
+      q->RemoveHeader (ipv4);
+      q->RemoveHeader (udp);
+      q->RemoveHeader (type);
+      q->RemoveHeader (rrep);
+      q->AddHeader (rrep);
+      q->AddHeader (type);
+      q->AddHeader (udp);
+      q->AddHeader (ipv4);
+      q->AddHeader (llc);
+      p = q;
+    }
+  }
+}
+
 static uint64_t
 runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 {
@@ -340,7 +375,8 @@ runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 
 
 static void
-runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name)
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name,
+          uint32_t headersPerPacket = 0)
 {
   uint64_t minDelay = std::numeric_limits<uint64_t>::max();
   for (uint32_t i = 0; i < minIterations; i++)
@@ -351,8 +387,12 @@ runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char con
   double ps = n;
   ps *= 1000;
   ps /= minDelay;
-  std::cout << ps << " packets/s"
-            << " (" << minDelay << " ms elapsed)\t"
+  std::cout << ps << " packets/s";
+  if (headersPerPacket > 0)
+    {
+      std::cout << ", " << ps * headersPerPacket << " headers/s";
+    }
+  std::cout << " (" << minDelay << " ms elapsed)\t"
             << name
             << std::endl;
 }
@@ -376,7 +416,12 @@ int main (int argc, char *argv[])
         "by command-line argument --n=(number of packets)" << std::endl;
       exit (1);
     }
-  std::cout << "Running bench-packets with n=" << n << std::endl;
+  if (enablePrinting)
+    {
+      Packet::EnablePrinting ();
+    }
+  std::cout << "Running bench-packets with n=" << n
+            << (enablePrinting ? ", metadata enabled" : ", metadata disabled") << std::endl;
   std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
   runBench (&benchA, n, minIterations, "Copy packet, remove headers");
@@ -385,6 +430,8 @@ int main (int argc, char *argv[])
   runBench (&benchD, n, minIterations, "Intermixed add/remove headers and tags");
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
+  // 5 headers added, then 10 header operations on each of 4 hops
+  runBench (&benchAodv, n, minIterations, "AODV header stack over 4 hops", 45);
 
   return 0;
 }
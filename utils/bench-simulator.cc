@@ -22,6 +22,7 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 #include <string.h>
 
 #include "ns3/core-module.h"
@@ -51,7 +52,9 @@ public:
   Bench (const uint32_t population, const uint32_t total)
     : m_population (population),
       m_total (total),
-      m_count (0)
+      m_burst (1),
+      m_count (0),
+      m_pending (0)
   {
   }
 
@@ -82,6 +85,16 @@ public:
     m_total = total;
   }
 
+  /**
+   * Set burst size: events are scheduled in groups sharing one timestamp,
+   * like the receptions of a broadcast on a wireless channel
+   * \param burst the number of events per group
+   */
+  void SetBurst (const uint32_t burst)
+  {
+    m_burst = std::max (burst, 1u);
+  }
+
   /// Run function
   void RunBench (void);
 private:
@@ -91,7 +104,9 @@ private:
   Ptr<RandomVariableStream> m_rand; ///< random variable
   uint32_t m_population; ///< population
   uint32_t m_total; ///< total
+  uint32_t m_burst; ///< events per timestamp
   uint32_t m_count; ///< count 
+  uint32_t m_pending; ///< events run since the last group was scheduled
 };
 
 void
@@ -102,13 +117,17 @@ Bench::RunBench (void)
 
   DEB ("initializing");
   m_count = 0;
+  m_pending = 0;
 
 
   time.Start ();
-  for (uint32_t i = 0; i < m_population; ++i)
+  for (uint32_t i = 0; i < m_population; i += m_burst)
     {
       Time at = NanoSeconds (m_rand->GetValue ());
-      Simulator::Schedule (at, &Bench::Cb, this);
+      for (uint32_t j = 0; j < m_burst; ++j)
+        {
+          Simulator::Schedule (at, &Bench::Cb, this);
+        }
     }
   init = time.End ();
   init /= 1000;
@@ -139,8 +158,17 @@ Bench::Cb (void)
     }
   DEB ("event at " << Simulator::Now ().GetSeconds () << "s");
 
-  Time after = NanoSeconds (m_rand->GetValue ());
-  Simulator::Schedule (after, &Bench::Cb, this);
+  // Keep the population constant: once a whole group has run, schedule
+  // the next one.
+  if (++m_pending == m_burst)
+    {
+      m_pending = 0;
+      Time after = NanoSeconds (m_rand->GetValue ());
+      for (uint32_t j = 0; j < m_burst; ++j)
+        {
+          Simulator::Schedule (after, &Bench::Cb, this);
+        }
+    }
   ++m_count;
 }
 
@@ -207,10 +235,12 @@ int main (int argc, char *argv[])
   bool schedHeap = false;
   bool schedList = false;
   bool schedMap  = true;
+  bool schedLadder = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
   uint32_t runs  =       1;
+  uint32_t burst =       1;
   std::string filename = "";
 
   CommandLine cmd;
@@ -226,10 +256,12 @@ int main (int argc, char *argv[])
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
   cmd.AddValue ("runs",  "number of runs (default 1)",    runs);
+  cmd.AddValue ("burst", "events sharing each timestamp (default 1)", burst);
   cmd.AddValue ("file",  "file of relative event times",  filename);
   cmd.AddValue ("prec",  "printed output precision",      g_fwidth);
   cmd.Parse (argc, argv);
@@ -249,6 +281,10 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::ListScheduler");
     }
+  if (schedLadder)
+    {
+      factory.SetTypeId ("ns3::LadderScheduler");
+    }
   Simulator::SetScheduler (factory);
 
   LOGME (std::setprecision (g_fwidth - 6));
@@ -258,8 +294,10 @@ int main (int argc, char *argv[])
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
+  LOGME ("burst: " << burst);
 
   Bench *bench = new Bench (pop, total);
+  bench->SetBurst (burst);
   bench->SetRandomStream (GetRandomStream (filename));
 
   // table header
@@ -299,6 +337,11 @@ int main (int argc, char *argv[])
       bench->RunBench ();
     }
 
+  LOG ("");
+  EventImpl::PoolStats stats = EventImpl::GetPoolStats ();
+  LOGME ("event allocations: " << stats.allocations);
+  LOGME ("event pool slabs: " << stats.slabs);
+  LOGME ("oversized events: " << stats.oversized);
   LOG ("");
   Simulator::Destroy ();
   delete bench;